@@ -0,0 +1,90 @@
+// This file is part of volplay, a library for interacting with volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+
+#include <volplay/volplay.h>
+#include <volplay/util/parallel.h>
+#include <chrono>
+#include <iostream>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+/** Milliseconds elapsed since start. */
+static double elapsed(const std::chrono::high_resolution_clock::time_point &start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/** Largest absolute deviation between two grids. */
+static float maxDeviation(const std::vector<float> &a, const std::vector<float> &b)
+{
+    float e = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+        e = std::max(e, std::abs(a[i] - b[i]));
+    return e;
+}
+
+TEST_CASE("distance_transform")
+{
+    // A mesh makes for an expensive scene to evaluate.
+    vp::SDFNodePtr shape = vp::make()
+        .join()
+            .sphere().radius(1)
+            .transform().translate(vp::Vector(vp::S(0.8), 0, 0))
+                .box().halfLengths(vp::Vector::Constant(vp::S(0.5)))
+            .end()
+        .end();
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector::Constant(-2));
+    dc.setUpperBounds(vp::Vector::Constant(2));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.05)));
+    vp::SDFNodePtr scene = std::make_shared<vp::SDFMesh>(dc.compute(shape, vps::DualContouring::COMPUTE_NONLINEAR_DC));
+
+    const vp::Index dims = vp::Index::Constant(96);
+    const vp::Vector spacing = vp::Vector::Constant(vp::S(4) / vp::S(95));
+    const vp::Vector origin = vp::Vector::Constant(-2);
+
+    // Brute force
+    auto start = std::chrono::high_resolution_clock::now();
+    vp::DistanceGrid reference(dims, origin, spacing);
+    vp::util::parallelFor(0, dims.z(), [&](int z) {
+        for (int y = 0; y < dims.y(); ++y)
+            for (int x = 0; x < dims.x(); ++x)
+                reference.values[reference.index(x, y, z)] = float(scene->eval(reference.position(x, y, z)));
+    });
+    const double msBrute = elapsed(start);
+
+    vp::DistanceTransform dt;
+
+    start = std::chrono::high_resolution_clock::now();
+    vp::DistanceGrid band(dims, origin, spacing);
+    const int evaluations = dt.sampleNarrowBand(scene, band);
+    const double msBand = elapsed(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    vp::DistanceGrid jfa = band;
+    dt.jumpFlood(jfa);
+    const double msJFA = elapsed(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    vp::DistanceGrid fsm = band;
+    const int rounds = dt.fastSweep(fsm);
+    const double msFSM = elapsed(start);
+
+    std::cout << "Distance grid of " << reference.size() << " samples" << std::endl
+              << "  brute force " << msBrute << "ms" << std::endl
+              << "  narrow band " << msBand << "ms (" << evaluations << " evaluations)" << std::endl
+              << "  + jump flooding " << msJFA << "ms, max error " << maxDeviation(jfa.values, reference.values) << std::endl
+              << "  + fast sweeping " << msFSM << "ms in " << rounds << " rounds, max error " << maxDeviation(fsm.values, reference.values) << std::endl;
+
+    REQUIRE(maxDeviation(jfa.values, reference.values) < spacing.maxCoeff());
+    REQUIRE(maxDeviation(fsm.values, reference.values) < spacing.maxCoeff() * 2);
+}
@@ -0,0 +1,70 @@
+// This file is part of volplay, a library for interacting with volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+
+#include <volplay/volplay.h>
+#include <chrono>
+#include <iostream>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+/** Run extractor and report elapsed time and mesh size. */
+template<class Extractor>
+vps::IndexedSurface timeExtraction(const char *name, Extractor &e, const vp::SDFNodePtr &scene)
+{
+    e.setLowerBounds(vp::Vector(-2,-2,-2));
+    e.setUpperBounds(vp::Vector(2,2,2));
+    e.setResolution(vp::Vector::Constant(vp::S(0.02)));
+
+    auto start = std::chrono::high_resolution_clock::now();
+    vps::IndexedSurface surface = e.compute(scene);
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << ": " << std::chrono::duration<double, std::milli>(stop - start).count() << "ms, "
+              << surface.vertices.cols() << " vertices, " << surface.faces.cols() << " faces" << std::endl;
+    return surface;
+}
+
+TEST_CASE("preview_mesh")
+{
+    vp::SDFNodePtr scene = vp::make()
+        .difference()
+            .join()
+                .sphere().radius(1)
+                .transform().translate(vp::Vector(0.8f, 0.8f, 0.8f))
+                    .sphere().radius(1)
+                .end()
+            .end()
+            .plane().normal(vp::Vector::UnitZ())
+        .end();
+
+    vps::DualContouring dc;
+    vps::MarchingCubes mc;
+    vps::SurfaceNets sn;
+
+    vps::IndexedSurface full = timeExtraction("Dual Contouring", dc, scene);
+    vps::IndexedSurface surface = timeExtraction("Marching Cubes", mc, scene);
+    timeExtraction("Surface Nets", sn, scene);
+
+    vps::OFFExport off;
+    off.exportSurface("surface_preview.off", surface);
+
+    // Reduce the dual contouring mesh for shipping
+    vps::QuadricDecimation qd;
+    qd.setTargetFaceCount(full.faces.cols() / 10);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    vps::IndexedSurface decimated = qd.compute(full);
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    std::cout << "Quadric decimation: " << std::chrono::duration<double, std::milli>(stop - start).count() << "ms, "
+              << decimated.vertices.cols() << " vertices, " << decimated.faces.cols() << " faces" << std::endl;
+    off.exportSurface("surface_decimated.off", decimated);
+}
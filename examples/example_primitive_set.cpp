@@ -0,0 +1,54 @@
+// This file is part of volplay, a library for interacting with volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include <volplay/volplay.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace vp = volplay;
+
+/** Evaluate the scene at all positions. Returns milliseconds elapsed. */
+static double evalAll(const vp::SDFNode &scene, const std::vector<vp::Vector> &x, double &sum)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    sum = 0;
+    for (size_t i = 0; i < x.size(); ++i)
+        sum += scene.eval(x[i]);
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+TEST_CASE("primitive_set")
+{
+    // Particles scattered in a box.
+    const int n = 5000;
+    std::vector<vp::Vector> centers;
+    std::vector<vp::Scalar> radii;
+    vp::SDFUnionPtr particles = std::make_shared<vp::SDFUnion>();
+    for (int i = 0; i < n; ++i) {
+        centers.push_back(vp::Vector::Random() * vp::S(10));
+        radii.push_back(vp::S(0.1));
+        particles->add(vp::make().transform().translate(centers.back()).sphere().radius(radii.back()).end());
+    }
+    vp::SDFSphereSet set(centers, radii);
+
+    std::vector<vp::Vector> x;
+    for (int i = 0; i < 2000; ++i)
+        x.push_back(vp::Vector::Random() * vp::S(12));
+
+    double sumUnion, sumSet;
+    const double msUnion = evalAll(*particles, x, sumUnion);
+    const double msSet = evalAll(set, x, sumSet);
+
+    std::cout << x.size() << " evaluations of " << n << " spheres" << std::endl
+              << "  union of transformed spheres " << msUnion << "ms" << std::endl
+              << "  sphere set " << msSet << "ms" << std::endl;
+
+    REQUIRE(std::abs(sumUnion - sumSet) < 1e-3 * x.size());
+}
@@ -68,7 +68,6 @@ TEST_CASE("CPU based raytracing")
     
     vp::SDFNode::TraceOptions to;
     to.maxIter = 1000;
-    to.stepFact = vp::Scalar(0.9);
     r->setPrimaryTraceOptions(to);
     
     vpr::HeatImageGeneratorPtr heat(new vpr::HeatImageGenerator());
@@ -0,0 +1,91 @@
+// This file is part of volplay, a library for interacting with volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+
+#include <volplay/volplay.h>
+#include <chrono>
+#include <iostream>
+
+namespace vp = volplay;
+
+/** Evaluate scene on a regular grid and return elapsed time in milliseconds. */
+double timeEvaluation(const vp::SDFNodePtr &scene, vp::S &checksum)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    checksum = 0;
+    for (vp::S z = -2; z < 2; z += vp::S(0.04)) {
+        for (vp::S y = -2; y < 2; y += vp::S(0.04)) {
+            for (vp::S x = -2; x < 2; x += vp::S(0.04)) {
+                checksum += scene->eval(vp::Vector(x, y, z));
+            }
+        }
+    }
+
+    auto stop = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+vp::SDFNodePtr buildScene()
+{
+    // A scene as it typically results from composing parts with make(): nested joins,
+    // chains of transforms and a constant offset as used by DualContouring for iso levels.
+    vp::SDFNodePtr box = vp::make()
+        .transform().rotate(Eigen::AngleAxisf(vp::S(0.3), vp::Vector::UnitZ()))
+            .join()
+                .transform()
+                    .box().halfLengths(vp::Vector(0.3f, 0.3f, 0.3f))
+                .end()
+            .end()
+        .end();
+
+    vp::SDFNodePtr sphere = vp::make()
+        .transform().translate(vp::Vector(0, 0.5f, 0))
+            .sphere().radius(vp::S(0.4))
+        .end();
+
+    return vp::make()
+        .displacement().offset(vp::S(-0.05))
+            .join()
+                .join()
+                    .transform().translate(vp::Vector(0.5f, 0, 0))
+                        .wrap().node(box)
+                    .end()
+                    .join()
+                        .transform().translate(vp::Vector(-0.5f, 0, 0))
+                            .wrap().node(sphere)
+                        .end()
+                    .end()
+                .end()
+                .difference()
+                    .difference()
+                        .box().halfLengths(vp::Vector(1, 1, 0.1f))
+                        .join()
+                            .sphere().radius(vp::S(0.5))
+                        .end()
+                    .end()
+                    .transform()
+                        .plane().normal(vp::Vector::UnitX())
+                    .end()
+                .end()
+            .end()
+        .end();
+}
+
+TEST_CASE("scene_optimizer")
+{
+    vp::S before, after;
+    double msBefore = timeEvaluation(buildScene(), before);
+    double msAfter = timeEvaluation(vp::SDFOptimizer().optimize(buildScene()), after);
+
+    std::cout << "Scene evaluation before optimization " << msBefore << "ms, after " << msAfter << "ms"
+              << " (speedup " << msBefore / msAfter << "x)" << std::endl;
+
+    REQUIRE(std::abs(before - after) < std::abs(before) * vp::S(0.001));
+}
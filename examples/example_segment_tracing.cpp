@@ -0,0 +1,93 @@
+// This file is part of volplay, a library for interacting with volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include <volplay/volplay.h>
+#include <chrono>
+#include <iostream>
+
+namespace vp = volplay;
+namespace vpr = volplay::rendering;
+
+/** Mean intensity of a heat image. */
+static double meanHeat(const vpr::ByteImage &img)
+{
+    double sum = 0;
+    for (int r = 0; r < img.rows(); ++r)
+        for (int c = 0; c < img.cols(); ++c)
+            sum += img.row(r)[c];
+    return sum / (img.rows() * img.cols());
+}
+
+/** Render heat and depth images of the scene. Returns milliseconds elapsed. */
+static double render(const vp::SDFNodePtr &scene, vp::SDFNode::TraceMethod method, bool exact, vpr::ByteImagePtr &heat, vpr::ScalarImagePtr &depth)
+{
+    vpr::CameraPtr cam(new vpr::Camera());
+    cam->setCameraToImage(360, 640, vp::Scalar(0.40));
+    cam->setCameraToWorldAsLookAt(vp::Vector(-5, 1, 10), vp::Vector(0, 0, 0), vp::Vector(0, 1, 0));
+
+    vp::SDFNode::TraceOptions to;
+    to.method = method;
+    to.exactIntersections = exact;
+    to.maxT = 100;
+    to.maxIter = 500;
+
+    vpr::RendererPtr r(new vpr::Renderer());
+    r->setScene(scene);
+    r->setCamera(cam);
+    r->setImageResolution(360, 640);
+    r->setPrimaryTraceOptions(to);
+
+    vpr::HeatImageGeneratorPtr h(new vpr::HeatImageGenerator());
+    vpr::DepthImageGeneratorPtr d(new vpr::DepthImageGenerator());
+    r->addImageGenerator(h);
+    r->addImageGenerator(d);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    r->render();
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    heat = h->image();
+    depth = d->image();
+    return ms;
+}
+
+TEST_CASE("segment_tracing")
+{
+    // Low camera above a ground plane, so that many rays graze it.
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .plane().normal(vp::Vector::UnitY())
+            .transform().translate(vp::Vector(0, 1, 0))
+                .sphere().radius(1)
+            .end()
+            .transform().translate(vp::Vector(3, 1, 0))
+                .box().halfLengths(vp::Vector(vp::S(0.5), 1, vp::S(0.5)))
+            .end()
+        .end();
+
+    vpr::ByteImagePtr sphereHeat, segmentHeat, exactHeat;
+    vpr::ScalarImagePtr sphereDepth, segmentDepth, exactDepth;
+    const double msSphere = render(scene, vp::SDFNode::SPHERE_TRACING, false, sphereHeat, sphereDepth);
+    const double msSegment = render(scene, vp::SDFNode::SEGMENT_TRACING, false, segmentHeat, segmentDepth);
+    const double msExact = render(scene, vp::SDFNode::SPHERE_TRACING, true, exactHeat, exactDepth);
+
+    // Depth agrees up to the hit threshold travelled by grazing rays.
+    int differing = 0;
+    for (int r = 0; r < sphereDepth->rows(); ++r)
+        for (int c = 0; c < sphereDepth->cols(); ++c)
+            differing += std::abs(sphereDepth->row(r)[c] - segmentDepth->row(r)[c]) > vp::S(0.01);
+
+    std::cout << "Heat image of " << sphereHeat->rows() * sphereHeat->cols() << " pixels" << std::endl
+              << "  sphere tracing " << msSphere << "ms, mean heat " << meanHeat(*sphereHeat) << std::endl
+              << "  segment tracing " << msSegment << "ms, mean heat " << meanHeat(*segmentHeat) << std::endl
+              << "  exact intersections " << msExact << "ms, mean heat " << meanHeat(*exactHeat) << std::endl
+              << "  " << differing << " pixels differ in depth" << std::endl;
+
+    REQUIRE(meanHeat(*segmentHeat) < meanHeat(*sphereHeat));
+}
@@ -0,0 +1,104 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_DISTANCE_TRANSFORM
+#define VOLPLAY_DISTANCE_TRANSFORM
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+#include <vector>
+
+namespace volplay {
+
+    /**
+        Regular grid of signed distances.
+
+        Values are stored x varying fastest as expected by SDFVolume::write. Values of
+        unknown samples carry the sign of the sample only.
+    */
+    struct DistanceGrid {
+        Index dims;
+        Vector origin;
+        Vector spacing;
+        std::vector<float> values;
+        std::vector<char> known;
+
+        /** Empty grid. */
+        DistanceGrid();
+
+        /** Grid of unknown samples. */
+        DistanceGrid(const Index &dims, const Vector &origin, const Vector &spacing);
+
+        /** Number of samples. */
+        int size() const;
+
+        /** Linear index of sample. */
+        int index(int x, int y, int z) const;
+
+        /** World position of sample. */
+        Vector position(int x, int y, int z) const;
+    };
+
+    /**
+        Builds dense signed distance grids from a narrow band of exact samples.
+
+        Samples close to the surface are either evaluated from a scene or derived from an
+        occupancy grid. Distances of the remaining samples are then propagated from the band
+        using one of two grid algorithms, both run in parallel.
+
+        Jump flooding propagates the nearest band sample in passes of halving step size as
+        described by Rong and Tan in "Jump flooding in GPU with applications to Voronoi
+        diagram and distance transform", 2006. An extra pass of step one reduces its errors.
+
+        Fast sweeping solves the Eikonal equation by Gauss-Seidel sweeps in alternating
+        orderings as described by Zhao in "A fast sweeping method for Eikonal equations", 2005.
+        Orderings are distributed over threads working on separate copies that are combined
+        by their minimum after each round, following Zhao's parallel variant from 2007.
+    */
+    class DistanceTransform {
+    public:
+        /** Empty initializer. */
+        DistanceTransform();
+
+        /** Set half width of the band in world units. Defaults to twice the largest spacing. */
+        void setBandWidth(Scalar w);
+
+        /** Set the maximum number of rounds of fast sweeping. */
+        void setMaxSweepRounds(int n);
+
+        /**
+            Sample the scene at grid positions within the band. Blocks of samples are split
+            recursively and skipped when their center shows that they cannot contain band
+            samples. This requires the scene to not overestimate distances. Returns the
+            number of evaluations.
+        */
+        int sampleNarrowBand(SDFNodePtr scene, DistanceGrid &g) const;
+
+        /**
+            Initialize from occupancy given per sample. Samples next to a sample of different
+            occupancy are assumed at half the spacing to the surface.
+        */
+        void sampleOccupancy(const std::vector<char> &inside, DistanceGrid &g) const;
+
+        /** Fill unknown samples using jump flooding. */
+        void jumpFlood(DistanceGrid &g) const;
+
+        /** Fill unknown samples using fast sweeping. Returns the number of rounds performed. */
+        int fastSweep(DistanceGrid &g) const;
+
+    private:
+        Scalar bandWidth(const DistanceGrid &g) const;
+
+        Scalar _band;
+        int _maxRounds;
+    };
+
+}
+
+#endif
@@ -18,6 +18,7 @@ namespace volplay {
     class SDFNode;
     class SDFNodeAttachment;
 	class SDFNodeVisitor;
+    class SDFOptimizer;
     class SDFGroup;
     class SDFUnion;
     class SDFIntersection;
@@ -28,6 +29,15 @@ namespace volplay {
     class SDFSphere;
     class SDFPlane;
     class SDFBox;
+    class SDFVolume;
+    class SDFMesh;
+    class SDFPrimitiveSet;
+    class SDFSphereSet;
+    class SDFBoxSet;
+    class SDFCapsuleSet;
+    class TSDFVolume;
+    struct DistanceGrid;
+    class DistanceTransform;
     
     typedef std::shared_ptr<SDFNode> SDFNodePtr;
     typedef std::shared_ptr<SDFNodeAttachment> SDFNodeAttachmentPtr;
@@ -42,6 +52,13 @@ namespace volplay {
     typedef std::shared_ptr<SDFSphere> SDFSpherePtr;
     typedef std::shared_ptr<SDFPlane> SDFPlanePtr;
     typedef std::shared_ptr<SDFBox> SDFBoxPtr;
+    typedef std::shared_ptr<SDFVolume> SDFVolumePtr;
+    typedef std::shared_ptr<SDFMesh> SDFMeshPtr;
+    typedef std::shared_ptr<SDFPrimitiveSet> SDFPrimitiveSetPtr;
+    typedef std::shared_ptr<SDFSphereSet> SDFSphereSetPtr;
+    typedef std::shared_ptr<SDFBoxSet> SDFBoxSetPtr;
+    typedef std::shared_ptr<SDFCapsuleSet> SDFCapsuleSetPtr;
+    typedef std::shared_ptr<TSDFVolume> TSDFVolumePtr;
     
     typedef std::shared_ptr<SDFNode const> SDFNodeConstPtr;
     typedef std::shared_ptr<SDFGroup const> SDFGroupConstPtr;
@@ -80,7 +97,18 @@ namespace volplay {
     namespace surface {
         struct IndexedSurface;
         class DualContouring;
+        class MarchingCubes;
+        class SurfaceNets;
+        class QuadricDecimation;
         class OFFExport;
+        class OFFImport;
+        class BlockGrid;
+        struct MeshChunk;
+        struct ChunkManifest;
+        class ChunkManager;
+        class IncrementalMesher;
+        class HermiteCache;
+        class LocalityOptimizer;
     }
     
 }
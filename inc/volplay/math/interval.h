@@ -0,0 +1,72 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_MATH_INTERVAL
+#define VOLPLAY_MATH_INTERVAL
+
+#include <volplay/types.h>
+#include <algorithm>
+#include <limits>
+
+namespace volplay {
+    namespace math {
+
+        /**
+            Closed interval [lower, upper] of scalars.
+
+            Used to bound the range of a function over a region. Bounds may be infinite.
+        */
+        struct Interval {
+            Scalar lower;
+            Scalar upper;
+
+            /** Create the interval containing all scalars. */
+            Interval()
+                : lower(-std::numeric_limits<Scalar>::infinity()), upper(std::numeric_limits<Scalar>::infinity())
+            {}
+
+            /** Create interval from bounds. */
+            Interval(Scalar lower_, Scalar upper_)
+                : lower(lower_), upper(upper_)
+            {}
+
+            /** Test if value is contained. */
+            bool contains(Scalar v) const
+            {
+                return lower <= v && v <= upper;
+            }
+        };
+
+        /** Shift interval by constant. */
+        inline Interval operator+(const Interval &a, Scalar s)
+        {
+            return Interval(a.lower + s, a.upper + s);
+        }
+
+        /** Negate interval. */
+        inline Interval operator-(const Interval &a)
+        {
+            return Interval(-a.upper, -a.lower);
+        }
+
+        /** Range of the pointwise minimum of two functions bounded by a and b. */
+        inline Interval min(const Interval &a, const Interval &b)
+        {
+            return Interval(std::min(a.lower, b.lower), std::min(a.upper, b.upper));
+        }
+
+        /** Range of the pointwise maximum of two functions bounded by a and b. */
+        inline Interval max(const Interval &a, const Interval &b)
+        {
+            return Interval(std::max(a.lower, b.lower), std::max(a.upper, b.upper));
+        }
+    }
+}
+
+#endif
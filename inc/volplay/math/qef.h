@@ -0,0 +1,258 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_MATH_QEF
+#define VOLPLAY_MATH_QEF
+
+#include <volplay/types.h>
+#include <Eigen/Eigenvalues>
+#include <vector>
+
+namespace volplay {
+    namespace math {
+
+        namespace detail {
+
+            /**
+                Solve the normal equations ATA.(x - m) = ATb - ATA.m for x.
+
+                Uses a closed-form eigen decomposition of the symmetric 3x3 matrix ATA. Eigenvalues
+                corresponding to singular values of A below threshold are truncated, which
+                pulls the solution towards the mass point m in degenerate directions.
+            */
+            inline Vector solveQEF(const Eigen::Matrix<Scalar, 3, 3> &ata, const Vector &atb, const Vector &m, Scalar threshold)
+            {
+                Eigen::SelfAdjointEigenSolver< Eigen::Matrix<Scalar, 3, 3> > es;
+                es.computeDirect(ata);
+
+                const Vector &ev = es.eigenvalues();
+                const Eigen::Matrix<Scalar, 3, 3> &v = es.eigenvectors();
+                const Scalar t2 = threshold * threshold;
+
+                Vector inv;
+                for (int i = 0; i < 3; ++i)
+                    inv(i) = ev(i) > t2 ? Scalar(1) / ev(i) : Scalar(0);
+
+                const Vector rhs = atb - ata * m;
+                return m + v * inv.asDiagonal() * (v.transpose() * rhs);
+            }
+        }
+
+        /**
+            Quadratic error function of a set of planes.
+
+            The QEF measures the sum of squared distances of a point x to a set of
+            planes given by point p_i and normal n_i
+
+                E(x) = sum_i (n_i.(x - p_i))^2 = x'ATAx - 2x'ATb + btb
+
+            Only the fixed size terms ATA, ATb and btb are stored, which allows
+            accumulating planes without allocating memory and merging QEFs of
+            neighboring cells. Additionally the mass point of all plane points is
+            tracked to regularize the solution in degenerate configurations.
+        */
+        class QEF {
+        public:
+            /** Type of the ATA matrix. */
+            typedef Eigen::Matrix<Scalar, 3, 3> Matrix33;
+
+            /** Create an empty QEF. */
+            QEF()
+            {
+                clear();
+            }
+
+            /** Create from accumulated terms. */
+            QEF(const Matrix33 &ata, const Vector &atb, Scalar btb, const Vector &pointSum, int count)
+                : _ata(ata), _atb(atb), _btb(btb), _pointSum(pointSum), _count(count)
+            {}
+
+            /** Reset to empty state. */
+            void clear()
+            {
+                _ata.setZero();
+                _atb.setZero();
+                _btb = 0;
+                _pointSum.setZero();
+                _count = 0;
+            }
+
+            /** Add plane given by point on plane and plane normal. */
+            void add(const Vector &p, const Vector &n)
+            {
+                const Scalar b = n.dot(p);
+                _ata += n * n.transpose();
+                _atb += n * b;
+                _btb += b * b;
+                _pointSum += p;
+                ++_count;
+            }
+
+            /** Merge with another QEF. The result represents the union of both plane sets. */
+            void merge(const QEF &other)
+            {
+                _ata += other._ata;
+                _atb += other._atb;
+                _btb += other._btb;
+                _pointSum += other._pointSum;
+                _count += other._count;
+            }
+
+            /** Number of planes accumulated. */
+            int count() const
+            {
+                return _count;
+            }
+
+            /** Access the ATA term. */
+            const Matrix33 &ata() const
+            {
+                return _ata;
+            }
+
+            /** Access the ATb term. */
+            const Vector &atb() const
+            {
+                return _atb;
+            }
+
+            /** Access the btb term. */
+            Scalar btb() const
+            {
+                return _btb;
+            }
+
+            /** Mean of all plane points. */
+            Vector massPoint() const
+            {
+                return _count > 0 ? Vector(_pointSum / Scalar(_count)) : Vector(Vector::Zero());
+            }
+
+            /** Evaluate the error function at the given location. */
+            Scalar error(const Vector &x) const
+            {
+                return x.dot(_ata * x) - Scalar(2) * x.dot(_atb) + _btb;
+            }
+
+            /**
+                Find the location minimizing the error function.
+
+                Singular values of the system below threshold are truncated. Optionally
+                returns the error at the minimizer.
+            */
+            Vector solve(Scalar threshold = Scalar(0.1), Scalar *err = 0) const
+            {
+                Vector x = detail::solveQEF(_ata, _atb, massPoint(), threshold);
+                if (err)
+                    *err = error(x);
+                return x;
+            }
+
+        private:
+            Matrix33 _ata;
+            Vector _atb;
+            Scalar _btb;
+            Vector _pointSum;
+            int _count;
+        };
+
+        /**
+            Collection of QEFs stored in structure of arrays layout.
+
+            Used when many QEFs are accumulated and solved at once, such as once per
+            surface voxel in dual contouring. All terms are stored in contiguous arrays
+            which keeps the memory footprint at 13 scalars per QEF and avoids per QEF
+            allocations.
+        */
+        class QEFBatch {
+        public:
+            /** Create empty batch. */
+            QEFBatch()
+            {}
+
+            /** Resize batch. New QEFs are empty. */
+            void resize(size_t n)
+            {
+                for (int i = 0; i < NTERMS; ++i)
+                    _terms[i].resize(n, Scalar(0));
+                _count.resize(n, 0);
+            }
+
+            /** Number of QEFs in batch. */
+            size_t size() const
+            {
+                return _count.size();
+            }
+
+            /** Add plane given by point on plane and normal to the i-th QEF. */
+            void add(size_t i, const Vector &p, const Vector &n)
+            {
+                const Scalar b = n.dot(p);
+                _terms[A00][i] += n.x() * n.x();
+                _terms[A01][i] += n.x() * n.y();
+                _terms[A02][i] += n.x() * n.z();
+                _terms[A11][i] += n.y() * n.y();
+                _terms[A12][i] += n.y() * n.z();
+                _terms[A22][i] += n.z() * n.z();
+                _terms[B0][i] += n.x() * b;
+                _terms[B1][i] += n.y() * b;
+                _terms[B2][i] += n.z() * b;
+                _terms[BB][i] += b * b;
+                _terms[P0][i] += p.x();
+                _terms[P1][i] += p.y();
+                _terms[P2][i] += p.z();
+                ++_count[i];
+            }
+
+            /** Access the i-th QEF. */
+            QEF at(size_t i) const
+            {
+                return QEF(ata(i),
+                           Vector(_terms[B0][i], _terms[B1][i], _terms[B2][i]),
+                           _terms[BB][i],
+                           Vector(_terms[P0][i], _terms[P1][i], _terms[P2][i]),
+                           _count[i]);
+            }
+
+            /** Solve all QEFs. The i-th column of x receives the minimizer of the i-th QEF. */
+            void solve(Scalar threshold, Eigen::Matrix<Scalar, 3, Eigen::Dynamic> &x) const
+            {
+                const size_t n = size();
+                x.resize(3, n);
+
+                for (size_t i = 0; i < n; ++i) {
+                    const Vector atb(_terms[B0][i], _terms[B1][i], _terms[B2][i]);
+                    const Scalar invCount = _count[i] > 0 ? Scalar(1) / Scalar(_count[i]) : Scalar(0);
+                    const Vector m(_terms[P0][i] * invCount, _terms[P1][i] * invCount, _terms[P2][i] * invCount);
+
+                    x.col(i) = detail::solveQEF(ata(i), atb, m, threshold);
+                }
+            }
+
+        private:
+            /** Assemble the symmetric ATA matrix of the i-th QEF. */
+            QEF::Matrix33 ata(size_t i) const
+            {
+                QEF::Matrix33 a;
+                a << _terms[A00][i], _terms[A01][i], _terms[A02][i],
+                     _terms[A01][i], _terms[A11][i], _terms[A12][i],
+                     _terms[A02][i], _terms[A12][i], _terms[A22][i];
+                return a;
+            }
+
+            enum ETerm { A00, A01, A02, A11, A12, A22, B0, B1, B2, BB, P0, P1, P2, NTERMS };
+
+            std::vector<Scalar> _terms[NTERMS];
+            std::vector<int> _count;
+        };
+
+    }
+}
+
+#endif
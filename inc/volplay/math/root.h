@@ -27,15 +27,16 @@ namespace volplay {
             Find root of function in interval.
             
             Uses Brent's method in the given interval. Implementation taken from
-            Numerical Recipes in C.
+            Numerical Recipes in C. This version takes the function values at
+            the interval bounds f1 = f(x1) and f2 = f(x2) when known already.
         */
         template<class F>
-        bool findRootBrent(F &f, Scalar x1, Scalar x2, Scalar tol, int maxIter, Scalar &root) {
+        bool findRootBrent(F &f, Scalar x1, Scalar x2, Scalar f1, Scalar f2, Scalar tol, int maxIter, Scalar &root) {
             const Scalar eps = std::numeric_limits<Scalar>::epsilon();
             
             int iter;
-            Scalar a=x1,b=x2,c=x2,d,e,min1,min2;
-            Scalar fa=f(a),fb=f(b),fc,p,q,r,s,tol1,xm;
+            Scalar a=x1,b=x2,c=x2,d=0,e=0,min1,min2;
+            Scalar fa=f1,fb=f2,fc,p,q,r,s,tol1,xm;
             
             if ((fa > 0 && fb > 0) || (fa < 0 && fb < 0))
                 return false; // Root must be bracketed
@@ -105,6 +106,171 @@ namespace volplay {
             return false; // Max number of iterations exceeded.
         }
         
+        /** 
+            Find root of function in interval.
+            
+            Uses Brent's method in the given interval. Implementation taken from
+            Numerical Recipes in C.
+        */
+        template<class F>
+        bool findRootBrent(F &f, Scalar x1, Scalar x2, Scalar tol, int maxIter, Scalar &root) {
+            return findRootBrent(f, x1, x2, f(x1), f(x2), tol, maxIter, root);
+        }
+        
+        /**
+            Bracketing state of the Illinois variant of the regula falsi method.
+            
+            Separates the iteration from function evaluation, so that many root searches
+            can be advanced in lockstep. See findRootIllinois for a sequential driver.
+        */
+        struct IllinoisBracket {
+            Scalar a, b, fa, fb, c, fc;
+            int side;
+            
+            /** Initialize from interval [x1, x2] and function values f1 = f(x1) and f2 = f(x2). */
+            IllinoisBracket(Scalar x1, Scalar x2, Scalar f1, Scalar f2)
+                : a(x1), b(x2), fa(f1), fb(f2), fc(std::numeric_limits<Scalar>::infinity()), side(0)
+            {
+                c = (fa != fb) ? (fa * b - fb * a) / (fa - fb) : a;
+            }
+            
+            /** True when the interval brackets a root. */
+            bool bracketed() const
+            {
+                return !((fa > 0 && fb > 0) || (fa < 0 && fb < 0));
+            }
+            
+            /** True when the root is exactly hit, the interval is smaller than tol or |f| at the last estimate is at most ftol. */
+            bool converged(Scalar tol, Scalar ftol = 0) const
+            {
+                return fa == 0 || fb == 0 || std::abs(b - a) < tol || std::abs(fc) <= ftol;
+            }
+            
+            /** Location at which to evaluate the function next. */
+            Scalar next()
+            {
+                c = (fa * b - fb * a) / (fa - fb);
+                return c;
+            }
+            
+            /** Shrink interval given the function value at the location returned by next. */
+            void update(Scalar f)
+            {
+                fc = f;
+                if ((fc > 0 && fb > 0) || (fc < 0 && fb < 0)) {
+                    b = c; fb = fc;
+                    if (side == -1)
+                        fa *= S(0.5); // Retained the same end twice, halve its weight.
+                    side = -1;
+                } else if ((fc > 0 && fa > 0) || (fc < 0 && fa < 0)) {
+                    a = c; fa = fc;
+                    if (side == 1)
+                        fb *= S(0.5);
+                    side = 1;
+                } else {
+                    a = b = c;
+                    fa = fb = 0;
+                }
+            }
+            
+            /** Best estimate of the root. */
+            Scalar root() const
+            {
+                if (fa == 0)
+                    return a;
+                else if (fb == 0)
+                    return b;
+                else
+                    return c;
+            }
+        };
+        
+        /**
+            Find root of function in interval.
+            
+            Uses the Illinois variant of the regula falsi method. Each iteration requires
+            a single function evaluation. Iteration stops once the bracketing interval
+            is smaller than tol or the magnitude of the function value at the current estimate
+            is at most ftol. Takes the function values f1 = f(x1) and f2 = f(x2).
+        */
+        template<class F>
+        bool findRootIllinois(F &f, Scalar x1, Scalar x2, Scalar f1, Scalar f2, Scalar tol, int maxIter, Scalar &root, Scalar ftol = 0) {
+            IllinoisBracket ib(x1, x2, f1, f2);
+            
+            if (!ib.bracketed())
+                return false; // Root must be bracketed
+            
+            for (int iter = 0; iter < maxIter; ++iter) {
+                if (ib.converged(tol, ftol)) {
+                    root = ib.root();
+                    return true;
+                }
+                ib.update(f(ib.next()));
+            }
+            
+            root = ib.root();
+            return ib.converged(tol, ftol);
+        }
+        
+        /**
+            Find root of function in interval.
+            
+            Uses Newton's method safeguarded by bisection. Whenever a Newton step would leave
+            the bracketing interval or the derivative vanishes, a bisection step is taken instead.
+            fdf(x, f, df) is required to compute the function value and its derivative at x. Iteration
+            stops once the step size is smaller than tol or the magnitude of the function value is at
+            most ftol. Takes the function values f1 = f(x1) and f2 = f(x2), which are used to compute
+            a secant starting point.
+        */
+        template<class FDF>
+        bool findRootNewton(FDF &fdf, Scalar x1, Scalar x2, Scalar f1, Scalar f2, Scalar tol, int maxIter, Scalar &root, Scalar ftol = 0) {
+            if ((f1 > 0 && f2 > 0) || (f1 < 0 && f2 < 0))
+                return false; // Root must be bracketed
+            
+            if (f1 == 0) {
+                root = x1;
+                return true;
+            } else if (f2 == 0) {
+                root = x2;
+                return true;
+            }
+            
+            // Orient search so that f(xl) < 0
+            Scalar xl = f1 < 0 ? x1 : x2;
+            Scalar xh = f1 < 0 ? x2 : x1;
+            
+            Scalar x = x1 - f1 * (x2 - x1) / (f2 - f1);
+            for (int iter = 0; iter < maxIter; ++iter) {
+                Scalar f, df;
+                fdf(x, f, df);
+                
+                if (std::abs(f) <= ftol) {
+                    root = x;
+                    return true;
+                }
+                
+                if (f < 0)
+                    xl = x;
+                else
+                    xh = x;
+                
+                Scalar xn = df != 0 ? x - f / df : xl;
+                if ((xn - xl) * (xn - xh) >= 0) // Not strictly inside bracket
+                    xn = S(0.5) * (xl + xh);
+                
+                const Scalar dx = xn - x;
+                x = xn;
+                
+                if (std::abs(dx) < tol) {
+                    root = x;
+                    return true;
+                }
+            }
+            
+            root = x;
+            return false; // Max number of iterations exceeded.
+        }
+        
     }
 }
 
@@ -55,7 +55,7 @@ namespace volplay {
             
             /** Illuminate point from a single light source. */
             Vector illuminateFromLight(const Vector &p, const Vector &normal, const Vector &eye,
-                                       const MaterialPtr &m, const LightPtr &l, const SDFNode *node) const;
+                                       const MaterialPtr &m, const LightPtr &l, const SDFResult &closest) const;
             
             /** Calcuate light attenuation factor. */
             Scalar calculateLightAttenuation(const Scalar &d, const LightPtr &l) const;
@@ -64,7 +64,7 @@ namespace volplay {
             Scalar calculateSoftShadow(const Vector &origin, const Vector &dir,
                                        Scalar minT, Scalar maxT,
                                        const LightPtr &l,
-                                       const SDFNode *node) const;
+                                       const SDFResult &closest) const;
             
             
             ByteImagePtr _saturatedImage;
@@ -74,6 +74,7 @@ namespace volplay {
             MaterialPtr _defaultMaterial;
             Vector _clearColor;
             SDFNode::TraceOptions _to;
+            Scalar _rootLipschitz;
             Scalar _gamma;
             bool _shadowsEnabled;
             bool _fxaaEnabled;
@@ -100,7 +100,12 @@ namespace volplay {
             T *row(int index) {
                 return _data + _cols * _channels * index;
             }
-            
+
+            /** Access the i-th row. */
+            const T *row(int index) const {
+                return _data + _cols * _channels * index;
+            }
+
             /** Access element of row. */
             T *rowElement(T * row, int col)
             {
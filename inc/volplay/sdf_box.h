@@ -27,6 +27,15 @@ namespace volplay {
         /** Evaluate the SDF at given position. */
         virtual SDFResult fullEval(const Vector &x) const;
 
+        /** Evaluate the SDF. Bounds are ignored. */
+        virtual Scalar boundedEval(const Vector &x, Scalar lower, Scalar upper) const;
+
+        /** Bound the SDF over the given box. Exact. */
+        virtual math::Interval evalInterval(const AlignedBox &box) const;
+
+        /** Intersect ray in closed form. */
+        virtual bool intersectRay(const Vector &o, const Vector &d, Scalar minT, Scalar maxT, TraceResult &r) const;
+
 		/* Accept a node visitor. */
 		virtual void accept(SDFNodeVisitor &nv);
 
@@ -0,0 +1,45 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_SDF_BOX_SET
+#define VOLPLAY_SDF_BOX_SET
+
+#include <volplay/types.h>
+#include <volplay/sdf_primitive_set.h>
+#include <vector>
+
+namespace volplay {
+
+    /** Union of axis aligned boxes. See SDFPrimitiveSet. */
+    class SDFBoxSet : public SDFPrimitiveSet {
+    public:
+        /** Create from box centers and half lengths along each axis. */
+        SDFBoxSet(const std::vector<Vector> &centers, const std::vector<Vector> &halfLengths, int leafSize = 8);
+
+        /** Center of the i-th box. */
+        Vector center(int i) const;
+
+        /** Half lengths of the i-th box. */
+        Vector halfLengths(int i) const;
+
+		/* Accept a node visitor. */
+		virtual void accept(SDFNodeVisitor &nv);
+
+    protected:
+        /** Evaluate the boxes of a leaf. */
+        virtual void evalLeaf(const Vector &x, int first, int count, LeafArray &sdf) const;
+
+    private:
+        ParameterArray _cx, _cy, _cz;
+        ParameterArray _hx, _hy, _hz;
+    };
+
+}
+
+#endif
@@ -0,0 +1,53 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_SDF_CAPSULE_SET
+#define VOLPLAY_SDF_CAPSULE_SET
+
+#include <volplay/types.h>
+#include <volplay/sdf_primitive_set.h>
+#include <vector>
+
+namespace volplay {
+
+    /** 
+        Union of capsules. A capsule contains all points within its radius of the line segment
+        between its two end points. See SDFPrimitiveSet.
+    */
+    class SDFCapsuleSet : public SDFPrimitiveSet {
+    public:
+        /** Create from segment end points and radii. */
+        SDFCapsuleSet(const std::vector<Vector> &a, const std::vector<Vector> &b, const std::vector<Scalar> &radii, int leafSize = 8);
+
+        /** First end point of the i-th capsule. */
+        Vector a(int i) const;
+
+        /** Second end point of the i-th capsule. */
+        Vector b(int i) const;
+
+        /** Radius of the i-th capsule. */
+        Scalar radius(int i) const;
+
+		/* Accept a node visitor. */
+		virtual void accept(SDFNodeVisitor &nv);
+
+    protected:
+        /** Evaluate the capsules of a leaf. */
+        virtual void evalLeaf(const Vector &x, int first, int count, LeafArray &sdf) const;
+
+    private:
+        ParameterArray _ax, _ay, _az;
+        ParameterArray _abx, _aby, _abz;
+        ParameterArray _invLength2;
+        ParameterArray _radii;
+    };
+
+}
+
+#endif
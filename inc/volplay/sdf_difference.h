@@ -27,6 +27,18 @@ namespace volplay {
         /** Evaluate the SDF at given position. */
         virtual SDFResult fullEval(const Vector &x) const;
 
+        /** Evaluate the SDF within bounds. Stops once a child exceeds the upper bound. */
+        virtual Scalar boundedEval(const Vector &x, Scalar lower, Scalar upper) const;
+
+        /** Bound the SDF over the given box by combining bounds of children. */
+        virtual math::Interval evalInterval(const AlignedBox &box) const;
+
+        /** Evaluate the conservative distance of the difference of children. */
+        virtual Scalar safeEval(const Vector &x) const;
+
+        /** Largest Lipschitz bound of children along the segment. */
+        virtual Scalar segmentLipschitz(const Vector &a, const Vector &b) const;
+
 		/* Accept a node visitor. */
 		virtual void accept(SDFNodeVisitor &nv);
     };
@@ -22,20 +22,59 @@ namespace volplay {
         /** Empty transform initializer. */
         SDFDisplacement();
         
-        /** Initialize from transform */
-        SDFDisplacement(const ScalarFnc &fnc);
+        /** Initialize from displacement function and the Lipschitz bound of the function. */
+        SDFDisplacement(const ScalarFnc &fnc, Scalar lipschitz = Scalar(0));
         
         /** Evaluate the SDF at given position. */
         virtual SDFResult fullEval(const Vector &x) const;
+
+        /** Evaluate the SDF within bounds. */
+        virtual Scalar boundedEval(const Vector &x, Scalar lower, Scalar upper) const;
+
+        /** Bound the SDF over the given box. Unbounded when a displacement function is set, as functions cannot be bounded in general. */
+        virtual math::Interval evalInterval(const AlignedBox &box) const;
+
+        /** Lipschitz bound of children plus the bound declared for the displacement function. */
+        virtual Scalar lipschitz() const;
+
+        /** Evaluate a conservative distance. */
+        virtual Scalar safeEval(const Vector &x) const;
+
+        /** Lipschitz bound of children along the segment plus the bound declared for the displacement function. */
+        virtual Scalar segmentLipschitz(const Vector &a, const Vector &b) const;
+        
+        /** 
+            Set displacement function along with an upper bound of its Lipschitz constant. Functions 
+            not declaring their bound are not accounted for, so tracing steps as if the surface was 
+            undisplaced and may overshoot displacements that change quickly.
+        */
+        void setDisplacementFunction(const ScalarFnc &fnc, Scalar lipschitz = Scalar(0));
         
-        /** Set displacement function */
-        void setDisplacementFunction(const ScalarFnc &fnc);
+        /** Access displacement function */
+        const ScalarFnc &displacementFunction() const;
+
+        /** Access the Lipschitz bound of the displacement function. */
+        Scalar displacementLipschitz() const;
+        
+        /** Set a constant displacement that is added in addition to the displacement function. */
+        void setOffset(Scalar offset);
+        
+        /** Access the constant displacement */
+        Scalar offset() const;
+
+        /** Displaced children are not intersected in closed form. */
+        virtual bool intersectRay(const Vector &o, const Vector &d, Scalar minT, Scalar maxT, TraceResult &r) const;
+
+        /** Trace ray by sphere tracing. Children are not traced separately as by SDFUnion, as their distances are displaced. */
+        virtual Scalar trace(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr = 0) const;
 
 		/* Accept a node visitor. */
 		virtual void accept(SDFNodeVisitor &nv);
         
     private:
         ScalarFnc _dfnc;
+        Scalar _dfncLipschitz;
+        Scalar _offset;
     };
 
 }
@@ -42,6 +42,12 @@ namespace volplay {
         
         /** Returns the number of children in this group */
         SDFNodeArray::size_type size() const;
+        
+        /** Remove all children from this group */
+        void clear();
+
+        /** Largest Lipschitz bound of children. */
+        virtual Scalar lipschitz() const;
 
 		/* Test if this node is able to group other nodes. */
 		virtual bool isGroup() const;
@@ -286,14 +286,19 @@ namespace volplay {
             /** Constructor. Initializes a displacement with constant zero displacement. */
             explicit MakeDisplacement(MakeRoot *r);
 
-            /** Set the function that will perform the displacement. */
-            MakeDisplacement &fnc(const ScalarFnc &fnc);
+            /** Set the function that will perform the displacement along with its Lipschitz bound. See SDFDisplacement::setDisplacementFunction. */
+            MakeDisplacement &fnc(const ScalarFnc &fnc, Scalar lipschitz = Scalar(0));
+
+            /** Set a constant displacement. */
+            MakeDisplacement &offset(Scalar o);
 
             /** Create node */
             SDFNodePtr createNode() const;
 
         private:
-            ScalarFnc _fnc;            
+            ScalarFnc _fnc;
+            Scalar _lipschitz;
+            Scalar _offset;
         };
 
         // Implementation of MakeBase
@@ -0,0 +1,89 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_SDF_MESH
+#define VOLPLAY_SDF_MESH
+
+#include <volplay/types.h>
+#include <volplay/sdf_node.h>
+#include <volplay/surface/indexed_surface.h>
+#include <volplay/util/bounding_volume_hierarchy.h>
+#include <vector>
+
+namespace volplay {
+
+    /** 
+        A node computing signed distances to a triangle mesh.
+
+        Closest points are found using a bounding volume hierarchy over the triangles.
+        The sign is determined from angle weighted pseudo-normals at the closest feature
+        as proposed by Baerentzen and Aanaes in "Signed distance computation using the
+        angle weighted pseudonormal", 2005. This requires a closed, consistently oriented
+        mesh whose faces are counter-clockwise when seen from outside. Vertices sharing a
+        position are treated as one and degenerate faces are ignored.
+    */
+    class SDFMesh : public SDFNode {
+    public:
+        /** Create from surface. Quads are split into triangles. */
+        SDFMesh(const surface::IndexedSurface &s, int leafSize = 4);
+        
+        /** Evaluate the SDF at given position. */
+        virtual SDFResult fullEval(const Vector &x) const;
+
+        /** 
+            Evaluate the SDF at multiple positions in parallel. Consecutive positions 
+            close to each other are evaluated faster, as each query starts from the 
+            triangle closest to its predecessor.
+        */
+        void evalBatch(const std::vector<Vector> &x, std::vector<Scalar> &sdf) const;
+
+        /** 
+            Sample the SDF on a regular grid in parallel. Samples are returned x varying
+            fastest, as expected by SDFVolume::write.
+        */
+        std::vector<float> bake(const Vector &origin, const Index &dims, const Vector &spacing) const;
+
+        /** Closest point on the mesh and optionally the index of its triangle. */
+        Vector closestPoint(const Vector &x, int *triangle = 0) const;
+
+        /** Lower corner of the bounding box of the mesh. */
+        Vector lowerBounds() const;
+
+        /** Upper corner of the bounding box of the mesh. */
+        Vector upperBounds() const;
+
+		/* Accept a node visitor. */
+		virtual void accept(SDFNodeVisitor &nv);
+
+    private:
+        /** Result of a closest point query. */
+        struct Closest {
+            Vector p;
+            Scalar d2;
+            int triangle;
+            int feature;
+        };
+
+        void closest(const Vector &x, int hint, Closest &c) const;
+        void closestOnTriangle(const Vector &x, int t, Closest &c) const;
+        Scalar signedDistance(const Vector &x, const Closest &c) const;
+
+        surface::IndexedSurface::VertexMatrix _vertices;
+        surface::IndexedSurface::TriangleMatrix _triangles;
+        std::vector<int> _weld;
+        std::vector<int> _order;
+        util::BoundingVolumeHierarchy _bvh;
+        std::vector<Vector> _faceNormals;
+        std::vector<Vector> _edgeNormals;
+        std::vector<Vector> _vertexNormals;
+    };
+
+}
+
+#endif
@@ -12,6 +12,7 @@
 
 #include <volplay/types.h>
 #include <volplay/sdf_result.h>
+#include <volplay/math/interval.h>
 #include <unordered_map>
 #include <string>
 
@@ -28,7 +29,52 @@ namespace volplay {
         
         /** Evaluate the SDF at the given position. Returns signed distance and additional information. */
         virtual SDFResult fullEval(const Vector &x) const = 0;
+
+        /** 
+            Evaluate the SDF at the given position when only values within [lower, upper] are of interest.
+
+            Returns the signed distance if it lies within the bounds. Otherwise returns a value between 
+            the signed distance and the bound it violates, so callers can still tell the side and step 
+            safely. Groups use the bounds to skip evaluating children that cannot affect the result. The
+            default implementation evaluates the SDF.
+        */
+        virtual Scalar boundedEval(const Vector &x, Scalar lower, Scalar upper) const;
         
+        /** 
+            Bound the SDF over the given box. 
+            
+            The default implementation evaluates the SDF at the box center and widens the result by half 
+            the box diagonal times the Lipschitz bound. Nodes override this to give tighter bounds.
+        */
+        virtual math::Interval evalInterval(const AlignedBox &box) const;
+
+        /** 
+            Upper bound of the Lipschitz constant of the SDF. 
+            
+            Bounds how much faster the SDF may change than the distance to its surface. Sphere tracing 
+            steps by the SDF divided by this bound. Defaults to one, which holds for exact and 
+            underestimating distance functions.
+        */
+        virtual Scalar lipschitz() const;
+
+        /** 
+            Evaluate a conservative signed distance at the given position. 
+            
+            The SDF of every subtree is divided by its Lipschitz bound before being combined, so moving by 
+            the result in any direction does not cross the surface. Equals eval for nodes whose subtrees 
+            are 1-Lipschitz.
+        */
+        virtual Scalar safeEval(const Vector &x) const;
+
+        /**
+            Upper bound of the Lipschitz constant of the SDF restricted to the line segment from a to b.
+
+            Bounds the rate of change of the SDF along the direction of the segment only, so it may be far 
+            smaller than the global bound, for example when a ray grazes a surface. Segment tracing steps by 
+            the SDF divided by this bound. Defaults to the global bound.
+        */
+        virtual Scalar segmentLipschitz(const Vector &a, const Vector &b) const;
+
         /** Evaluate the gradient of the SDF at the given position.
          *  The gradient will always point in the direction of maximum distance increase.
          */
@@ -37,13 +83,38 @@ namespace volplay {
         /** Calculate the approximate unit normal at the given position. */
         virtual Vector normal(const Vector &x, Scalar eps = Scalar(0.0001)) const;
         
+        /** Ray marching methods */
+        enum TraceMethod {
+            SPHERE_TRACING,     ///< Step by the distance.
+            SEGMENT_TRACING     ///< Step by the distance divided by the Lipschitz bound along the ray ahead.
+        };
+
         /** Sphere tracing options */
         struct TraceOptions {
+            /** 
+                Ray marching method. Segment tracing, as described by Galin et al. in "Segment Tracing 
+                Using Local Lipschitz Bounds", 2020, bounds the SDF along a segment of the ray ahead and 
+                steps up to the end of the segment. The segment grows with every step. Defaults to sphere 
+                tracing.
+            */
+            TraceMethod method;
             Scalar minT;
             Scalar maxT;
             Scalar stepFact;
             Scalar sdfThreshold;
             int maxIter;
+            /** 
+                Length of ray segments tested by interval evaluation whenever a sphere tracing step is 
+                shorter. Segments the SDF is bounded away from the surface on are skipped at once, which 
+                helps rays grazing surfaces. Zero disables interval tests and is the default. Ignored by 
+                segment tracing.
+            */
+            Scalar intervalLength;
+            /**
+                Use closed form intersections of nodes supporting them, see SDFNode::intersectRay, and
+                only march the remaining nodes up to the closest exact intersection. Defaults to false.
+            */
+            bool exactIntersections;
             
             /** Default trace options */
             TraceOptions();
@@ -55,6 +126,7 @@ namespace volplay {
             Scalar t;               ///< Parametric t of ray equation
             Scalar sdf;             ///< Signed distance at intersection
             const SDFNode *node;    ///< Closed node
+            int element;            ///< Closest element of primitive sets, see SDFResult::element
             bool hit;               ///< True if abs(sdf) < TraceOptions.sdfThreshold
             
             /** Default trace options */
@@ -64,12 +136,34 @@ namespace volplay {
         /** Trace ray. Uses sphere tracing to find intersection */
         virtual Scalar trace(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr = 0) const;
 
+        /**
+            Intersect the ray o + t * d with the surface in closed form.
+
+            Returns false if the node cannot intersect rays exactly. Otherwise fills r with the smallest t 
+            within [minT, maxT] at which the ray reaches the surface. Rays starting inside the surface report 
+            minT and the negative distance there, rays missing the surface report maxT and an infinite 
+            distance. The default implementation returns false.
+        */
+        virtual bool intersectRay(const Vector &o, const Vector &d, Scalar minT, Scalar maxT, TraceResult &r) const;
+
+        /**
+            Single step of segment tracing along the ray o + t * d, see SEGMENT_TRACING. 
+            
+            Given the distance sdf at t, returns the step by which t can safely advance towards maxT, 
+            scaled by stepFact. Updates the length of the segment ahead for the next step. Pass a 
+            non-positive segment for the first step.
+        */
+        Scalar segmentStep(const Vector &o, const Vector &d, Scalar t, Scalar sdf, Scalar maxT, Scalar stepFact, Scalar &segment) const;
+
         /** Set attachments */
         void setAttachments(const AttachmentMap &other);
         
         /** Set node attachment */
         void setAttachment(const std::string &key, const SDFNodeAttachmentPtr &attachment);
         
+        /** Access all attachments */
+        const AttachmentMap &attachments() const;
+        
         /** Get node attachment */
         template<class Derived>
         std::shared_ptr<Derived> attachment(const std::string &key) const
@@ -118,6 +212,9 @@ namespace volplay {
 		virtual void acceptChildren(SDFNodeVisitor &nv);
         
     private:
+        /** Trace ray using segment tracing. */
+        Scalar traceSegments(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr) const;
+
         AttachmentMap _attachments;
     };
 
@@ -37,6 +37,27 @@ namespace volplay {
 		/* Visit node */
 		virtual void visit(SDFBox *n);
 
+		/* Visit node */
+		virtual void visit(SDFVolume *n);
+
+		/* Visit node */
+		virtual void visit(SDFMesh *n);
+
+		/* Visit node */
+		virtual void visit(SDFPrimitiveSet *n);
+
+		/* Visit node */
+		virtual void visit(SDFSphereSet *n);
+
+		/* Visit node */
+		virtual void visit(SDFBoxSet *n);
+
+		/* Visit node */
+		virtual void visit(SDFCapsuleSet *n);
+
+		/* Visit node */
+		virtual void visit(TSDFVolume *n);
+
 		/* Visit node */
 		virtual void visit(SDFGroup *n);
 
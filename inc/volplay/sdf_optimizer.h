@@ -0,0 +1,76 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_SDF_OPTIMIZER
+#define VOLPLAY_SDF_OPTIMIZER
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+#include <volplay/sdf_node_visitor.h>
+#include <unordered_set>
+
+namespace volplay {
+
+    /** Simplifies SDF node hierarchies without changing the signed distance they represent.
+
+        The following rewrites are applied
+            - consecutive SDFRigidTransforms are folded into a single transform.
+            - nested unions, intersections and differences are flattened.
+            - pass-through nodes (identity transforms and repetitions, plain unions and
+              displacements without effect) that have a single child are replaced by that child.
+            - nested constant SDFDisplacements are combined into a single offset.
+            - children of groups are reordered by estimated evaluation cost, cheapest first.
+
+        Leaf nodes and nodes carrying attachments are never removed, so node pointers returned
+        through SDFResult and attachment lookups remain valid. Note that the optimization is
+        performed in place.
+    */
+    class SDFOptimizer : public SDFNodeVisitor {
+    public:
+        /** Default initializer. Enables all optimizations. */
+        SDFOptimizer();
+
+        /** Enable / disable reordering of children by estimated cost. */
+        void setReorderByCostEnabled(bool enable);
+
+        /** Optimize the hierarchy starting at the given node. Returns the new root node. */
+        SDFNodePtr optimize(const SDFNodePtr &root);
+
+        /** Estimate the relative cost of evaluating the given node. */
+        static Scalar estimateCost(const SDFNode *n);
+
+        /* Visit node */
+        virtual void visit(SDFUnion *n);
+
+        /* Visit node */
+        virtual void visit(SDFIntersection *n);
+
+        /* Visit node */
+        virtual void visit(SDFDifference *n);
+
+        /* Visit node */
+        virtual void visit(SDFRigidTransform *n);
+
+        /* Visit node */
+        virtual void visit(SDFDisplacement *n);
+
+    private:
+        /** Simplify the direct children of the given group. Returns true when children changed. */
+        bool simplifyChildren(SDFGroup *g, bool isUnion);
+
+        /** Reorder children of all groups in hierarchy by cost. */
+        Scalar reorderByCost(SDFNode *n);
+
+        std::unordered_set<SDFNode*> _visited;
+        bool _reorder;
+    };
+
+}
+
+#endif
@@ -0,0 +1,86 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_SDF_PRIMITIVE_SET
+#define VOLPLAY_SDF_PRIMITIVE_SET
+
+#include <volplay/types.h>
+#include <volplay/sdf_node.h>
+#include <volplay/util/bounding_volume_hierarchy.h>
+#include <vector>
+
+namespace volplay {
+
+    /**
+        Base of nodes representing the union of many primitives of the same kind.
+
+        Scenes of many small primitives are expensive as unions of individual nodes, since each
+        evaluation visits every child. Sets store the parameters of all primitives in contiguous
+        arrays, one per parameter, and find the closest primitive using a bounding volume hierarchy
+        over the primitives. Parameters are ordered by leaf of the hierarchy, so that the primitives
+        of a leaf are evaluated together using vectorized array operations.
+
+        The index of the closest primitive, in order of construction, is reported in
+        SDFResult::element and SDFNode::TraceResult::element. Sets cannot be modified once
+        constructed.
+    */
+    class SDFPrimitiveSet : public SDFNode {
+    public:
+        /** Maximum number of primitives per leaf of the hierarchy. */
+        enum { MaxLeafSize = 32 };
+
+        /** Evaluate the SDF at given position. */
+        virtual SDFResult fullEval(const Vector &x) const;
+
+        /** Evaluate the SDF. Stops searching once a primitive below the lower bound is found. */
+        virtual Scalar boundedEval(const Vector &x, Scalar lower, Scalar upper) const;
+
+        /** Number of primitives. */
+        int size() const;
+
+        /** Lower corner of the bounding box of all primitives. */
+        Vector lowerBounds() const;
+
+        /** Upper corner of the bounding box of all primitives. */
+        Vector upperBounds() const;
+
+    protected:
+        /** Array of primitive parameters. */
+        typedef Eigen::Array<Scalar, Eigen::Dynamic, 1> ParameterArray;
+
+        /** Signed distances of the primitives of a leaf. */
+        typedef Eigen::Array<Scalar, Eigen::Dynamic, 1, Eigen::ColMajor, MaxLeafSize, 1> LeafArray;
+
+        /**
+            Build the hierarchy given the bounds of each primitive. Afterwards, the i-th primitive
+            in leaf order is primitive elementId(i) in order of construction. Derived classes
+            reorder their parameters accordingly.
+        */
+        void buildHierarchy(const std::vector<AlignedBox> &bounds, int leafSize);
+
+        /** Index in order of construction of the primitive at the given position in leaf order. */
+        int elementId(int i) const;
+
+        /** Position in leaf order of the given primitive. */
+        int leafIndex(int element) const;
+
+        /** Evaluate the signed distances of count primitives in leaf order starting at first. */
+        virtual void evalLeaf(const Vector &x, int first, int count, LeafArray &sdf) const = 0;
+
+    private:
+        Scalar closest(const Vector &x, Scalar lower, Scalar upper, int &element) const;
+
+        std::vector<int> _ids;
+        std::vector<int> _leafIndices;
+        util::BoundingVolumeHierarchy _bvh;
+    };
+
+}
+
+#endif
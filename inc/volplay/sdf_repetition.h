@@ -36,6 +36,24 @@ namespace volplay {
         /** Evaluate the SDF at given position. */
         virtual SDFResult fullEval(const Vector &x) const;
 
+        /** Evaluate the SDF within bounds. */
+        virtual Scalar boundedEval(const Vector &x, Scalar lower, Scalar upper) const;
+
+        /** Bound the SDF over the given box. Children are bounded over the box enclosing all positions the box folds to. */
+        virtual math::Interval evalInterval(const AlignedBox &box) const;
+
+        /** Evaluate a conservative distance. */
+        virtual Scalar safeEval(const Vector &x) const;
+
+        /** Folded segments are not contiguous, so the global bound is returned. */
+        virtual Scalar segmentLipschitz(const Vector &a, const Vector &b) const;
+
+        /** Repeated children are not intersected in closed form. */
+        virtual bool intersectRay(const Vector &o, const Vector &d, Scalar minT, Scalar maxT, TraceResult &r) const;
+
+        /** Trace ray by sphere tracing. Children are not traced separately as by SDFUnion, as they see wrapped positions. */
+        virtual Scalar trace(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr = 0) const;
+
 		/* Accept a node visitor. */
 		virtual void accept(SDFNodeVisitor &nv);
 
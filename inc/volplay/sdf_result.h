@@ -17,10 +17,17 @@ namespace volplay {
     
     /** Represents the result querying the signed distance field at a specific location. */
     struct SDFResult {
+        /** Create result. Elements default to zero for nodes other than primitive sets. */
+        SDFResult(const SDFNode *node = 0, Scalar sdf = 0, int element = 0)
+            : node(node), sdf(sdf), element(element)
+        {}
+
         /** Closest node */
         const SDFNode *node;
         /** Signed distance */
         Scalar sdf;
+        /** Index of the closest element of primitive sets. Zero for other nodes. */
+        int element;
     };
     
 }
@@ -30,6 +30,18 @@ namespace volplay {
         
         /** Evaluate the SDF at given position. */
         virtual SDFResult fullEval(const Vector &x) const;
+
+        /** Evaluate the SDF within bounds. */
+        virtual Scalar boundedEval(const Vector &x, Scalar lower, Scalar upper) const;
+
+        /** Bound the SDF over the given box. Children are bounded over the box enclosing the transformed box. */
+        virtual math::Interval evalInterval(const AlignedBox &box) const;
+
+        /** Lipschitz bound of children scaled by the largest singular value of the world to local transform. */
+        virtual Scalar lipschitz() const;
+
+        /** Evaluate a conservative distance. */
+        virtual Scalar safeEval(const Vector &x) const;
         
         /** Access the stored transform */
         AffineTransform localToWorld() const;
@@ -40,11 +52,21 @@ namespace volplay {
         /** Set a new transform */
         void setLocalToWorld(const AffineTransform &t);
 
+        /** Lipschitz bound of children along the transformed segment. */
+        virtual Scalar segmentLipschitz(const Vector &a, const Vector &b) const;
+
+        /** Intersect the transformed ray with children in closed form. */
+        virtual bool intersectRay(const Vector &o, const Vector &d, Scalar minT, Scalar maxT, TraceResult &r) const;
+
+        /** Trace ray by sphere tracing. Children are not traced separately as by SDFUnion, as they see transformed positions. */
+        virtual Scalar trace(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr = 0) const;
+
 		/* Accept a node visitor. */
 		virtual void accept(SDFNodeVisitor &nv);
         
     private:
         AffineTransform _worldToLocal;
+        Scalar _scale;
     };
 
 }
@@ -0,0 +1,45 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_SDF_SPHERE_SET
+#define VOLPLAY_SDF_SPHERE_SET
+
+#include <volplay/types.h>
+#include <volplay/sdf_primitive_set.h>
+#include <vector>
+
+namespace volplay {
+
+    /** Union of spheres. See SDFPrimitiveSet. */
+    class SDFSphereSet : public SDFPrimitiveSet {
+    public:
+        /** Create from sphere centers and radii. */
+        SDFSphereSet(const std::vector<Vector> &centers, const std::vector<Scalar> &radii, int leafSize = 8);
+
+        /** Center of the i-th sphere. */
+        Vector center(int i) const;
+
+        /** Radius of the i-th sphere. */
+        Scalar radius(int i) const;
+
+		/* Accept a node visitor. */
+		virtual void accept(SDFNodeVisitor &nv);
+
+    protected:
+        /** Evaluate the spheres of a leaf. */
+        virtual void evalLeaf(const Vector &x, int first, int count, LeafArray &sdf) const;
+
+    private:
+        ParameterArray _cx, _cy, _cz;
+        ParameterArray _radii;
+    };
+
+}
+
+#endif
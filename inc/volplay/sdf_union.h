@@ -28,6 +28,33 @@ namespace volplay {
         /** Evaluate the SDF at given position. */
         virtual SDFResult fullEval(const Vector &x) const;
 
+        /** Evaluate the SDF within bounds. Stops once a child falls below the lower bound. */
+        virtual Scalar boundedEval(const Vector &x, Scalar lower, Scalar upper) const;
+
+        /** Bound the SDF over the given box by combining bounds of children. */
+        virtual math::Interval evalInterval(const AlignedBox &box) const;
+
+        /** Evaluate the minimum conservative distance of children. */
+        virtual Scalar safeEval(const Vector &x) const;
+
+        /** 
+            Largest Lipschitz bound along the segment of children that may be closest somewhere on 
+            the segment. Children are evaluated at the segment start to rule out the others, only as 
+            far as needed to do so.
+        */
+        virtual Scalar segmentLipschitz(const Vector &a, const Vector &b) const;
+
+        /** Intersect ray in closed form if all children can. Reports the closest intersection of children. */
+        virtual bool intersectRay(const Vector &o, const Vector &d, Scalar minT, Scalar maxT, TraceResult &r) const;
+
+        /** 
+            Trace ray. When exact intersections are requested, children supporting closed form intersections 
+            are intersected and the remaining children are traced up to the closest intersection.
+            Derived nodes changing positions or distances of children need to override this, 
+            see SDFRigidTransform.
+        */
+        virtual Scalar trace(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr = 0) const;
+
 		/* Accept a node visitor. */
 		virtual void accept(SDFNodeVisitor &nv);
     };
@@ -0,0 +1,91 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_SDF_VOLUME
+#define VOLPLAY_SDF_VOLUME
+
+#include <volplay/types.h>
+#include <volplay/sdf_node.h>
+#include <volplay/util/mapped_file.h>
+#include <string>
+#include <vector>
+
+namespace volplay {
+
+    /**
+        A node sampling distances from a regular grid stored in a file.
+
+        The file holds a small header followed by one float per grid point. Samples are
+        either stored in raw layout, x varying fastest, or in bricked layout, where the grid
+        is split into cubic bricks of power of two size stored one after another. Bricked
+        layout keeps neighboring samples close in memory, so that the pages touched during
+        evaluation are few.
+
+        The file is memory mapped, only the pages accessed are loaded. Values between grid
+        points are interpolated trilinearly. Outside of the grid the value at the closest
+        grid position is increased by the distance to it.
+    */
+    class SDFVolume : public SDFNode {
+    public:
+        /** Create an empty volume. */
+        SDFVolume();
+
+        /** Open volume file. */
+        bool open(const std::string &filename);
+
+        /** Test if a volume file is open. */
+        bool isOpen() const;
+
+        /** Number of grid points per dimension. */
+        const Index &dimensions() const;
+
+        /** World position of the first grid point. */
+        const Vector &origin() const;
+
+        /** Distance between grid points per dimension. */
+        const Vector &spacing() const;
+
+        /** Size of bricks or zero for raw layout. */
+        int brickSize() const;
+
+        /** Value at grid point. */
+        Scalar sample(const Index &i) const;
+
+        /** Evaluate the SDF at given position. */
+        virtual SDFResult fullEval(const Vector &x) const;
+
+		/* Accept a node visitor. */
+		virtual void accept(SDFNodeVisitor &nv);
+
+        /**
+            Write volume file. Samples are given in raw layout. A brick size of zero
+            selects raw layout, otherwise brick size must be a power of two.
+        */
+        static bool write(
+            const std::string &filename,
+            const Index &dims, const Vector &origin, const Vector &spacing,
+            const std::vector<float> &samples,
+            int brickSize = 0);
+
+    private:
+        size_t offset(int x, int y, int z) const;
+
+        util::MappedFile _file;
+        const float *_samples;
+        Index _dims;
+        Index _bricks;
+        Vector _origin;
+        Vector _spacing;
+        int _brickSize;
+        int _brickShift;
+    };
+
+}
+
+#endif
@@ -0,0 +1,176 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_BLOCK_GRID
+#define VOLPLAY_BLOCK_GRID
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+#include <vector>
+
+namespace volplay {
+
+    namespace surface {
+
+        /**
+            Partition of a voxel grid into cubic blocks for parallel surface extraction.
+
+            The grid is given by its corners [lower, upper]. Voxels are identified by their
+            minimum corner and span [lower, upper - 1]. Every corner, voxel and edge of the grid
+            is owned by exactly one block, namely the one containing its minimum corner. Block
+            extractors generate shared vertices only in the owning block, which deduplicates
+            vertices across block boundaries without hashing.
+        */
+        class BlockGrid {
+        public:
+            /** Create partition of corners [lower, upper] into blocks of blockSize voxels per dimension. */
+            BlockGrid(const Index &lower, const Index &upper, int blockSize);
+
+            /** Number of blocks. */
+            int size() const;
+
+            /** Lower grid corner. */
+            const Index &lower() const;
+
+            /** Upper grid corner. */
+            const Index &upper() const;
+
+            /** Minimum corner of block. */
+            Index blockLower(int b) const;
+
+            /** Maximum corner of block. Corners [blockLower, blockUpper] are required to process the block. */
+            Index blockUpper(int b) const;
+
+            /** Maximum corner owned by block. Equals blockUpper - 1 except for blocks at the upper grid boundary. */
+            Index ownedUpper(int b) const;
+
+            /** Block owning the given corner. Corner must be within grid. */
+            int owner(const Index &c) const;
+
+            /** Test if corner is within grid. */
+            bool contains(const Index &c) const;
+
+            /** 
+                Test if the block cannot contain the iso-surface using a single evaluation at its center. 
+                
+                Assumes the scene does not overestimate distances to the surface.
+            */
+            bool isEmpty(int b, const SDFNode &scene, const AffineTransform &toWorld, Scalar iso) const;
+
+        private:
+            Index _lower, _upper;
+            Index _nblocks;
+            int _blockSize;
+        };
+
+        /** Dense signed distance samples of the corners of a single block. */
+        class BlockSamples {
+        public:
+            /** Sample corners [lower, upper] of the grid given by its voxel to world transform. Samples are offset by -iso. */
+            void sample(const SDFNode &scene, const AffineTransform &toWorld, const Index &lower, const Index &upper, Scalar iso);
+
+            /** Number of corners sampled. */
+            int size() const
+            {
+                return int(_samples.size());
+            }
+
+            /** Linear index of corner. */
+            int index(const Index &c) const
+            {
+                return ((c.z() - _lower.z()) * _dims.y() + (c.y() - _lower.y())) * _dims.x() + (c.x() - _lower.x());
+            }
+
+            /** Access sample at corner. */
+            Scalar operator()(const Index &c) const
+            {
+                return _samples[index(c)];
+            }
+
+            /** Release memory of samples. */
+            void clear();
+
+        private:
+            Index _lower, _dims;
+            std::vector<Scalar> _samples;
+        };
+
+        /** Reference to a vertex generated by the block owning corner. Sub distinguishes multiple vertices per corner. */
+        struct BlockVertexRef {
+            Index corner;
+            int sub;
+
+            BlockVertexRef()
+            {}
+
+            BlockVertexRef(const Index &corner_, int sub_)
+                : corner(corner_), sub(sub_)
+            {}
+        };
+
+        /**
+            Partial mesh extracted from a single block.
+
+            Vertices are identified by a corner of the block and a sub index, e.g. the axis of
+            the edge a vertex is placed on. Triangles may reference vertices of other blocks.
+        */
+        struct BlockMesh {
+            /** Keys of vertices generated by this block in increasing order. */
+            std::vector<int> keys;
+            /** Vertices in order of keys. */
+            std::vector<Vector> vertices;
+            /** Triangles, three consecutive references each. */
+            std::vector<BlockVertexRef> triangles;
+
+            /** Setup key space for corners [lower, upper] with subs vertices per corner. */
+            void reset(const Index &lower, const Index &upper, int subs);
+
+            /** Add vertex. Vertices need to be added in increasing key order, which corresponds to visiting corners in x, y, z order. */
+            void addVertex(const Index &c, int sub, const Vector &p)
+            {
+                keys.push_back(key(c, sub));
+                vertices.push_back(p);
+            }
+
+            /** Add triangle. */
+            void addTriangle(const BlockVertexRef &a, const BlockVertexRef &b, const BlockVertexRef &c)
+            {
+                triangles.push_back(a);
+                triangles.push_back(b);
+                triangles.push_back(c);
+            }
+
+            /** Key of vertex. */
+            int key(const Index &c, int sub) const
+            {
+                return (((c.z() - _lower.z()) * _dims.y() + (c.y() - _lower.y())) * _dims.x() + (c.x() - _lower.x())) * _subs + sub;
+            }
+
+            /** Find index of vertex generated by this block. Returns -1 if not found. */
+            int find(const Index &c, int sub) const;
+
+        private:
+            Index _lower, _dims;
+            int _subs;
+        };
+
+        /** 
+            Assemble block meshes into a single surface. 
+            
+            Vertex references are resolved through the blocks owning the referenced corners. Triangles
+            referencing vertices their owning blocks did not generate are dropped. This happens when 
+            a block was skipped as empty although the surface passes through it, for example for 
+            scenes overestimating distances.
+        */
+        void assembleBlocks(const BlockGrid &grid, const std::vector<BlockMesh> &blocks, IndexedSurface &surface);
+
+    }
+}
+
+#endif
@@ -0,0 +1,164 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_CHUNK_MANAGER
+#define VOLPLAY_CHUNK_MANAGER
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+#include <volplay/surface/dual_contouring.h>
+#include <volplay/surface/mesh_chunk.h>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace volplay {
+
+    namespace surface {
+
+        /**
+            Maintains meshed chunks of an unbounded scene around a moving viewpoint.
+
+            Space is divided into cubic chunks of fixed edge length. Each call to update
+            determines the chunks within the view radius and queues missing ones for extraction
+            on worker threads, nearest first. Chunks farther away are extracted at coarser
+            levels of detail, each level halving the number of voxels per chunk.
+
+            Chunks of the same level share a voxel grid. Each chunk is extracted as a block of it 
+            using a copy of the configured extractor, see DualContouring::computeBlock, so it 
+            generates the vertices of its own voxels and the faces of its own edges only. Faces 
+            along the lower sides of a chunk reference vertices of neighboring chunks by voxel. 
+            These are taken from the neighbors when cached, otherwise from approximations computed 
+            by the chunk itself. Chunks are resolved again when their neighbors arrive. Faces are 
+            triangles and adaptive simplification is not applied. Chunks of different levels are 
+            not stitched.
+
+            Meshes are kept in a cache limited by a memory budget. When exceeded, chunks
+            outside the current view are evicted in least recently used order.
+        */
+        class ChunkManager {
+        public:
+            /** Identifies a chunk by its integer coordinates and level of detail. */
+            struct ChunkKey {
+                Index coords;
+                int level;
+
+                ChunkKey();
+                ChunkKey(const Index &coords, int level);
+
+                bool operator<(const ChunkKey &other) const;
+            };
+
+            /** Meshed chunk. */
+            struct Chunk {
+                ChunkKey key;
+                std::shared_ptr<const IndexedSurface> surface;
+                /** Bytes cached for the chunk, its surface and the block data kept to stitch neighbors. */
+                size_t bytes;
+            };
+
+            /** Create manager for scene with chunks of given edge length and voxels per dimension at the finest level. */
+            ChunkManager(SDFNodePtr scene, Scalar chunkLength, int voxelsPerChunk, int workers = 2);
+
+            /** Stops workers. Chunks pending are discarded. */
+            ~ChunkManager();
+
+            /** Set the extractor used as template. Bounds and resolution are set per chunk. */
+            void setExtractor(const DualContouring &dc, DualContouring::EComputeType et = DualContouring::COMPUTE_NONLINEAR_DC);
+
+            /** Set the radius around the viewpoint in which chunks are maintained. */
+            void setViewRadius(Scalar r);
+
+            /**
+                Set the level of detail distances. Chunks whose center is farther than
+                distance * 2^(l-1) from the viewpoint are extracted at level l, up to maxLevel.
+                Defaults to infinite distance, i.e. no coarsening.
+            */
+            void setLevelOfDetail(Scalar distance, int maxLevel);
+
+            /** Set the memory budget of cached meshes in bytes. */
+            void setMemoryBudget(size_t bytes);
+
+            /** Update chunks for the viewpoint. Schedules missing chunks and evicts cached chunks over budget. */
+            void update(const Vector &viewpoint);
+
+            /** Block until all scheduled chunks are extracted. */
+            void waitIdle();
+
+            /**
+                Chunks available for the last viewpoint. Where the chunk at the desired level
+                is not yet available, a cached chunk of another level at the same coordinates
+                is reported instead.
+            */
+            std::vector<Chunk> visibleChunks() const;
+
+            /** Number of bytes of cached chunks, see Chunk::bytes. */
+            size_t memoryUsage() const;
+
+            /** Number of cached meshes. */
+            size_t cachedChunks() const;
+
+            /** Lower world corner of chunk. */
+            Vector chunkLower(const Index &coords) const;
+
+            /** Level of detail of chunk for viewpoint. */
+            int levelFor(const Index &coords, const Vector &viewpoint) const;
+
+        private:
+            typedef std::shared_ptr<const MeshChunk> MeshChunkPtr;
+
+            struct Entry {
+                std::shared_ptr<const IndexedSurface> surface;
+                MeshChunkPtr block;
+                size_t bytes;
+                unsigned long long lastUsed;
+                unsigned long long resolved;
+                bool pending;
+            };
+
+            typedef std::map<ChunkKey, Entry> EntryMap;
+
+            void work();
+            void extract(const ChunkKey &key, MeshChunk &block) const;
+            void resolve(const ChunkKey &key, const MeshChunkPtr *blocks, IndexedSurface &s) const;
+            void evict();
+
+            SDFNodePtr _scene;
+            Scalar _chunkLength;
+            int _voxelsPerChunk;
+
+            DualContouring _dc;
+            DualContouring::EComputeType _computeType;
+            Scalar _radius;
+            Scalar _lodDistance;
+            int _maxLevel;
+            size_t _budget;
+
+            mutable std::mutex _mutex;
+            std::condition_variable _queueChanged;
+            std::condition_variable _idle;
+            EntryMap _entries;
+            std::deque<ChunkKey> _queue;
+            std::vector<ChunkKey> _view;
+            size_t _bytes;
+            int _busy;
+            unsigned long long _tick;
+            unsigned long long _resolves;
+            bool _stop;
+            std::vector<std::thread> _workers;
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,84 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_CORNER_SAMPLE_CACHE
+#define VOLPLAY_CORNER_SAMPLE_CACHE
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+#include <vector>
+
+namespace volplay {
+
+    namespace surface {
+
+        /**
+            Caches signed distance samples at voxel grid corners.
+
+            Holds two consecutive z-slices of corner samples of the grid spanned by
+            [lower, upper], so that every corner is evaluated exactly once while sweeping
+            the grid along z. Slices are sampled in parallel.
+
+            Optionally, tiles of corners are skipped when the scene is bounded away from all levels of 
+            interest over the box enclosing the tile and its neighboring corners. Corners of skipped 
+            tiles hold the lower bound instead of a sample. Relative to each level it has the same sign 
+            as the samples of all corners sharing an edge with them, so crossing edges are preserved.
+        */
+        class CornerSampleCache {
+        public:
+            /** Create cache for corners in [lower, upper] of grid given by its voxel to world transform. */
+            CornerSampleCache(const SDFNodePtr &scene, const AffineTransform &toWorld, const Index &lower, const Index &upper);
+
+            /** Skip tiles of corners that cannot be part of edges crossing any of the given levels. */
+            void setPruningLevels(const std::vector<Scalar> &levels);
+
+            /** Make corner samples of slices z and z + 1 available. Samples already cached are reused. */
+            void moveTo(Index::Scalar z);
+
+            /** Access sample at corner. Corner must be within the slices made available by moveTo. */
+            Scalar operator()(Index::Scalar x, Index::Scalar y, Index::Scalar z) const
+            {
+                const std::vector<Scalar> &s = _slices[slot(z)];
+                return s[(y - _lower.y()) * _nx + (x - _lower.x())];
+            }
+
+            /** Number of scene evaluations performed so far. */
+            size_t evaluations() const;
+
+            /** Number of interval evaluations of the scene performed so far. */
+            size_t intervalEvaluations() const;
+
+        private:
+            /** Side length of tiles in corners. */
+            enum { TileSize = 8 };
+
+            /** Slot of slice in ring buffer. */
+            int slot(Index::Scalar z) const
+            {
+                return int((z - _lower.z()) & 1);
+            }
+
+            /** Sample a single slice. */
+            void sampleSlice(Index::Scalar z);
+
+            SDFNodePtr _scene;
+            AffineTransform _toWorld;
+            Index _lower, _upper;
+            Index::Scalar _nx, _ny;
+            std::vector<Scalar> _slices[2];
+            Index::Scalar _sliceZ[2];
+            size_t _evaluations;
+            std::vector<Scalar> _levels;
+            size_t _intervalEvaluations;
+        };
+
+    }
+}
+
+#endif
@@ -12,6 +12,8 @@
 
 #include <volplay/types.h>
 #include <volplay/fwd.h>
+#include <string>
+#include <vector>
 
 namespace volplay {
 
@@ -39,9 +41,24 @@ namespace volplay {
             /** Set the lower bound of the volume to be reconstructed. */
             void setUpperBounds(const Vector &upper);
 
-            /** Set the resolution of the uniform grid. */
+            /** 
+                Set the resolution of the uniform grid. 
+                
+                Voxels are addressed by 20 bits per axis, so bounds must span fewer than 2^19 voxels 
+                per axis. Larger grids are rejected: extraction returns empty surfaces, while 
+                computeChunked and saveHermiteData return false.
+            */
             void setResolution(const Vector &resolution);
 
+            /** Access the lower bound of the volume to be reconstructed. */
+            const Vector &lowerBounds() const;
+
+            /** Access the upper bound of the volume to be reconstructed. */
+            const Vector &upperBounds() const;
+
+            /** Access the resolution of the uniform grid. */
+            const Vector &resolution() const;
+
             /** Set the iso value at which to contour. Defaults to zero. */
             void setIsoLevel(Scalar iso);
 
@@ -55,12 +72,173 @@ namespace volplay {
                 COMPUTE_MIDPOINT
             };
 
-            /** Extract the surface. */
+            /** Determine how edge intersections are refined when using COMPUTE_NONLINEAR_DC. */
+            enum ERootFinder {
+                /** Brent's method to machine precision. */
+                ROOT_BRENT,
+                /** Illinois variant of regula falsi. Stops at the root tolerance. */
+                ROOT_ILLINOIS,
+                /** Newton's method safeguarded by bisection. The final SDF gradient doubles as the edge normal. */
+                ROOT_NEWTON,
+                /** Illinois method advancing all crossing edges in lockstep with parallel evaluation per iteration. */
+                ROOT_ILLINOIS_BATCHED
+            };
+
+            /** Set the root finder for non linear edge intersections. Defaults to ROOT_BRENT. */
+            void setRootFinder(ERootFinder rf);
+
+            /** Set the tolerance of edge intersections relative to the voxel edge length. Defaults to 0.001. Not used by ROOT_BRENT. */
+            void setRootTolerance(Scalar tol);
+
+            /** Determine the type of faces generated. */
+            enum EFaceType {
+                /** Split each quad into two triangles. */
+                FACE_TRIANGLES,
+                /** Output one quad per crossing edge. Faces of the resulting surface have four rows. */
+                FACE_QUADS
+            };
+
+            /** 
+                Set the type of faces generated. Defaults to FACE_TRIANGLES. 
+                
+                Surfaces store faces of a single type. With FACE_QUADS and adaptive simplification, faces 
+                spanning collapsed cells may have only three distinct vertices. Those are output as 
+                degenerate quads with zero area whose last index repeats the third one.
+            */
+            void setFaceType(EFaceType ft);
+
+            /** 
+                Enable adaptive simplification. Octree cells are collapsed into a single vertex as long as the 
+                error of their merged QEF, the sum of squared distances to the tangent planes of all 
+                intersections, stays at most maxError. Zero disables simplification and is the default.
+                Not used by COMPUTE_MIDPOINT. With FACE_QUADS, triangles are output as degenerate quads, 
+                see setFaceType.
+            */
+            void setSimplificationError(Scalar maxError);
+
+            /** Set the number of voxels per dimension of chunks generated by computeChunked. Defaults to 64. */
+            void setChunkSize(int voxels);
+
+            /** 
+                Enable periodicity aware extraction. When the scene root is an SDFRepetition whose cells 
+                span an integral number of voxels and the lower bounds are multiples of the resolution,
+                only a single cell is sampled and the surface is assembled from copies of it. Not used with adaptive simplification or computeChunked. Defaults to true.
+            */
+            void setPeriodicityEnabled(bool enable);
+
+            /** 
+                Set the threshold below which singular values of the QEF are truncated when placing vertices. 
+                Larger values move vertices towards the mass point of their intersections. Also applies to
+                vertices of cells collapsed by adaptive simplification. Defaults to 0.1.
+            */
+            void setSingularValueThreshold(Scalar threshold);
+
+            /** 
+                Enable reordering of extracted surfaces for locality. Vertices are sorted along a Morton curve
+                and faces are reordered for vertex cache efficiency using LocalityOptimizer. Applies to compute,
+                computeIsoLevels and computeFromHermiteData. Defaults to false.
+            */
+            void setLocalityOptimizationEnabled(bool enable);
+
+            /** 
+                Enable interval pruning. Tiles of grid corners are skipped without sampling when the interval 
+                bounds of the scene, see SDFNode::evalInterval, exclude the iso level over their neighborhood. 
+                Pays off for scenes with large empty or solid regions. Defaults to false.
+            */
+            void setIntervalPruningEnabled(bool enable);
+
+            /** Scene evaluation counts of the last call to compute. A central difference normal costs six evaluations. */
+            struct Statistics {
+                /** Evaluations at grid corners. */
+                size_t cornerEvaluations;
+                /** Evaluations spent refining edge intersections. */
+                size_t rootEvaluations;
+                /** Evaluations spent computing edge normals. */
+                size_t normalEvaluations;
+                /** Interval evaluations spent pruning corners. Zero unless enabled. */
+                size_t intervalEvaluations;
+                /** Number of edges crossed by the surface. */
+                size_t crossingEdges;
+                /** Average vertex cache miss ratio before locality optimization. Zero unless enabled. */
+                Scalar acmrBefore;
+                /** Average vertex cache miss ratio after locality optimization. Zero unless enabled. */
+                Scalar acmrAfter;
+
+                Statistics();
+            };
+
+            /** Access statistics of last surface extraction. */
+            const Statistics &statistics() const;
+
+            /** Extract the surface. Returns an empty surface if the grid is too large, see setResolution. */
             IndexedSurface compute(SDFNodePtr scene, EComputeType et = COMPUTE_NONLINEAR_DC);
+
+            /** 
+                Extract the surfaces of multiple iso levels, e.g. nested offset shells.
+
+                The grid is sampled once and corner samples are shared by all levels. Edge intersections, 
+                vertices and faces are then computed level by level. Returns one surface per level in 
+                order of levels. The iso level set by setIsoLevel and periodicity are not used. 
+                Statistics are summed over all levels.
+            */
+            std::vector<IndexedSurface> computeIsoLevels(SDFNodePtr scene, const std::vector<Scalar> &levels, EComputeType et = COMPUTE_NONLINEAR_DC);
+
+            /** 
+                Extract the surface chunk by chunk and write the chunks to disk. 
+                
+                The grid is partitioned into blocks of the chunk size. Each block is processed on its own 
+                and written to prefix.<block>.chunk before the next one starts, so memory is bounded 
+                by the chunk size rather than the size of the surface. A manifest is written to 
+                prefix.chunks. Use mergeChunks to join the chunks into a single file. Adaptive 
+                simplification is not applied. Returns false when writing fails or the grid is too 
+                large, see setResolution.
+            */
+            bool computeChunked(SDFNodePtr scene, const std::string &prefix, EComputeType et = COMPUTE_NONLINEAR_DC);
+
+            /** Partition of the grid spanned by the current bounds and resolution into blocks. */
+            BlockGrid blockGrid(int blockSize) const;
+
+            /**
+                Extract the part of the surface owned by block b of grid. 
+                
+                Only the corners of the block are sampled. Vertices are generated for voxels owned 
+                by the block, faces for edges owned by the block. Faces reference vertices of
+                neighboring blocks by voxel. Statistics are accumulated rather than reset. Chunks of 
+                grids too large to be addressed are empty, see setResolution.
+            */
+            void computeBlock(SDFNodePtr scene, const BlockGrid &grid, int b, MeshChunk &chunk, EComputeType et = COMPUTE_NONLINEAR_DC);
+
+            /** 
+                Sample the scene and save the resulting Hermite data to a file. 
+                
+                Edge intersections are computed as by compute. The cache allows experimenting with
+                vertex placement without evaluating the scene again. Returns false when writing fails
+                or the grid is too large, see setResolution.
+            */
+            bool saveHermiteData(SDFNodePtr scene, const std::string &filename, EComputeType et = COMPUTE_NONLINEAR_DC);
+
+            /** 
+                Extract the surface from cached Hermite data without accessing the scene. 
+                
+                Bounds and resolution are taken from the cache. COMPUTE_MIDPOINT places vertices at cell
+                midpoints, other types solve the QEF. Face type and singular value threshold of this 
+                instance apply, adaptive simplification is not applied. Statistics report no evaluations.
+            */
+            IndexedSurface computeFromHermiteData(const HermiteCache &cache, EComputeType et = COMPUTE_NONLINEAR_DC);
         
         private:
             Vector _lower, _upper, _resolution;
             Scalar _iso;
+            ERootFinder _rootFinder;
+            Scalar _rootTolerance;
+            EFaceType _faceType;
+            Scalar _simplifyError;
+            int _chunkSize;
+            bool _periodic;
+            Scalar _svdThreshold;
+            bool _locality;
+            bool _pruneIntervals;
+            Statistics _stats;
         };
 
     }
@@ -0,0 +1,97 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_HERMITE_CACHE
+#define VOLPLAY_HERMITE_CACHE
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+#include <volplay/util/mapped_file.h>
+#include <string>
+#include <vector>
+
+namespace volplay {
+
+    namespace surface {
+
+        /**
+            Hermite data sampled by dual contouring, stored in a binary file.
+
+            Holds the intersection point and normal of each grid edge crossed by the surface, 
+            and the set of voxels that carry vertices. These are all inputs to vertex placement 
+            and face generation, so a surface can be rebuilt from the cache without evaluating 
+            the scene again. See DualContouring::saveHermiteData and DualContouring::computeFromHermiteData.
+
+            The file consists of a fixed size header followed by the edge and voxel records as
+            they are laid out in memory, in native byte order. The file is memory mapped when
+            opened and records are accessed in place.
+        */
+        class HermiteCache {
+        public:
+            /** Grid edge crossed by the surface. */
+            struct Edge {
+                /** Grid coordinates of the first corner of the edge. */
+                Index::Scalar corner[3];
+                /** Intersection point in world coordinates. */
+                Scalar p[3];
+                /** Surface normal at intersection. */
+                Scalar n[3];
+                /** Axis of the edge, the second corner is one voxel further along it. */
+                unsigned char axis;
+                /** Whether the first corner is outside and the dual quad needs to be flipped. */
+                unsigned char flip;
+                unsigned char reserved[2];
+            };
+
+            /** Empty initializer. */
+            HermiteCache();
+
+            /** Open cache file. */
+            bool open(const std::string &filename);
+
+            /** Write cache file. */
+            static bool write(
+                const std::string &filename, 
+                const Vector &lower, const Vector &upper, const Vector &resolution, 
+                const std::vector<Edge> &edges, 
+                const std::vector<Index> &voxels);
+
+            /** Lower bounds of the sampled volume. */
+            const Vector &lowerBounds() const;
+
+            /** Upper bounds of the sampled volume. */
+            const Vector &upperBounds() const;
+
+            /** Resolution of the sampled grid. */
+            const Vector &resolution() const;
+
+            /** Number of edges crossed by the surface. */
+            int edgeCount() const;
+
+            /** Access edge. */
+            const Edge &edge(int i) const;
+
+            /** Number of voxels carrying a vertex. */
+            int voxelCount() const;
+
+            /** Access voxel. */
+            Index voxel(int i) const;
+
+        private:
+            util::MappedFile _file;
+            Vector _lower, _upper, _resolution;
+            const Edge *_edges;
+            const Index::Scalar *_voxels;
+            int _edgeCount, _voxelCount;
+        };
+
+    }
+}
+
+#endif
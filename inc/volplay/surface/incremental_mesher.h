@@ -0,0 +1,97 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_INCREMENTAL_MESHER
+#define VOLPLAY_INCREMENTAL_MESHER
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+#include <volplay/surface/dual_contouring.h>
+#include <volplay/surface/block_grid.h>
+#include <volplay/surface/indexed_surface.h>
+#include <volplay/surface/mesh_chunk.h>
+#include <vector>
+
+namespace volplay {
+
+    namespace surface {
+
+        /**
+            Dual contouring that re-extracts only the regions of a scene that changed.
+
+            The grid of the extractor is partitioned into blocks. The vertices and faces of every
+            block are kept between runs. After a scene edit, the regions affected are marked
+            dirty and only blocks owning corners, edges or voxels within a dirty region are
+            extracted again. Faces reference vertices of neighboring blocks by voxel, so the blocks 
+            referencing an extracted block resolve their faces again as well.
+
+            Every block provides a self-contained surface, see blockSurface, allowing consumers to 
+            replace only the meshes of changed blocks. The surface of the whole grid is assembled 
+            on demand.
+        */
+        class IncrementalMesher {
+        public:
+            /** Create mesher using a copy of the configured extractor. Its bounds must not change afterwards. */
+            IncrementalMesher(const DualContouring &dc, int blockSize = 16, DualContouring::EComputeType et = DualContouring::COMPUTE_NONLINEAR_DC);
+
+            /** Extract all blocks. Returns the blocks whose surfaces were rebuilt, i.e. all of them. */
+            const std::vector<int> &compute(SDFNodePtr scene);
+
+            /**
+                Mark a region of the world as changed. For moved nodes, mark both the old and the new
+                bounds. Regions accumulate until the next update.
+            */
+            void markDirty(const Vector &lower, const Vector &upper);
+
+            /** 
+                Extract dirty blocks. Returns the blocks whose surfaces were rebuilt, which are the extracted
+                blocks and the blocks referencing their vertices. Cost is proportional to these blocks.
+            */
+            const std::vector<int> &update(SDFNodePtr scene);
+
+            /** 
+                Surface of block b as of last compute or update. Faces are triangles. Vertices of neighboring 
+                blocks referenced by its faces are copied into it, so those appear in multiple block surfaces.
+            */
+            const IndexedSurface &blockSurface(int b) const;
+
+            /** 
+                Surface of all blocks as of last compute or update. Faces are triangles. Assembled on first 
+                access after a change, which takes time proportional to the whole surface.
+            */
+            const IndexedSurface &surface() const;
+
+            /** Number of blocks extracted by last compute or update. */
+            int extractedBlocks() const;
+
+            /** Number of blocks. */
+            int blockCount() const;
+
+        private:
+            bool resolveQuad(const MeshChunk &m, size_t i, int *owners, int *locals) const;
+            void resolveBlock(int b);
+            void assemble() const;
+
+            DualContouring _dc;
+            DualContouring::EComputeType _computeType;
+            BlockGrid _grid;
+            AffineTransform _toGrid;
+            std::vector<MeshChunk> _blocks;
+            std::vector<IndexedSurface> _blockSurfaces;
+            std::vector<char> _dirty;
+            std::vector<int> _changed;
+            mutable IndexedSurface _surface;
+            mutable bool _assembled;
+            int _extracted;
+        };
+
+    }
+}
+
+#endif
@@ -17,13 +17,50 @@ namespace volplay {
 
     namespace surface {
 
-        /** Surface defined by vertices and faces that index vertices. */
+        /** 
+            Surface defined by vertices and faces that index vertices. 
+
+            Faces are stored column-wise using 32 bit indices. The number of rows corresponds to 
+            the number of vertices per face, which is either three for triangles or four for quads.
+        */
         struct IndexedSurface {
             typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> VertexMatrix;
-            typedef Eigen::Matrix<Index::Index, Eigen::Dynamic, Eigen::Dynamic> FaceMatrix;
+            typedef Eigen::Matrix<Index::Scalar, Eigen::Dynamic, Eigen::Dynamic> FaceMatrix;
+
+            /** Triangle faces with the number of rows fixed at compile time. */
+            typedef Eigen::Matrix<Index::Scalar, 3, Eigen::Dynamic> TriangleMatrix;
+
+            /** Quad faces with the number of rows fixed at compile time. */
+            typedef Eigen::Matrix<Index::Scalar, 4, Eigen::Dynamic> QuadMatrix;
 
             VertexMatrix vertices;
             FaceMatrix faces;            
+
+            /** Number of bytes held by the surface, including the storage of all matrices. */
+            size_t bytes() const
+            {
+                return sizeof(IndexedSurface) +
+                    size_t(vertices.size()) * sizeof(VertexMatrix::Scalar) +
+                    size_t(faces.size()) * sizeof(FaceMatrix::Scalar);
+            }
+
+            /** Access faces as triangles. Quads are split along their 0-2 diagonal. */
+            TriangleMatrix triangles() const
+            {
+                if (faces.rows() == 3)
+                    return faces;
+
+                TriangleMatrix t(3, faces.cols() * 2);
+                if (faces.rows() == 4) {
+                    for (FaceMatrix::Index i = 0; i < faces.cols(); ++i) {
+                        t.col(i * 2 + 0) << faces(0, i), faces(1, i), faces(2, i);
+                        t.col(i * 2 + 1) << faces(0, i), faces(2, i), faces(3, i);
+                    }
+                } else {
+                    t.resize(3, 0);
+                }
+                return t;
+            }
         };
 
     }    
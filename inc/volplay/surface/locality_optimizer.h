@@ -0,0 +1,71 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_LOCALITY_OPTIMIZER
+#define VOLPLAY_LOCALITY_OPTIMIZER
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+
+namespace volplay {
+
+    namespace surface {
+
+        /**
+            Reorders vertices and faces of a surface for memory and vertex cache locality.
+
+            Vertices are sorted along a Morton curve over their bounding box, so that vertices
+            close in space are close in memory. Faces are then reordered to reduce the misses of
+            a FIFO post-transform vertex cache as described in
+
+            Sander, Pedro V., Diego Nehab, and Joshua Barczak.
+            "Fast triangle reordering for vertex locality and reduced overdraw."
+            ACM Transactions on Graphics (TOG). Vol. 26. No. 3. ACM, 2007.
+
+            Faces are emitted by fanning around vertices that are still in the cache. When no
+            such vertex is left, the next vertex in Morton order with faces left is used. Positions,
+            face orientation and connectivity are unchanged.
+        */
+        class LocalityOptimizer {
+        public:
+            /** Empty initializer. */
+            LocalityOptimizer();
+
+            /** Set the size of the FIFO vertex cache optimized for. Defaults to 16. */
+            void setCacheSize(int size);
+
+            /** Average cache miss ratio before and after the last call to apply. */
+            struct Statistics {
+                Scalar acmrBefore;
+                Scalar acmrAfter;
+
+                Statistics();
+            };
+
+            /** Access statistics of last call to apply. */
+            const Statistics &statistics() const;
+
+            /** Reorder vertices and faces of surface. Works for triangles and quads. */
+            void apply(IndexedSurface &surface);
+
+            /** 
+                Average cache miss ratio, the number of vertex cache misses per triangle when 
+                rendering faces in order using a FIFO cache of given size. Quads count as two triangles.
+            */
+            static Scalar averageCacheMissRatio(const IndexedSurface &surface, int cacheSize);
+
+        private:
+            int _cacheSize;
+            Statistics _stats;
+        };
+
+    }
+}
+
+#endif
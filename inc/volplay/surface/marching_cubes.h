@@ -0,0 +1,73 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_MARCHING_CUBES
+#define VOLPLAY_MARCHING_CUBES
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+
+namespace volplay {
+
+    namespace surface {
+
+        /** 
+            Surface extraction using Marching Cubes.
+
+            Table driven variant based on the work of
+
+            Lorensen, William E., and Harvey E. Cline. 
+            "Marching cubes: A high resolution 3D surface construction algorithm." 
+            ACM Siggraph Computer Graphics. Vol. 21. No. 4. ACM, 1987.
+
+            Vertices are placed on grid edges by linear interpolation, no gradients are
+            evaluated. Ambiguous cube faces are resolved by separating inside corners, which
+            keeps the mesh free of cracks. The grid is processed in blocks in parallel and 
+            vertices on edges shared by blocks are generated once.
+        */
+        class MarchingCubes {
+        public:
+            /** Empty initializer. */
+            MarchingCubes();
+
+            /** Set the lower bound of the volume to be reconstructed. */
+            void setLowerBounds(const Vector &lower);
+
+            /** Set the lower bound of the volume to be reconstructed. */
+            void setUpperBounds(const Vector &upper);
+
+            /** Set the resolution of the uniform grid. */
+            void setResolution(const Vector &resolution);
+
+            /** Set the iso value at which to contour. Defaults to zero. */
+            void setIsoLevel(Scalar iso);
+
+            /** Set the number of voxels per dimension of blocks processed in parallel. Defaults to 16. */
+            void setBlockSize(int voxels);
+
+            /** 
+                Skip blocks whose center is farther away from the surface than the block extent. Defaults to true.
+                Disable for scenes that may overestimate distances, such as strong displacements.
+            */
+            void setSkipEmptyBlocks(bool enable);
+
+            /** Extract the surface. */
+            IndexedSurface compute(SDFNodePtr scene);
+
+        private:
+            Vector _lower, _upper, _resolution;
+            Scalar _iso;
+            int _blockSize;
+            bool _skipEmptyBlocks;
+        };
+
+    }
+}
+
+#endif
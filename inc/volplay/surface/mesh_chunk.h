@@ -0,0 +1,106 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_MESH_CHUNK
+#define VOLPLAY_MESH_CHUNK
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+#include <string>
+#include <vector>
+
+namespace volplay {
+
+    namespace surface {
+
+        /**
+            Part of a dual surface extracted from a single block of a BlockGrid.
+
+            Vertices are identified by the voxel they were generated in. Each voxel is owned
+            by the block owning its minimum corner, clamped to the grid. Faces reference
+            vertices by voxel, which may be owned by neighboring blocks. These references are
+            the stitching data required to join chunks without matching vertex positions.
+        */
+        struct MeshChunk {
+            /** Voxels of the vertices generated by this chunk, in increasing z, y, x order. */
+            std::vector<Index> voxels;
+            /** Vertices in order of voxels. */
+            std::vector<Vector> vertices;
+            /** Quads, four consecutive voxel references each. */
+            std::vector<Index> quads;
+
+            /** Find index of vertex generated in voxel. Returns -1 if not found. */
+            int find(const Index &voxel) const;
+
+            /** Number of bytes held by the chunk, including the storage of all vectors. */
+            size_t bytes() const
+            {
+                return sizeof(MeshChunk) + 
+                    (voxels.size() + quads.size()) * sizeof(Index) + 
+                    vertices.size() * sizeof(Vector);
+            }
+
+            /** Write chunk in binary format. */
+            bool write(const char *filename) const;
+
+            /** Read chunk. When voxelsOnly is set, vertices and quads are skipped. */
+            bool read(const char *filename, bool voxelsOnly = false);
+        };
+
+        /**
+            Index of the chunks of a surface stored on disk.
+
+            Chunks are stored next to the manifest as files named prefix.<block>.chunk,
+            the manifest itself as prefix.chunks.
+        */
+        struct ChunkManifest {
+            /** Corners of the partitioned grid. */
+            Index lower, upper;
+            /** Voxels per block and dimension. */
+            int blockSize;
+            /** Whether merged faces are quads. */
+            bool quads;
+            /** Vertex count of each chunk. */
+            std::vector<int> vertexCounts;
+            /** Quad count of each chunk. */
+            std::vector<int> quadCounts;
+
+            /** Write manifest for given prefix. */
+            bool write(const std::string &prefix) const;
+
+            /** Read manifest for given prefix. */
+            bool read(const std::string &prefix);
+
+            /** Filename of chunk of block b. */
+            static std::string chunkFilename(const std::string &prefix, int b);
+        };
+
+        /** Less than comparison of voxels in z, y, x order. */
+        struct VoxelOrder {
+            bool operator()(const Index &a, const Index &b) const
+            {
+                if (a.z() != b.z()) return a.z() < b.z();
+                if (a.y() != b.y()) return a.y() < b.y();
+                return a.x() < b.x();
+            }
+        };
+
+        /**
+            Merge chunks into a single .OFF file.
+
+            Vertices and faces are streamed chunk by chunk. Only the voxel lists of blocks referenced
+            by the current chunk are held in memory, so memory is bounded by a few chunks regardless
+            of the size of the surface.
+        */
+        bool mergeChunks(const std::string &prefix, const char *filename);
+
+    }
+}
+
+#endif
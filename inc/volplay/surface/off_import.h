@@ -0,0 +1,38 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_OFF_IMPORT
+#define VOLPLAY_OFF_IMPORT
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+
+namespace volplay {
+
+    namespace surface {
+
+        /** 
+            Import surfaces in .OFF file format.
+
+            Polygons with more than three vertices are split into triangle fans, so the
+            surface returned always consists of triangles. Vertex colors are ignored.
+        */
+        class OFFImport {
+        public:
+            /** Empty initializer. */
+            OFFImport();
+        
+            /** Import Surface */
+            bool importSurface(const char *filename, IndexedSurface &s) const;
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,65 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_QUADRIC_DECIMATION
+#define VOLPLAY_QUADRIC_DECIMATION
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+
+namespace volplay {
+
+    namespace surface {
+
+        /**
+            Mesh simplification by quadric error edge collapses.
+
+            Based on the work of
+
+            Garland, Michael, and Paul S. Heckbert.
+            "Surface simplification using quadric error metrics."
+            Proceedings of SIGGRAPH 97. ACM, 1997.
+
+            Each vertex carries the QEF of the planes of its incident faces. Collapsing an edge
+            merges the QEFs of its vertices and places the remaining vertex at the minimizer.
+            Decimation proceeds in rounds. Each round evaluates the cost of all edges in parallel
+            and then collapses the cheapest edges that do not share a neighborhood. Collapses that
+            would flip faces or break the manifold property are rejected. Vertices on boundary or
+            non-manifold edges are kept fixed.
+        */
+        class QuadricDecimation {
+        public:
+            /** Empty initializer. */
+            QuadricDecimation();
+
+            /** Set the number of triangles to reduce to. Zero disables the face budget. Defaults to zero. */
+            void setTargetFaceCount(size_t count);
+
+            /** Set the maximum quadric error, the sum of squared distances to the original planes, of a collapse. Defaults to infinity. */
+            void setMaxError(Scalar err);
+
+            /** 
+                Set the threshold below which singular values of merged QEFs are truncated when placing vertices
+                of collapsed edges. Larger values move vertices towards the mass point of their planes. Defaults to 0.1.
+            */
+            void setSingularValueThreshold(Scalar threshold);
+
+            /** Simplify surface. Quads are triangulated first. The result consists of triangles only. */
+            IndexedSurface compute(const IndexedSurface &surface) const;
+
+        private:
+            size_t _targetFaces;
+            Scalar _maxError;
+            Scalar _svdThreshold;
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,73 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_SURFACE_NETS
+#define VOLPLAY_SURFACE_NETS
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+
+namespace volplay {
+
+    namespace surface {
+
+        /** 
+            Surface extraction using naive Surface Nets.
+
+            Based on the work of
+
+            Gibson, Sarah FF. "Constrained elastic surface nets: Generating smooth 
+            surfaces from binary segmented data." Medical Image Computing and 
+            Computer-Assisted Intervention (MICCAI). Springer, 1998.
+
+            Like Dual Contouring a single vertex is placed in each voxel crossed by the surface
+            and a quad is generated for each crossing edge. The vertex is placed at the mean of 
+            the linearly interpolated edge crossings instead of solving a QEF, so no gradients
+            are evaluated. The grid is processed in blocks in parallel.
+        */
+        class SurfaceNets {
+        public:
+            /** Empty initializer. */
+            SurfaceNets();
+
+            /** Set the lower bound of the volume to be reconstructed. */
+            void setLowerBounds(const Vector &lower);
+
+            /** Set the lower bound of the volume to be reconstructed. */
+            void setUpperBounds(const Vector &upper);
+
+            /** Set the resolution of the uniform grid. */
+            void setResolution(const Vector &resolution);
+
+            /** Set the iso value at which to contour. Defaults to zero. */
+            void setIsoLevel(Scalar iso);
+
+            /** Set the number of voxels per dimension of blocks processed in parallel. Defaults to 16. */
+            void setBlockSize(int voxels);
+
+            /** 
+                Skip blocks whose center is farther away from the surface than the block extent. Defaults to true.
+                Disable for scenes that may overestimate distances, such as strong displacements.
+            */
+            void setSkipEmptyBlocks(bool enable);
+
+            /** Extract the surface. */
+            IndexedSurface compute(SDFNodePtr scene);
+
+        private:
+            Vector _lower, _upper, _resolution;
+            Scalar _iso;
+            int _blockSize;
+            bool _skipEmptyBlocks;
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,112 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_TSDF_VOLUME
+#define VOLPLAY_TSDF_VOLUME
+
+#include <volplay/types.h>
+#include <volplay/fwd.h>
+#include <volplay/sdf_node.h>
+#include <volplay/util/voxel_grid.h>
+#include <algorithm>
+#include <deque>
+
+namespace volplay {
+
+    /**
+        A truncated signed distance volume fused from depth images.
+
+        Depth images are integrated as described by Newcombe et al. in "KinectFusion: Real-time
+        dense surface mapping and tracking", 2011. Each voxel stores the projective distance to
+        the observed surface, truncated and normalized, as a running weighted average.
+
+        Voxels are allocated in blocks of 8x8x8 only along the truncation band of observed
+        surfaces and located through a hash map from block coordinates, following Niessner et
+        al. "Real-time 3D reconstruction at scale using voxel hashing", 2013. Fusion updates all
+        allocated blocks within the view frustum. Allocation and fusion are parallelized over
+        image rows and blocks respectively.
+
+        Voxels are centered at integer multiples of the voxel size. Evaluation interpolates
+        trilinearly between observed voxels and returns the truncation distance where none of
+        the voxels involved is observed, so the volume can be rendered and meshed as any other
+        node. Voxels farther than the truncation distance behind observed surfaces are never
+        updated, so meshing generates an additional shell where they meet observed voxels.
+    */
+    class TSDFVolume : public SDFNode {
+    public:
+        /** Create an empty volume. */
+        TSDFVolume(Scalar voxelSize = Scalar(0.01), Scalar truncation = Scalar(0.04));
+
+        /** Set the upper limit of voxel weights. Lower limits adapt faster to changes. */
+        void setMaxWeight(Scalar w);
+
+        /**
+            Integrate a depth image as generated by DepthImageGenerator, storing the distance
+            along the optical axis per pixel. Pixels of invalid depth are skipped.
+        */
+        void integrate(const rendering::ScalarImage &depth, const rendering::Camera &cam, Scalar invalidDepth = Scalar(0));
+
+        /** Side length of voxels. */
+        Scalar voxelSize() const;
+
+        /** Truncation distance. */
+        Scalar truncation() const;
+
+        /** Number of allocated blocks. */
+        int blockCount() const;
+
+        /** Bounds of allocated voxels. Returns false if no voxel is allocated. */
+        bool bounds(Vector &lower, Vector &upper) const;
+
+        /** Evaluate the SDF at given position. */
+        virtual SDFResult fullEval(const Vector &x) const;
+
+        /** Bound the SDF over the given box by the truncation distance. */
+        virtual math::Interval evalInterval(const AlignedBox &box) const;
+
+        /**
+            Trace ray. Fused distances are projective and may overestimate Euclidean distances,
+            so steps may overshoot the surface. Sign changes are detected instead and refined by
+            linear interpolation as in KinectFusion.
+        */
+        virtual Scalar trace(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr = 0) const;
+
+		/* Accept a node visitor. */
+		virtual void accept(SDFNodeVisitor &nv);
+
+    private:
+        enum { BlockSize = 8, BlockVoxels = BlockSize * BlockSize * BlockSize };
+
+        /** Voxels of a block, x varying fastest. */
+        struct Block {
+            /** Unobserved block: free space with zero weight. */
+            explicit Block(const Index &coords_)
+                : coords(coords_)
+            {
+                std::fill(tsdf, tsdf + BlockVoxels, 1.f);
+                std::fill(weight, weight + BlockVoxels, 0.f);
+            }
+
+            Index coords;
+            float tsdf[BlockVoxels];
+            float weight[BlockVoxels];
+        };
+
+        const Block *findBlock(const Index &blockCoords) const;
+
+        Scalar _voxelSize;
+        Scalar _truncation;
+        Scalar _maxWeight;
+        std::deque<Block> _blocks;
+        util::voxelgrid::SparseMap<util::voxelgrid::VoxelPacker, int> _blockIndex;
+    };
+
+}
+
+#endif
@@ -38,6 +38,9 @@ namespace volplay {
     /** Affine transform in three dimensions. */
     typedef Eigen::Transform<Scalar, 3, Eigen::AffineCompact> AffineTransform;    
 
+    /** Axis aligned box in three dimensions. */
+    typedef Eigen::AlignedBox<Scalar, 3> AlignedBox;
+
     /** Function prototype for scalar-valued functions acting on 3D points. */
     typedef std::function<Scalar(const Vector&)> ScalarFnc;
 }
@@ -0,0 +1,58 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_UTIL_BOUNDING_VOLUME_HIERARCHY
+#define VOLPLAY_UTIL_BOUNDING_VOLUME_HIERARCHY
+
+#include <volplay/types.h>
+#include <vector>
+
+namespace volplay {
+    namespace util {
+
+        /**
+            Hierarchy of axis aligned boxes over primitives given by their bounds.
+
+            Primitives are split at the median of their centers along the longest axis of the
+            center bounds, so the depth is logarithmic in the number of primitives. Nodes are 
+            stored depth first. Queries traverse nodes themselves, as the distance measures of 
+            primitives differ.
+        */
+        class BoundingVolumeHierarchy {
+        public:
+            /** Node of the hierarchy. Interior nodes have their left child following them. */
+            struct Node {
+                explicit Node(const AlignedBox &box)
+                    : lower(box.min()), upper(box.max()), first(0), count(0)
+                {}
+
+                Vector lower, upper;
+                int first;  // first primitive of leafs or right child of interior nodes
+                int count;  // number of primitives of leafs or zero for interior nodes
+            };
+
+            /** 
+                Build the hierarchy over the given primitives, which index bounds. Primitives are
+                reordered such that leafs refer to consecutive ranges of them.
+            */
+            void build(const std::vector<AlignedBox> &bounds, std::vector<int> &primitives, int leafSize);
+
+            /** Nodes with the root first. Empty if built without primitives. */
+            const std::vector<Node> &nodes() const;
+
+        private:
+            int build(int begin, int end, const std::vector<AlignedBox> &bounds, std::vector<int> &primitives, int leafSize);
+
+            std::vector<Node> _nodes;
+        };
+
+    }
+}
+
+#endif
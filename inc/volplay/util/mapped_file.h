@@ -0,0 +1,63 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_UTIL_MAPPED_FILE
+#define VOLPLAY_UTIL_MAPPED_FILE
+
+#include <string>
+#include <vector>
+#include <stddef.h>
+
+namespace volplay {
+    namespace util {
+
+        /**
+            Read-only view of the contents of a file.
+
+            On POSIX systems the file is memory mapped, so pages are loaded on first access
+            and shared between processes. Elsewhere the file is read into memory.
+        */
+        class MappedFile {
+        public:
+            /** Empty initializer. */
+            MappedFile();
+
+            /** Unmaps the file. */
+            ~MappedFile();
+
+            /** Open file. Any previously opened file is closed. */
+            bool open(const std::string &filename);
+
+            /** Close file. Pointers returned by data become invalid. */
+            void close();
+
+            /** Test if a file is open. */
+            bool isOpen() const;
+
+            /** Contents of the file. */
+            const char *data() const;
+
+            /** Size of the file in bytes. */
+            size_t size() const;
+
+        private:
+            MappedFile(const MappedFile &other);
+            MappedFile &operator=(const MappedFile &other);
+
+            const char *_data;
+            size_t _size;
+            bool _open;
+            bool _mapped;
+            std::vector<char> _buffer;
+        };
+
+    }
+}
+
+#endif
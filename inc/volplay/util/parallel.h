@@ -0,0 +1,67 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_UTIL_PARALLEL
+#define VOLPLAY_UTIL_PARALLEL
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+namespace volplay {
+    namespace util {
+
+        /** Number of threads used by parallel algorithms by default. */
+        inline int defaultThreadCount()
+        {
+            const unsigned n = std::thread::hardware_concurrency();
+            return n > 0 ? int(n) : 1;
+        }
+
+        /**
+            Invoke function for each index in [begin, end) using multiple threads.
+
+            The range is split into contiguous chunks, one per thread. The function
+            must be safe to be called concurrently for different indices.
+        */
+        template<class Function>
+        void parallelFor(int begin, int end, Function fnc, int nThreads = defaultThreadCount())
+        {
+            const int n = end - begin;
+            if (n <= 0)
+                return;
+
+            nThreads = std::max<int>(1, std::min<int>(nThreads, n));
+            if (nThreads == 1) {
+                for (int i = begin; i < end; ++i)
+                    fnc(i);
+                return;
+            }
+
+            const int chunk = (n + nThreads - 1) / nThreads;
+            std::vector<std::thread> threads;
+            for (int t = 0; t < nThreads; ++t) {
+                const int first = begin + t * chunk;
+                const int last = std::min<int>(end, first + chunk);
+                if (first >= last)
+                    break;
+                threads.push_back(std::thread([first, last, &fnc]() {
+                    for (int i = first; i < last; ++i)
+                        fnc(i);
+                }));
+            }
+
+            for (size_t t = 0; t < threads.size(); ++t)
+                threads[t].join();
+        }
+
+    }
+}
+
+#endif
@@ -16,6 +16,9 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
+#include <iterator>
+#include <stdint.h>
+#include <cassert>
 
 namespace volplay {
     namespace util {
@@ -29,11 +32,200 @@ namespace volplay {
             /** A voxel edge is represented by a ordered pair of voxels. */
             typedef std::pair<Voxel, Voxel> VoxelEdge;
 
-            /** Base class for sparse properties. */
-            template<class Key, class Value, class Hasher, class Equal>
+            /** 
+                A voxel packed into a 64 bit integer. 
+                
+                Each coordinate is biased and stored in 20 bits, x in the lowest bits. This covers 
+                coordinates in [-2^19, 2^19). Keys are cheap to hash and compare.
+            */
+            typedef uint64_t VoxelKey;
+
+            /** 
+                A voxel edge packed into a 64 bit integer. 
+                
+                Edges must connect neighboring voxels. The key stores the packed minimum corner 
+                in the lower 60 bits, followed by two bits for the axis and one bit for the 
+                direction, which is set when the edge runs from the maximum to the minimum corner.
+                Keys take a third of the memory of a VoxelEdge.
+            */
+            typedef uint64_t VoxelEdgeKey;
+
+            /** Number of bits per coordinate of packed keys. */
+            const int voxelKeyBits = 20;
+
+            /** Test if voxel coordinates lie within the range covered by packed keys. */
+            inline bool isPackable(const Voxel &v)
+            {
+                const Voxel::Scalar bias = Voxel::Scalar(1) << (voxelKeyBits - 1);
+                return (v.array() >= -bias).all() && (v.array() < bias).all();
+            }
+
+            /** Pack voxel into key. Coordinates outside the packable range are not representable. */
+            inline VoxelKey packVoxel(const Voxel &v)
+            {
+                assert(isPackable(v));
+                const uint64_t bias = uint64_t(1) << (voxelKeyBits - 1);
+                const uint64_t mask = (uint64_t(1) << voxelKeyBits) - 1;
+                return 
+                    ((uint64_t(v.x()) + bias) & mask) |
+                    (((uint64_t(v.y()) + bias) & mask) << voxelKeyBits) |
+                    (((uint64_t(v.z()) + bias) & mask) << (2 * voxelKeyBits));
+            }
+
+            /** Unpack voxel from key. */
+            inline Voxel unpackVoxel(VoxelKey k)
+            {
+                const Voxel::Scalar bias = Voxel::Scalar(1) << (voxelKeyBits - 1);
+                const uint64_t mask = (uint64_t(1) << voxelKeyBits) - 1;
+                return Voxel(
+                    Voxel::Scalar(k & mask) - bias,
+                    Voxel::Scalar((k >> voxelKeyBits) & mask) - bias,
+                    Voxel::Scalar((k >> (2 * voxelKeyBits)) & mask) - bias);
+            }
+
+            /** Pack edge into key. */
+            inline VoxelEdgeKey packEdge(const VoxelEdge &e)
+            {
+                const Voxel d = e.second - e.first;
+                const uint64_t axis = d.x() != 0 ? 0 : (d.y() != 0 ? 1 : 2);
+                const uint64_t reversed = d(int(axis)) < 0 ? 1 : 0;
+                return 
+                    packVoxel(reversed ? e.second : e.first) | 
+                    (axis << (3 * voxelKeyBits)) | 
+                    (reversed << (3 * voxelKeyBits + 2));
+            }
+
+            /** Unpack edge from key. */
+            inline VoxelEdge unpackEdge(VoxelEdgeKey k)
+            {
+                const Voxel a = unpackVoxel(k & ((uint64_t(1) << (3 * voxelKeyBits)) - 1));
+                const Voxel b = a + Voxel::Unit(int((k >> (3 * voxelKeyBits)) & 3));
+                return ((k >> (3 * voxelKeyBits + 2)) & 1) ? VoxelEdge(b, a) : VoxelEdge(a, b);
+            }
+
+            /** Hasher for packed keys. Mixes all bits, as coordinates occupy separate bit ranges. */
+            struct HashKey {
+                inline size_t operator()(uint64_t k) const
+                {
+                    k ^= k >> 31;
+                    k *= 0x7fb5d329728ea185ULL;
+                    k ^= k >> 27;
+                    k *= 0x81dadef4bc2dd44dULL;
+                    k ^= k >> 33;
+                    return size_t(k);
+                }
+            };
+
+            /** Conversion between voxels and packed keys. */
+            struct VoxelPacker {
+                typedef Voxel Key;
+                static VoxelKey pack(const Voxel &v) { return packVoxel(v); }
+                static Voxel unpack(VoxelKey k) { return unpackVoxel(k); }
+            };
+
+            /** Conversion between voxel edges and packed keys. */
+            struct VoxelEdgePacker {
+                typedef VoxelEdge Key;
+                static VoxelEdgeKey pack(const VoxelEdge &e) { return packEdge(e); }
+                static VoxelEdge unpack(VoxelEdgeKey k) { return unpackEdge(k); }
+            };
+
+            /** 
+                Forward iterator over a hash map of packed keys. Keys are unpacked on access, 
+                elements are accessed as pairs of key and reference to value. As keys are
+                temporaries, copy them rather than binding references to them.
+            */
+            template<class BaseIterator, class Packer, class Value>
+            class UnpackingMapIterator {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef std::pair<const typename Packer::Key, Value&> value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef value_type reference;
+
+                /** Holds the element returned by operator-> */
+                struct pointer {
+                    value_type element;
+                    const value_type *operator->() const { return &element; }
+                };
+
+                UnpackingMapIterator()
+                {}
+
+                UnpackingMapIterator(BaseIterator iter)
+                    : _iter(iter)
+                {}
+
+                /** Conversion from mutable to const iterators. */
+                template<class OtherIterator, class OtherValue>
+                UnpackingMapIterator(const UnpackingMapIterator<OtherIterator, Packer, OtherValue> &other)
+                    : _iter(other.base())
+                {}
+
+                reference operator*() const { return reference(Packer::unpack(_iter->first), _iter->second); }
+                pointer operator->() const { pointer p = {**this}; return p; }
+                UnpackingMapIterator &operator++() { ++_iter; return *this; }
+                UnpackingMapIterator operator++(int) { UnpackingMapIterator i(*this); ++_iter; return i; }
+                bool operator==(const UnpackingMapIterator &other) const { return _iter == other._iter; }
+                bool operator!=(const UnpackingMapIterator &other) const { return _iter != other._iter; }
+
+                /** Packed key of current element. */
+                uint64_t key() const { return _iter->first; }
+
+                /** Access underlying iterator. */
+                const BaseIterator &base() const { return _iter; }
+
+            private:
+                BaseIterator _iter;
+            };
+
+            /** Forward iterator over a hash set of packed keys. Keys are unpacked on access. */
+            template<class BaseIterator, class Packer>
+            class UnpackingSetIterator {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef typename Packer::Key value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef value_type reference;
+
+                /** Holds the element returned by operator-> */
+                struct pointer {
+                    value_type element;
+                    const value_type *operator->() const { return &element; }
+                };
+
+                UnpackingSetIterator()
+                {}
+
+                UnpackingSetIterator(BaseIterator iter)
+                    : _iter(iter)
+                {}
+
+                reference operator*() const { return Packer::unpack(*_iter); }
+                pointer operator->() const { pointer p = {**this}; return p; }
+                UnpackingSetIterator &operator++() { ++_iter; return *this; }
+                UnpackingSetIterator operator++(int) { UnpackingSetIterator i(*this); ++_iter; return i; }
+                bool operator==(const UnpackingSetIterator &other) const { return _iter == other._iter; }
+                bool operator!=(const UnpackingSetIterator &other) const { return _iter != other._iter; }
+
+                /** Packed key of current element. */
+                uint64_t key() const { return *_iter; }
+
+            private:
+                BaseIterator _iter;
+            };
+
+            /** 
+                Base class for sparse properties. Keys are stored packed using Packer. 
+                Iterators unpack keys on access.
+            */
+            template<class Packer, class Value>
             class SparseMap {
             public:
-                typedef std::unordered_map<Key, Value, Hasher, Equal> HashMap;
+                typedef typename Packer::Key Key;
+                typedef std::unordered_map<uint64_t, Value, HashKey> HashMap;
+                typedef UnpackingMapIterator<typename HashMap::iterator, Packer, Value> iterator;
+                typedef UnpackingMapIterator<typename HashMap::const_iterator, Packer, const Value> const_iterator;
 
                 /** Create with default value that is returned when property value is not set. */
                 SparseMap(const Value &defaultValue = Value())
@@ -42,6 +234,12 @@ namespace volplay {
 
 				/** Access element. If the element at key does not exist, it is created with default value passed at construction. */
                 Value &operator[](const Key &key)
+                {
+                    return at(Packer::pack(key));
+                }
+
+                /** Access element by packed key. If the element does not exist, it is created with default value passed at construction. */
+                Value &at(uint64_t key)
                 {
                     // This will not overwrite values if key is already present.
                     return _props.insert(std::make_pair(key, _defaultValue)).first->second;
@@ -50,31 +248,45 @@ namespace volplay {
 				/** Test if key is already in map. */
                 bool isSet(const Key &key) const
                 {
-                    return _props.find(key) != _props.end();
+                    return _props.find(Packer::pack(key)) != _props.end();
+                }
+
+                /** Find element. Returns null if key is not in map. Faster than isSet followed by access. */
+                const Value *find(const Key &key) const
+                {
+                    typename HashMap::const_iterator i = _props.find(Packer::pack(key));
+                    return i != _props.end() ? &i->second : 0;
+                }
+
+                /** Find element. Returns null if key is not in map. Faster than isSet followed by access. */
+                Value *find(const Key &key)
+                {
+                    typename HashMap::iterator i = _props.find(Packer::pack(key));
+                    return i != _props.end() ? &i->second : 0;
                 }
 
 				/** Iterator to beginning of sparse map */
-                typename HashMap::iterator begin()
+                iterator begin()
                 {
-                    return _props.begin();
+                    return iterator(_props.begin());
                 }
 
 				/** Iterator to end of sparse map */
-                typename HashMap::iterator end()
+                iterator end()
                 {
-                    return _props.end();
+                    return iterator(_props.end());
                 }
 
 				/** Iterator to beginning of sparse map */
-                typename HashMap::const_iterator begin() const
+                const_iterator begin() const
                 {
-                    return _props.begin();
+                    return const_iterator(_props.begin());
                 }
 
 				/** Iterator to end of sparse map */
-                typename HashMap::const_iterator end() const
+                const_iterator end() const
                 {
-                    return _props.end();
+                    return const_iterator(_props.end());
                 }
 
 				/** Number of elements in map */
@@ -83,6 +295,12 @@ namespace volplay {
                     return _props.size();
                 }
 
+                /** Reserve space for at least n elements. */
+                void reserve(size_t n)
+                {
+                    _props.reserve(n);
+                }
+
 				/** Reset to empty state */
                 void clear()
                 {
@@ -95,11 +313,13 @@ namespace volplay {
                 Value _defaultValue;
             };
 
-            /** Base class for sparse sets. */
-            template<class Key, class Hasher, class Equal>
+            /** Base class for sparse sets. Keys are stored packed using Packer. */
+            template<class Packer>
             class SparseSet {
             public:
-                typedef std::unordered_set<Key, Hasher, Equal> HashSet;
+                typedef typename Packer::Key Key;
+                typedef std::unordered_set<uint64_t, HashKey> HashSet;
+                typedef UnpackingSetIterator<typename HashSet::const_iterator, Packer> const_iterator;
 
                 SparseSet()
                 {}
@@ -107,25 +327,25 @@ namespace volplay {
 				/** Test if key is present in set */
                 bool isSet(const Key &key) const
                 {
-                    return _set.find(key) != _set.end();
+                    return _set.find(Packer::pack(key)) != _set.end();
                 }
 
 				/** Set key */
                 void set(const Key &key)
                 {
-                    _set.insert(key);
+                    _set.insert(Packer::pack(key));
                 }
 
 				/** Iterator to beginning of sparse map */
-                typename HashSet::const_iterator begin() const
+                const_iterator begin() const
                 {
-                    return _set.begin();
+                    return const_iterator(_set.begin());
                 }
 
 				/** Iterator to end of sparse map */
-                typename HashSet::const_iterator end() const
+                const_iterator end() const
                 {
-                    return _set.end();
+                    return const_iterator(_set.end());
                 }
 
 				/** Number of elements in set */
@@ -134,6 +354,12 @@ namespace volplay {
                     return _set.size();
                 }
 
+                /** Reserve space for at least n elements. */
+                void reserve(size_t n)
+                {
+                    _set.reserve(n);
+                }
+
 				/** Reset to empty state */
                 void clear()
                 {
@@ -153,15 +379,11 @@ namespace volplay {
                 seed ^= std::hash<T>()(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
             }
 
-            /** Hasher for Voxel */
+            /** Hasher for Voxel. Hashes the packed key. */
             struct HashVoxel {
                 inline size_t operator()(const Voxel &v) const
                 {
-                    size_t seed = 0;
-                    hashCombine(seed, v.x());
-                    hashCombine(seed, v.y());
-                    hashCombine(seed, v.z());
-                    return seed;
+                    return HashKey()(packVoxel(v));
                 }
             };
 
@@ -177,31 +399,24 @@ namespace volplay {
 
             /** Sparse property assigned to voxels. */
             template<class Value>
-            class SparseVoxelProperty : public SparseMap<Voxel, Value, HashVoxel, EqualVoxel> 
+            class SparseVoxelProperty : public SparseMap<VoxelPacker, Value> 
             {
             public:
                 SparseVoxelProperty(const Value &defaultValue)
-                    : SparseMap<Voxel, Value, HashVoxel, EqualVoxel>(defaultValue)
+                    : SparseMap<VoxelPacker, Value>(defaultValue)
                 {}
             };
 
             /** Sparse set of voxels. */
-            class SparseVoxelSet : public SparseSet<Voxel, HashVoxel, EqualVoxel> 
+            class SparseVoxelSet : public SparseSet<VoxelPacker> 
             {
             };
 
-            /** Hasher for VoxelEdge */
+            /** Hasher for VoxelEdge. Hashes the packed key. */
             struct HashVoxelEdge {
                 inline size_t operator()(const VoxelEdge &v) const
                 {
-                    size_t seed = 0;
-                    hashCombine(seed, v.first.x());
-                    hashCombine(seed, v.first.y());
-                    hashCombine(seed, v.first.z());
-                    hashCombine(seed, v.second.x());
-                    hashCombine(seed, v.second.y());
-                    hashCombine(seed, v.second.z());
-                    return seed;
+                    return HashKey()(packEdge(v));
                 }
             };
 
@@ -220,16 +435,16 @@ namespace volplay {
 
             /** Sparse map of voxel edges to some associated value. */
             template<class Value>
-            class SparseVoxelEdgeProperty : public SparseMap<VoxelEdge, Value, HashVoxelEdge, EqualVoxelEdge> 
+            class SparseVoxelEdgeProperty : public SparseMap<VoxelEdgePacker, Value> 
             {
             public:
                 SparseVoxelEdgeProperty(const Value &defaultValue = Value())
-                    : SparseMap<VoxelEdge, Value, HashVoxelEdge, EqualVoxelEdge>(defaultValue)
+                    : SparseMap<VoxelEdgePacker, Value>(defaultValue)
                 {}
             };
 
             /** Sparse set of voxel edges. */
-            class SparseVoxelEdgeSet : public SparseSet<VoxelEdge, HashVoxelEdge, EqualVoxelEdge> 
+            class SparseVoxelEdgeSet : public SparseSet<VoxelEdgePacker> 
             {            
             };
 
@@ -13,6 +13,13 @@
 #include <volplay/sdf_sphere.h>
 #include <volplay/sdf_plane.h>
 #include <volplay/sdf_box.h>
+#include <volplay/sdf_volume.h>
+#include <volplay/sdf_mesh.h>
+#include <volplay/sdf_primitive_set.h>
+#include <volplay/sdf_sphere_set.h>
+#include <volplay/sdf_box_set.h>
+#include <volplay/sdf_capsule_set.h>
+#include <volplay/tsdf_volume.h>
 #include <volplay/sdf_union.h>
 #include <volplay/sdf_intersection.h>
 #include <volplay/sdf_difference.h>
@@ -21,6 +28,8 @@
 #include <volplay/sdf_displacement.h>
 #include <volplay/sdf_make.h>
 #include <volplay/sdf_node_visitor.h>
+#include <volplay/sdf_optimizer.h>
+#include <volplay/distance_transform.h>
 
 #include <volplay/rendering/camera.h>
 #include <volplay/rendering/image.h>
@@ -33,7 +42,16 @@
 
 #include <volplay/surface/indexed_surface.h>
 #include <volplay/surface/dual_contouring.h>
+#include <volplay/surface/marching_cubes.h>
+#include <volplay/surface/surface_nets.h>
+#include <volplay/surface/quadric_decimation.h>
 #include <volplay/surface/off_export.h>
+#include <volplay/surface/off_import.h>
+#include <volplay/surface/mesh_chunk.h>
+#include <volplay/surface/chunk_manager.h>
+#include <volplay/surface/incremental_mesher.h>
+#include <volplay/surface/hermite_cache.h>
+#include <volplay/surface/locality_optimizer.h>
 
 
 #endif
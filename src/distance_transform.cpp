@@ -0,0 +1,352 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/distance_transform.h>
+#include <volplay/sdf_node.h>
+#include <volplay/util/parallel.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace volplay {
+
+    /** Number of samples per dimension of top level blocks in narrow band sampling. */
+    static const int bandBlockSize = 16;
+
+    /** Value of unknown samples, carrying their sign. */
+    inline float unknownValue(bool inside)
+    {
+        return inside ? -std::numeric_limits<float>::max() : std::numeric_limits<float>::max();
+    }
+
+    DistanceGrid::DistanceGrid()
+        : dims(Index::Zero()), origin(Vector::Zero()), spacing(Vector::Ones())
+    {}
+
+    DistanceGrid::DistanceGrid(const Index &dims_, const Vector &origin_, const Vector &spacing_)
+        : dims(dims_.cwiseMax(Index::Zero())), origin(origin_), spacing(spacing_)
+    {
+        values.assign(size(), unknownValue(false));
+        known.assign(size(), 0);
+    }
+
+    int DistanceGrid::size() const
+    {
+        return dims.x() * dims.y() * dims.z();
+    }
+
+    int DistanceGrid::index(int x, int y, int z) const
+    {
+        return (z * dims.y() + y) * dims.x() + x;
+    }
+
+    Vector DistanceGrid::position(int x, int y, int z) const
+    {
+        return origin + Vector(Scalar(x), Scalar(y), Scalar(z)).cwiseProduct(spacing);
+    }
+
+    DistanceTransform::DistanceTransform()
+        : _band(0), _maxRounds(8)
+    {}
+
+    void DistanceTransform::setBandWidth(Scalar w)
+    {
+        _band = w;
+    }
+
+    void DistanceTransform::setMaxSweepRounds(int n)
+    {
+        _maxRounds = std::max<int>(1, n);
+    }
+
+    Scalar DistanceTransform::bandWidth(const DistanceGrid &g) const
+    {
+        return _band > Scalar(0) ? _band : Scalar(2) * g.spacing.maxCoeff();
+    }
+
+    /** Sample the block of grid positions [first, last) recursively. Returns the number of evaluations. */
+    static int sampleBlock(const SDFNode &scene, Scalar band, const Index &first, const Index &last, DistanceGrid &g)
+    {
+        const Index size = last - first;
+        if (size.minCoeff() <= 0)
+            return 0;
+
+        if (size.maxCoeff() > 2) {
+            // Samples of the block are within reach of the center plus half the diagonal. If the
+            // surface is farther than that, no sample of the block lies within the band.
+            const Vector lower = g.position(first.x(), first.y(), first.z());
+            const Vector upper = g.position(last.x() - 1, last.y() - 1, last.z() - 1);
+            const Scalar d = scene.eval((lower + upper) * Scalar(0.5));
+
+            if (std::abs(d) - (upper - lower).norm() * Scalar(0.5) > band) {
+                for (int z = first.z(); z < last.z(); ++z)
+                    for (int y = first.y(); y < last.y(); ++y)
+                        for (int x = first.x(); x < last.x(); ++x)
+                            g.values[g.index(x, y, z)] = unknownValue(d < Scalar(0));
+                return 1;
+            }
+
+            const Index mid = first + ((size.array() + 1) / 2).matrix();
+            int n = 1;
+            for (int c = 0; c < 8; ++c) {
+                const Index f((c & 1) ? mid.x() : first.x(), (c & 2) ? mid.y() : first.y(), (c & 4) ? mid.z() : first.z());
+                const Index l((c & 1) ? last.x() : mid.x(), (c & 2) ? last.y() : mid.y(), (c & 4) ? last.z() : mid.z());
+                n += sampleBlock(scene, band, f, l, g);
+            }
+            return n;
+        }
+
+        for (int z = first.z(); z < last.z(); ++z) {
+            for (int y = first.y(); y < last.y(); ++y) {
+                for (int x = first.x(); x < last.x(); ++x) {
+                    const int i = g.index(x, y, z);
+                    const Scalar v = scene.eval(g.position(x, y, z));
+                    const bool inBand = std::abs(v) <= band;
+                    g.values[i] = inBand ? float(v) : unknownValue(v < Scalar(0));
+                    g.known[i] = inBand ? 1 : 0;
+                }
+            }
+        }
+        return size.prod();
+    }
+
+    int DistanceTransform::sampleNarrowBand(SDFNodePtr scene, DistanceGrid &g) const
+    {
+        const Scalar band = bandWidth(g);
+        const Index blocks = ((g.dims.array() + (bandBlockSize - 1)) / bandBlockSize).matrix();
+        std::vector<int> evaluations(blocks.x() * blocks.y() * blocks.z(), 0);
+
+        util::parallelFor(0, int(evaluations.size()), [&](int b) {
+            const Index first = Index(b % blocks.x(), (b / blocks.x()) % blocks.y(), b / (blocks.x() * blocks.y())) * bandBlockSize;
+            const Index last = (first + Index::Constant(bandBlockSize)).cwiseMin(g.dims);
+            evaluations[b] = sampleBlock(*scene, band, first, last, g);
+        });
+
+        int n = 0;
+        for (size_t i = 0; i < evaluations.size(); ++i)
+            n += evaluations[i];
+        return n;
+    }
+
+    void DistanceTransform::sampleOccupancy(const std::vector<char> &inside, DistanceGrid &g) const
+    {
+        util::parallelFor(0, g.dims.z(), [&](int z) {
+            for (int y = 0; y < g.dims.y(); ++y) {
+                for (int x = 0; x < g.dims.x(); ++x) {
+                    const Index p(x, y, z);
+                    const int i = g.index(x, y, z);
+                    const bool in = inside[i] != 0;
+
+                    // The surface passes between samples of different occupancy.
+                    Scalar d = std::numeric_limits<Scalar>::max();
+                    for (int a = 0; a < 3; ++a) {
+                        for (int s = -1; s <= 1; s += 2) {
+                            Index q = p;
+                            q(a) += s;
+                            if (q(a) >= 0 && q(a) < g.dims(a) && (inside[g.index(q.x(), q.y(), q.z())] != 0) != in)
+                                d = std::min<Scalar>(d, g.spacing(a) * Scalar(0.5));
+                        }
+                    }
+
+                    const bool boundary = d < std::numeric_limits<Scalar>::max();
+                    g.values[i] = boundary ? float(in ? -d : d) : unknownValue(in);
+                    g.known[i] = boundary ? 1 : 0;
+                }
+            }
+        });
+    }
+
+    void DistanceTransform::jumpFlood(DistanceGrid &g) const
+    {
+        const int n = g.size();
+        if (n == 0)
+            return;
+
+        // Nearest seed per sample. Seeds are band samples, the distance through a seed is the
+        // distance to the seed plus the distance of the seed to the surface.
+        std::vector<int> src(n), dst(n);
+        for (int i = 0; i < n; ++i)
+            src[i] = g.known[i] ? i : -1;
+
+        const int dx = g.dims.x();
+        const int dxy = g.dims.x() * g.dims.y();
+        auto cost = [&g, dx, dxy](const Vector &p, int s) -> Scalar {
+            const Vector q = g.position(s % dx, (s / dx) % g.dims.y(), s / dxy);
+            return (q - p).norm() + std::abs(g.values[s]);
+        };
+
+        std::vector<int> steps;
+        int step = 1;
+        while (step * 2 < g.dims.maxCoeff())
+            step *= 2;
+        for (; step >= 1; step /= 2)
+            steps.push_back(step);
+        steps.push_back(1);
+
+        for (size_t k = 0; k < steps.size(); ++k) {
+            const int s = steps[k];
+            util::parallelFor(0, g.dims.z(), [&](int z) {
+                for (int y = 0; y < g.dims.y(); ++y) {
+                    for (int x = 0; x < g.dims.x(); ++x) {
+                        const int i = g.index(x, y, z);
+                        const Vector p = g.position(x, y, z);
+
+                        int best = src[i];
+                        Scalar bestCost = best >= 0 ? cost(p, best) : std::numeric_limits<Scalar>::max();
+
+                        for (int oz = z - s; oz <= z + s; oz += s) {
+                            if (oz < 0 || oz >= g.dims.z()) continue;
+                            for (int oy = y - s; oy <= y + s; oy += s) {
+                                if (oy < 0 || oy >= g.dims.y()) continue;
+                                for (int ox = x - s; ox <= x + s; ox += s) {
+                                    if (ox < 0 || ox >= g.dims.x()) continue;
+
+                                    const int seed = src[g.index(ox, oy, oz)];
+                                    if (seed < 0 || seed == best)
+                                        continue;
+
+                                    const Scalar c = cost(p, seed);
+                                    if (c < bestCost) {
+                                        best = seed;
+                                        bestCost = c;
+                                    }
+                                }
+                            }
+                        }
+                        dst[i] = best;
+                    }
+                }
+            });
+            src.swap(dst);
+        }
+
+        util::parallelFor(0, g.dims.z(), [&](int z) {
+            for (int y = 0; y < g.dims.y(); ++y) {
+                for (int x = 0; x < g.dims.x(); ++x) {
+                    const int i = g.index(x, y, z);
+                    if (g.known[i] || src[i] < 0)
+                        continue;
+                    const Scalar c = cost(g.position(x, y, z), src[i]);
+                    g.values[i] = float(g.values[i] < 0 ? -c : c);
+                    g.known[i] = 1;
+                }
+            }
+        });
+    }
+
+    /** Godunov upwind update of a sample from its smallest neighbor per axis. */
+    inline Scalar eikonalUpdate(Scalar a[3], Scalar h[3])
+    {
+        // Sort axes by neighbor distance.
+        for (int i = 0; i < 2; ++i) {
+            for (int j = i + 1; j < 3; ++j) {
+                if (a[j] < a[i]) {
+                    std::swap(a[i], a[j]);
+                    std::swap(h[i], h[j]);
+                }
+            }
+        }
+
+        // Add axes as long as their neighbors are closer than the solution so far.
+        Scalar u = std::numeric_limits<Scalar>::max();
+        Scalar w = 0, wa = 0, waa = 0;
+        for (int k = 0; k < 3 && a[k] < u; ++k) {
+            const Scalar wk = Scalar(1) / (h[k] * h[k]);
+            w += wk;
+            wa += wk * a[k];
+            waa += wk * a[k] * a[k];
+
+            const Scalar disc = wa * wa - w * (waa - Scalar(1));
+            if (disc < Scalar(0))
+                break;
+            u = (wa + std::sqrt(disc)) / w;
+        }
+        return u;
+    }
+
+    /** Gauss-Seidel sweep in one of eight orderings over unknown samples. */
+    static void sweep(const DistanceGrid &g, int ordering, std::vector<float> &u)
+    {
+        const Index d = g.dims;
+        const Index dir((ordering & 1) ? -1 : 1, (ordering & 2) ? -1 : 1, (ordering & 4) ? -1 : 1);
+        const Index begin((dir.x() > 0) ? 0 : d.x() - 1, (dir.y() > 0) ? 0 : d.y() - 1, (dir.z() > 0) ? 0 : d.z() - 1);
+        const Index stride(1, d.x(), d.x() * d.y());
+        const float far = std::numeric_limits<float>::max();
+
+        for (int iz = 0, z = begin.z(); iz < d.z(); ++iz, z += dir.z()) {
+            for (int iy = 0, y = begin.y(); iy < d.y(); ++iy, y += dir.y()) {
+                for (int ix = 0, x = begin.x(); ix < d.x(); ++ix, x += dir.x()) {
+                    const int i = g.index(x, y, z);
+                    if (g.known[i])
+                        continue;
+
+                    const Index p(x, y, z);
+                    Scalar a[3], h[3];
+                    for (int k = 0; k < 3; ++k) {
+                        const float lo = p(k) > 0 ? u[i - stride(k)] : far;
+                        const float hi = p(k) + 1 < d(k) ? u[i + stride(k)] : far;
+                        a[k] = std::min(lo, hi);
+                        h[k] = g.spacing(k);
+                    }
+
+                    const Scalar v = eikonalUpdate(a, h);
+                    if (v < u[i])
+                        u[i] = float(v);
+                }
+            }
+        }
+    }
+
+    int DistanceTransform::fastSweep(DistanceGrid &g) const
+    {
+        const int n = g.size();
+        if (n == 0)
+            return 0;
+
+        std::vector<float> u(n);
+        for (int i = 0; i < n; ++i)
+            u[i] = g.known[i] ? std::abs(g.values[i]) : std::numeric_limits<float>::max();
+
+        const int nCopies = std::min<int>(8, util::defaultThreadCount());
+        const float tolerance = float(g.spacing.minCoeff() * Scalar(1e-5));
+        std::vector< std::vector<float> > copies(nCopies);
+
+        int rounds = 0;
+        bool changed = true;
+        while (changed && rounds < _maxRounds) {
+            ++rounds;
+
+            util::parallelFor(0, nCopies, [&](int t) {
+                copies[t] = u;
+                for (int o = t; o < 8; o += nCopies)
+                    sweep(g, o, copies[t]);
+            }, nCopies);
+
+            changed = false;
+            for (int i = 0; i < n; ++i) {
+                float m = copies[0][i];
+                for (int t = 1; t < nCopies; ++t)
+                    m = std::min(m, copies[t][i]);
+                if (m < u[i] - tolerance)
+                    changed = true;
+                u[i] = m;
+            }
+        }
+
+        for (int i = 0; i < n; ++i) {
+            if (g.known[i] || u[i] == std::numeric_limits<float>::max())
+                continue;
+            g.values[i] = g.values[i] < 0 ? -u[i] : u[i];
+            g.known[i] = 1;
+        }
+
+        return rounds;
+    }
+
+}
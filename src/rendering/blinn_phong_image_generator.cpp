@@ -25,6 +25,7 @@ namespace volplay {
         , _image(new ScalarImage())
         , _defaultMaterial(new Material())
         , _clearColor(Vector::Zero())
+        , _rootLipschitz(1)
         , _gamma(1 / Scalar(2.2))
         , _shadowsEnabled(true)
         , _fxaaEnabled(true)
@@ -40,6 +41,7 @@ namespace volplay {
             _root = r->scene();
             _lights = r->lights();
             _to = r->primaryTraceOptions();
+            _rootLipschitz = _root->lipschitz();
         }
 
         
@@ -140,7 +142,7 @@ namespace volplay {
             Vector eye = -viewDir;
             
             for (size_t i = 0; i < _lights.size(); ++i) {
-                iFinal += illuminateFromLight(p, n, eye, m, _lights[i], sdf.node);
+                iFinal += illuminateFromLight(p, n, eye, m, _lights[i], sdf);
             }
             
             return iFinal;
@@ -148,7 +150,7 @@ namespace volplay {
         
         Vector
         BlinnPhongImageGenerator::illuminateFromLight(const Vector &p, const Vector &n, const Vector &eye,
-                                                      const MaterialPtr &m, const LightPtr &l, const SDFNode *node) const
+                                                      const MaterialPtr &m, const LightPtr &l, const SDFResult &closest) const
         {
             const Vector lp = (l->position() - p);
             const Scalar lpNorm = lp.norm();
@@ -168,7 +170,7 @@ namespace volplay {
             const Scalar attenuation = calculateLightAttenuation(lpNorm, l);
             
             // Shadow factor. Note tracing is done from light to intersection. See function for notes.
-            const Scalar shadow = _shadowsEnabled ? calculateSoftShadow(l->position(), -ldir, 0, lpNorm, l, node) : Scalar(1);
+            const Scalar shadow = _shadowsEnabled ? calculateSoftShadow(l->position(), -ldir, 0, lpNorm, l, closest) : Scalar(1);
             
             return iAmbient + attenuation * shadow * (iDiffuse + iSpecular);
         }
@@ -196,24 +198,44 @@ namespace volplay {
         BlinnPhongImageGenerator::calculateSoftShadow(const Vector &o, const Vector &d,
                                                       Scalar minT, Scalar maxT,
                                                       const LightPtr &l,
-                                                      const SDFNode *node) const
+                                                      const SDFResult &closest) const
         {
             // Note the shadow ray is traced from the light source to the intersection point. This is done to avoid offsetting the
             // ray, so that it can escape from the surface (rather difficult to come up with a single good value).
             // For reference see http://www.iquilezles.org/www/articles/rmshadows/rmshadows.htm
             
+            // Scenes that are not 1-Lipschitz are marched by conservative distances, unless segment 
+            // tracing is enabled, which bounds the rate of change along the ray ahead instead. See 
+            // SDFNode::trace for details.
+            const bool segments = _to.method == SDFNode::SEGMENT_TRACING;
+            const bool scaled = !segments && _rootLipschitz != Scalar(1);
+            
+            // Distances beyond the remaining ray neither darken the penumbra nor stop the ray short of its end.
+            const Scalar boundFact = Scalar(1) / std::min<Scalar>(l->shadowHardness(), Scalar(1));
+            auto evalAt = [&](Scalar t) -> Scalar {
+                const Vector x = o + t * d;
+                if (scaled)
+                    return _root->safeEval(x);
+                if (segments)
+                    return _root->eval(x);
+                return _root->boundedEval(x, _to.sdfThreshold, (maxT - t) * boundFact);
+            };
+            
             Scalar s(1);
             Scalar t = minT;
-            SDFResult r = _root->fullEval(o + t * d);
+            Scalar sdf = evalAt(t);
+            Scalar segment(0);
             
-            while (t < maxT && r.sdf > _to.sdfThreshold) {
-                s = std::min<Scalar>(s, l->shadowHardness() * r.sdf / (maxT - t));
-                t += r.sdf * _to.stepFact;
-                r = _root->fullEval(o + t * d);
+            while (t < maxT && sdf > _to.sdfThreshold) {
+                s = std::min<Scalar>(s, l->shadowHardness() * sdf / (maxT - t));
+                t += segments ? _root->segmentStep(o, d, t, sdf, maxT, _to.stepFact, segment) : sdf * _to.stepFact;
+                sdf = evalAt(t);
             }
             
-            if (t < maxT && r.node != node) {
-                // Hit something, but not the node of the intersection.
+            const SDFResult blocker = t < maxT ? _root->fullEval(o + t * d) : closest;
+            if (blocker.node != closest.node || blocker.element != closest.element) {
+                // Hit something, but not the node of the intersection. Elements of primitive sets
+                // shadow each other.
                 return 0;
             } else {
                 return clamp01(s);
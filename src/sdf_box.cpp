@@ -9,6 +9,9 @@
 
 #include <volplay/sdf_box.h>
 #include <volplay/sdf_node_visitor.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace volplay {
     
@@ -20,15 +23,90 @@ namespace volplay {
     : _hext(halfExt)
     {}
     
+    /** SDF of box given the distances of a point to the box faces along each axis. */
+    inline S boxDistance(const Vector &d)
+    {
+        return std::min<S>(d.maxCoeff(), S(0)) + d.array().max(S(0)).matrix().norm();
+    }
+
     SDFResult
     SDFBox::fullEval(const Vector &x) const
     {        
         Vector d = x.array().abs().matrix() - _hext;
-        S sdf = std::min<S>(d.maxCoeff(), S(0)) + d.array().max(S(0)).matrix().norm();
-        SDFResult r = {this, sdf};
+        SDFResult r = {this, boxDistance(d)};
         return r;
     }
 
+    Scalar
+    SDFBox::boundedEval(const Vector &x, Scalar, Scalar) const
+    {
+        return boxDistance(x.array().abs().matrix() - _hext);
+    }
+
+    math::Interval
+    SDFBox::evalInterval(const AlignedBox &box) const
+    {
+        // The SDF does not decrease with the absolute coordinates of a point, so bounds follow from 
+        // the smallest and largest absolute coordinates within the box.
+        const Vector lower = box.min().cwiseAbs();
+        const Vector upper = box.max().cwiseAbs();
+        Vector absMin = lower.cwiseMin(upper);
+        for (int i = 0; i < 3; ++i) {
+            if (box.min()(i) <= S(0) && box.max()(i) >= S(0))
+                absMin(i) = S(0);
+        }
+        const Vector absMax = lower.cwiseMax(upper);
+
+        return math::Interval(boxDistance(absMin - _hext), boxDistance(absMax - _hext));
+    }
+
+    bool
+    SDFBox::intersectRay(const Vector &o, const Vector &d, Scalar minT, Scalar maxT, TraceResult &r) const
+    {
+        const Vector p = o + minT * d;
+        const Scalar f = boxDistance(p.array().abs().matrix() - _hext);
+
+        r.iter = 0;
+        r.node = this;
+        r.element = 0;
+        if (f <= Scalar(0)) {
+            // Starting inside.
+            r.t = minT;
+            r.sdf = f;
+            r.hit = f == Scalar(0);
+            return true;
+        }
+
+        // Clip the ray against the slabs of all axes.
+        Scalar sNear(0);
+        Scalar sFar = std::numeric_limits<Scalar>::infinity();
+        for (int i = 0; i < 3; ++i) {
+            if (d(i) == Scalar(0)) {
+                if (std::abs(p(i)) > _hext(i))
+                    sFar = Scalar(-1);
+                continue;
+            }
+            const Scalar s0 = (-_hext(i) - p(i)) / d(i);
+            const Scalar s1 = (_hext(i) - p(i)) / d(i);
+            sNear = std::max(sNear, std::min(s0, s1));
+            sFar = std::min(sFar, std::max(s0, s1));
+        }
+
+        const Scalar t = sNear <= sFar ? minT + sNear : maxT;
+        if (!(t < maxT)) {
+            r.t = maxT;
+            r.sdf = std::numeric_limits<Scalar>::infinity();
+            r.node = 0;
+            r.hit = false;
+            return true;
+        }
+
+        r.t = t;
+        r.sdf = 0;
+        r.hit = true;
+        return true;
+    }
+
 	void SDFBox::accept(SDFNodeVisitor &nv)
 	{
 		nv.visit(this);
@@ -0,0 +1,73 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/sdf_box_set.h>
+#include <volplay/sdf_node_visitor.h>
+#include <algorithm>
+
+namespace volplay {
+
+    SDFBoxSet::SDFBoxSet(const std::vector<Vector> &centers, const std::vector<Vector> &halfLengths, int leafSize)
+    {
+        const int n = int(std::min(centers.size(), halfLengths.size()));
+
+        std::vector<AlignedBox> bounds(n);
+        for (int i = 0; i < n; ++i)
+            bounds[i] = AlignedBox(centers[i] - halfLengths[i], centers[i] + halfLengths[i]);
+        buildHierarchy(bounds, leafSize);
+
+        _cx.resize(n);
+        _cy.resize(n);
+        _cz.resize(n);
+        _hx.resize(n);
+        _hy.resize(n);
+        _hz.resize(n);
+        for (int i = 0; i < n; ++i) {
+            const int e = elementId(i);
+            _cx(i) = centers[e].x();
+            _cy(i) = centers[e].y();
+            _cz(i) = centers[e].z();
+            _hx(i) = halfLengths[e].x();
+            _hy(i) = halfLengths[e].y();
+            _hz(i) = halfLengths[e].z();
+        }
+    }
+
+    Vector
+    SDFBoxSet::center(int i) const
+    {
+        const int p = leafIndex(i);
+        return Vector(_cx(p), _cy(p), _cz(p));
+    }
+
+    Vector
+    SDFBoxSet::halfLengths(int i) const
+    {
+        const int p = leafIndex(i);
+        return Vector(_hx(p), _hy(p), _hz(p));
+    }
+
+    void
+    SDFBoxSet::evalLeaf(const Vector &x, int first, int count, LeafArray &sdf) const
+    {
+        // Same as SDFBox, given the distances to the box faces along each axis.
+        LeafArray dx = (_cx.segment(first, count) - x.x()).abs() - _hx.segment(first, count);
+        LeafArray dy = (_cy.segment(first, count) - x.y()).abs() - _hy.segment(first, count);
+        LeafArray dz = (_cz.segment(first, count) - x.z()).abs() - _hz.segment(first, count);
+
+        sdf = dx.max(dy).max(dz).min(Scalar(0)) +
+              (dx.max(Scalar(0)).square() + dy.max(Scalar(0)).square() + dz.max(Scalar(0)).square()).sqrt();
+    }
+
+	void SDFBoxSet::accept(SDFNodeVisitor &nv)
+	{
+		nv.visit(this);
+	}
+
+}
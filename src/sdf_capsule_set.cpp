@@ -0,0 +1,93 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/sdf_capsule_set.h>
+#include <volplay/sdf_node_visitor.h>
+#include <algorithm>
+
+namespace volplay {
+
+    SDFCapsuleSet::SDFCapsuleSet(const std::vector<Vector> &a, const std::vector<Vector> &b, const std::vector<Scalar> &radii, int leafSize)
+    {
+        const int n = int(std::min(std::min(a.size(), b.size()), radii.size()));
+
+        std::vector<AlignedBox> bounds(n);
+        for (int i = 0; i < n; ++i) {
+            const Vector r = Vector::Constant(radii[i]);
+            bounds[i] = AlignedBox(a[i].cwiseMin(b[i]) - r, a[i].cwiseMax(b[i]) + r);
+        }
+        buildHierarchy(bounds, leafSize);
+
+        _ax.resize(n);
+        _ay.resize(n);
+        _az.resize(n);
+        _abx.resize(n);
+        _aby.resize(n);
+        _abz.resize(n);
+        _invLength2.resize(n);
+        _radii.resize(n);
+        for (int i = 0; i < n; ++i) {
+            const int e = elementId(i);
+            const Vector ab = b[e] - a[e];
+            const Scalar l2 = ab.squaredNorm();
+            _ax(i) = a[e].x();
+            _ay(i) = a[e].y();
+            _az(i) = a[e].z();
+            _abx(i) = ab.x();
+            _aby(i) = ab.y();
+            _abz(i) = ab.z();
+            // Degenerate capsules are spheres around the first end point.
+            _invLength2(i) = l2 > Scalar(0) ? Scalar(1) / l2 : Scalar(0);
+            _radii(i) = radii[e];
+        }
+    }
+
+    Vector
+    SDFCapsuleSet::a(int i) const
+    {
+        const int p = leafIndex(i);
+        return Vector(_ax(p), _ay(p), _az(p));
+    }
+
+    Vector
+    SDFCapsuleSet::b(int i) const
+    {
+        const int p = leafIndex(i);
+        return Vector(_ax(p) + _abx(p), _ay(p) + _aby(p), _az(p) + _abz(p));
+    }
+
+    Scalar
+    SDFCapsuleSet::radius(int i) const
+    {
+        return _radii(leafIndex(i));
+    }
+
+    void
+    SDFCapsuleSet::evalLeaf(const Vector &x, int first, int count, LeafArray &sdf) const
+    {
+        // Distance to the closest point on the segment, whose parameter is the projection onto the 
+        // segment clamped to its end points.
+        LeafArray px = x.x() - _ax.segment(first, count);
+        LeafArray py = x.y() - _ay.segment(first, count);
+        LeafArray pz = x.z() - _az.segment(first, count);
+
+        LeafArray h = ((px * _abx.segment(first, count) + py * _aby.segment(first, count) + pz * _abz.segment(first, count)) *
+                       _invLength2.segment(first, count)).max(Scalar(0)).min(Scalar(1));
+
+        sdf = ((px - h * _abx.segment(first, count)).square() +
+               (py - h * _aby.segment(first, count)).square() +
+               (pz - h * _abz.segment(first, count)).square()).sqrt() - _radii.segment(first, count);
+    }
+
+	void SDFCapsuleSet::accept(SDFNodeVisitor &nv)
+	{
+		nv.visit(this);
+	}
+
+}
@@ -10,6 +10,7 @@
 #include <volplay/sdf_difference.h>
 #include <volplay/util/iterator_range.h>
 #include <volplay/sdf_node_visitor.h>
+#include <algorithm>
 
 namespace volplay {
     
@@ -38,6 +39,61 @@ namespace volplay {
         return r;
     }
 
+    Scalar
+    SDFDifference::boundedEval(const Vector &x, Scalar lower, Scalar upper) const
+    {
+        assert(this->size() > 0);
+        
+        // Children only matter above the largest value seen so far. Bounds of subtracted children 
+        // are negated.
+        SDFGroup::SDFNodeArray::const_iterator i = this->begin();
+        Scalar r = (*i)->boundedEval(x, lower, upper);
+        for (++i; i != this->end() && r < upper; ++i) {
+            r = std::max(r, -(*i)->boundedEval(x, -upper, -std::max(lower, r)));
+        }
+        
+        return r;
+    }
+
+    math::Interval
+    SDFDifference::evalInterval(const AlignedBox &box) const
+    {
+        assert(this->size() > 0);
+        
+        SDFGroup::SDFNodeArray::const_iterator i = this->begin();
+        math::Interval r = (*i)->evalInterval(box);
+        for (++i; i != this->end(); ++i) {
+            r = math::max(r, -(*i)->evalInterval(box));
+        }
+        return r;
+    }
+
+    Scalar
+    SDFDifference::safeEval(const Vector &x) const
+    {
+        assert(this->size() > 0);
+        
+        SDFGroup::SDFNodeArray::const_iterator i = this->begin();
+        Scalar r = (*i)->safeEval(x);
+        for (++i; i != this->end(); ++i) {
+            r = std::max(r, -(*i)->safeEval(x));
+        }
+        return r;
+    }
+
+    Scalar
+    SDFDifference::segmentLipschitz(const Vector &a, const Vector &b) const
+    {
+        assert(this->size() > 0);
+        
+        SDFGroup::SDFNodeArray::const_iterator i = this->begin();
+        Scalar l = (*i)->segmentLipschitz(a, b);
+        for (++i; i != this->end(); ++i) {
+            l = std::max(l, (*i)->segmentLipschitz(a, b));
+        }
+        return l;
+    }
+
 	void SDFDifference::accept(SDFNodeVisitor &nv)
 	{
 		nv.visit(this);
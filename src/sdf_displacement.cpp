@@ -13,15 +13,17 @@
 namespace volplay {
 
     SDFDisplacement::SDFDisplacement()
+        :_dfncLipschitz(0), _offset(0)
     {}
         
-    SDFDisplacement::SDFDisplacement(const ScalarFnc &fnc)
-        :_dfnc(fnc)
+    SDFDisplacement::SDFDisplacement(const ScalarFnc &fnc, Scalar lipschitz)
+        :_dfnc(fnc), _dfncLipschitz(lipschitz), _offset(0)
     {}
         
     SDFResult SDFDisplacement::fullEval(const Vector &x) const
     {
         SDFResult r = SDFUnion::fullEval(x);
+        r.sdf += _offset;
         if (_dfnc) {
             Scalar d = _dfnc(x);
             r.sdf += d;
@@ -29,9 +31,70 @@ namespace volplay {
         return r;
     }
         
-    void SDFDisplacement::setDisplacementFunction(const ScalarFnc &fnc)
+    Scalar SDFDisplacement::boundedEval(const Vector &x, Scalar lower, Scalar upper) const
+    {
+        const Scalar d = _offset + (_dfnc ? _dfnc(x) : Scalar(0));
+        return SDFUnion::boundedEval(x, lower - d, upper - d) + d;
+    }
+        
+    Scalar SDFDisplacement::lipschitz() const
+    {
+        return SDFUnion::lipschitz() + (_dfnc ? _dfncLipschitz : Scalar(0));
+    }
+
+    Scalar SDFDisplacement::safeEval(const Vector &x) const
+    {
+        // Children are evaluated as a whole, so the bound of the entire subtree applies.
+        return eval(x) / lipschitz();
+    }
+
+    Scalar SDFDisplacement::segmentLipschitz(const Vector &a, const Vector &b) const
+    {
+        return SDFUnion::segmentLipschitz(a, b) + (_dfnc ? _dfncLipschitz : Scalar(0));
+    }
+
+    void SDFDisplacement::setDisplacementFunction(const ScalarFnc &fnc, Scalar lipschitz)
     {
         _dfnc = fnc;
+        _dfncLipschitz = lipschitz;
+    }
+
+    const ScalarFnc &SDFDisplacement::displacementFunction() const
+    {
+        return _dfnc;
+    }
+
+    Scalar SDFDisplacement::displacementLipschitz() const
+    {
+        return _dfncLipschitz;
+    }
+
+    void SDFDisplacement::setOffset(Scalar offset)
+    {
+        _offset = offset;
+    }
+
+    Scalar SDFDisplacement::offset() const
+    {
+        return _offset;
+    }
+
+    math::Interval SDFDisplacement::evalInterval(const AlignedBox &box) const
+    {
+        if (_dfnc)
+            return math::Interval();
+
+        return SDFUnion::evalInterval(box) + _offset;
+    }
+
+    bool SDFDisplacement::intersectRay(const Vector &, const Vector &, Scalar, Scalar, TraceResult &) const
+    {
+        return false;
+    }
+
+    Scalar SDFDisplacement::trace(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr) const
+    {
+        return SDFNode::trace(o, d, opts, tr);
     }
 
 	void SDFDisplacement::accept(SDFNodeVisitor &nv)
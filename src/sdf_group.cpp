@@ -9,6 +9,7 @@
 
 #include <volplay/sdf_group.h>
 #include <volplay/sdf_node_visitor.h>
+#include <algorithm>
 
 namespace volplay {
     
@@ -43,6 +44,24 @@ namespace volplay {
     {
         return _nodes.size();
     }
+    
+    void
+    SDFGroup::clear()
+    {
+        _nodes.clear();
+    }
+
+    Scalar
+    SDFGroup::lipschitz() const
+    {
+        Scalar l(1);
+        if (!_nodes.empty()) {
+            l = _nodes[0]->lipschitz();
+            for (size_t i = 1; i < _nodes.size(); ++i)
+                l = std::max(l, _nodes[i]->lipschitz());
+        }
+        return l;
+    }
 
 	bool
 	SDFGroup::isGroup() const
@@ -225,18 +225,27 @@ namespace volplay {
         // SDF Displacement
 
         MakeDisplacement::MakeDisplacement(MakeRoot *r)
-            :MakeBaseType(r)
+            :MakeBaseType(r), _lipschitz(0), _offset(0)
         {}
 
-        MakeDisplacement &MakeDisplacement::fnc(const ScalarFnc &f)
+        MakeDisplacement &MakeDisplacement::fnc(const ScalarFnc &f, Scalar lipschitz)
         {
             _fnc = f;
+            _lipschitz = lipschitz;
+            return *this;
+        }
+
+        MakeDisplacement &MakeDisplacement::offset(Scalar o)
+        {
+            _offset = o;
             return *this;
         }
 
         SDFNodePtr MakeDisplacement::createNode() const
         {
-            return std::make_shared<SDFDisplacement>(_fnc);
+            SDFDisplacementPtr d = std::make_shared<SDFDisplacement>(_fnc, _lipschitz);
+            d->setOffset(_offset);
+            return d;
         }
 
         // Node
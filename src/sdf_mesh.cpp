@@ -0,0 +1,336 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/sdf_mesh.h>
+#include <volplay/sdf_node_visitor.h>
+#include <volplay/util/parallel.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+namespace volplay {
+
+    /** Features of a triangle a closest point may lie on. */
+    enum ETriangleFeature {
+        FEATURE_FACE = 0,
+        FEATURE_VERTEX = 1, // 1..3 for vertices 0..2
+        FEATURE_EDGE = 4    // 4..6 for edges 01, 12, 20
+    };
+
+    /** Number of consecutive queries sharing a thread in batched evaluation. */
+    static const int batchSize = 256;
+
+    /** Squared distance of point to box. */
+    inline Scalar boxDistance2(const Vector &x, const Vector &lower, const Vector &upper)
+    {
+        return (x - x.cwiseMax(lower).cwiseMin(upper)).squaredNorm();
+    }
+
+    /** Angle at vertex a of triangle abc. */
+    inline Scalar angleAt(const Vector &a, const Vector &b, const Vector &c)
+    {
+        const Vector u = b - a;
+        const Vector v = c - a;
+        return std::atan2(u.cross(v).norm(), u.dot(v));
+    }
+
+    SDFMesh::SDFMesh(const surface::IndexedSurface &s, int leafSize)
+        : _vertices(s.vertices), _triangles(s.triangles())
+    {
+        const int nt = int(_triangles.cols());
+        const int nv = int(_vertices.cols());
+
+        // Vertices at the same position are welded for the computation of pseudo-normals, as
+        // extractors such as dual contouring may place multiple vertices on sharp features.
+        const Vector lower = nv > 0 ? Vector(_vertices.rowwise().minCoeff()) : Vector::Zero();
+        const Vector upper = nv > 0 ? Vector(_vertices.rowwise().maxCoeff()) : Vector::Zero();
+        const Scalar weldEps = std::max<Scalar>((upper - lower).norm() * Scalar(1e-4), std::numeric_limits<Scalar>::min());
+
+        auto indexLess = [](const Index &a, const Index &b) {
+            return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+        };
+        std::map<Index, std::vector<int>, decltype(indexLess)> cells(indexLess);
+        _weld.resize(nv);
+        for (int v = 0; v < nv; ++v) {
+            const Index q = ((_vertices.col(v) - lower) / weldEps).array().floor().cast<Index::Scalar>();
+
+            _weld[v] = v;
+            for (int i = 0; i < 27 && _weld[v] == v; ++i) {
+                auto c = cells.find(q + Index(i % 3 - 1, (i / 3) % 3 - 1, i / 9 - 1));
+                for (size_t k = 0; c != cells.end() && k < c->second.size(); ++k) {
+                    if ((_vertices.col(c->second[k]) - _vertices.col(v)).norm() <= weldEps) {
+                        _weld[v] = c->second[k];
+                        break;
+                    }
+                }
+            }
+
+            if (_weld[v] == v)
+                cells[q].push_back(v);
+        }
+
+        // Pseudo-normals. Edge normals sum the normals of both incident faces, vertex
+        // normals weight incident face normals by the angle at the vertex. Degenerate 
+        // faces, including those collapsed by welding, have no reliable normal and are
+        // skipped entirely.
+        _faceNormals.resize(nt);
+        _edgeNormals.assign(nt * 3, Vector::Zero());
+        _vertexNormals.assign(nv, Vector::Zero());
+
+        std::vector<char> degenerate(nt, 0);
+        std::map< std::pair<int, int>, Vector > edges;
+        for (int t = 0; t < nt; ++t) {
+            const Vector a = _vertices.col(_triangles(0, t));
+            const Vector b = _vertices.col(_triangles(1, t));
+            const Vector c = _vertices.col(_triangles(2, t));
+
+            const Vector n = (b - a).cross(c - a);
+            const Scalar len = n.norm();
+            const Scalar maxEdge2 = std::max((b - a).squaredNorm(), std::max((c - b).squaredNorm(), (a - c).squaredNorm()));
+            const int wa = _weld[_triangles(0, t)];
+            const int wb = _weld[_triangles(1, t)];
+            const int wc = _weld[_triangles(2, t)];
+            degenerate[t] = len <= maxEdge2 * Scalar(1e-3) || wa == wb || wb == wc || wc == wa;
+            if (degenerate[t]) {
+                _faceNormals[t] = Vector::Zero();
+                continue;
+            }
+            _faceNormals[t] = n / len;
+
+            _vertexNormals[wa] += angleAt(a, b, c) * _faceNormals[t];
+            _vertexNormals[wb] += angleAt(b, c, a) * _faceNormals[t];
+            _vertexNormals[wc] += angleAt(c, a, b) * _faceNormals[t];
+
+            for (int e = 0; e < 3; ++e) {
+                const int i = _weld[_triangles(e, t)];
+                const int j = _weld[_triangles((e + 1) % 3, t)];
+                std::pair<std::map< std::pair<int, int>, Vector >::iterator, bool> r = 
+                    edges.insert(std::make_pair(std::make_pair(std::min(i, j), std::max(i, j)), Vector::Zero()));
+                r.first->second += _faceNormals[t];
+            }
+        }
+
+        for (int t = 0; t < nt; ++t) {
+            if (degenerate[t])
+                continue;
+            for (int e = 0; e < 3; ++e) {
+                const int i = _weld[_triangles(e, t)];
+                const int j = _weld[_triangles((e + 1) % 3, t)];
+                _edgeNormals[t * 3 + e] = edges[std::make_pair(std::min(i, j), std::max(i, j))];
+            }
+        }
+
+        // Hierarchy over non-degenerate faces.
+        std::vector<AlignedBox> bounds(nt);
+        for (int t = 0; t < nt; ++t) {
+            for (int k = 0; k < 3; ++k)
+                bounds[t].extend(Vector(_vertices.col(_triangles(k, t))));
+            if (!degenerate[t])
+                _order.push_back(t);
+        }
+
+        _bvh.build(bounds, _order, leafSize);
+    }
+
+    void SDFMesh::closestOnTriangle(const Vector &x, int t, Closest &c) const
+    {
+        // Region based closest point, see Ericson, Real-Time Collision Detection, 5.1.5.
+        const Vector a = _vertices.col(_triangles(0, t));
+        const Vector b = _vertices.col(_triangles(1, t));
+        const Vector cc = _vertices.col(_triangles(2, t));
+
+        const Vector ab = b - a;
+        const Vector ac = cc - a;
+
+        Vector p;
+        int feature;
+
+        const Vector ap = x - a;
+        const Scalar d1 = ab.dot(ap);
+        const Scalar d2 = ac.dot(ap);
+        const Vector bp = x - b;
+        const Scalar d3 = ab.dot(bp);
+        const Scalar d4 = ac.dot(bp);
+        const Vector cp = x - cc;
+        const Scalar d5 = ab.dot(cp);
+        const Scalar d6 = ac.dot(cp);
+        const Scalar vc = d1 * d4 - d3 * d2;
+        const Scalar vb = d5 * d2 - d1 * d6;
+        const Scalar va = d3 * d6 - d5 * d4;
+
+        if (d1 <= 0 && d2 <= 0) {
+            p = a; 
+            feature = FEATURE_VERTEX + 0;
+        } else if (d3 >= 0 && d4 <= d3) {
+            p = b;
+            feature = FEATURE_VERTEX + 1;
+        } else if (d6 >= 0 && d5 <= d6) {
+            p = cc;
+            feature = FEATURE_VERTEX + 2;
+        } else if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+            p = a + ab * (d1 / (d1 - d3));
+            feature = FEATURE_EDGE + 0;
+        } else if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+            p = b + (cc - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+            feature = FEATURE_EDGE + 1;
+        } else if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+            p = a + ac * (d2 / (d2 - d6));
+            feature = FEATURE_EDGE + 2;
+        } else {
+            const Scalar denom = Scalar(1) / (va + vb + vc);
+            p = a + ab * (vb * denom) + ac * (vc * denom);
+            feature = FEATURE_FACE;
+        }
+
+        const Scalar d2p = (x - p).squaredNorm();
+        if (d2p < c.d2) {
+            c.p = p;
+            c.d2 = d2p;
+            c.triangle = t;
+            c.feature = feature;
+        }
+    }
+
+    void SDFMesh::closest(const Vector &x, int hint, Closest &c) const
+    {
+        c.d2 = std::numeric_limits<Scalar>::max();
+        c.triangle = -1;
+        c.feature = FEATURE_FACE;
+
+        typedef util::BoundingVolumeHierarchy::Node Node;
+        const std::vector<Node> &nodes = _bvh.nodes();
+        if (nodes.empty())
+            return;
+
+        // The triangle of a nearby query bounds the distance from the start.
+        if (hint >= 0)
+            closestOnTriangle(x, hint, c);
+
+        // Depth of the hierarchy is logarithmic due to median splits.
+        int stack[64];
+        int top = 0;
+        stack[top++] = 0;
+
+        while (top > 0) {
+            const Node &n = nodes[stack[--top]];
+            if (boxDistance2(x, n.lower, n.upper) >= c.d2)
+                continue;
+
+            if (n.count > 0) {
+                for (int i = n.first; i < n.first + n.count; ++i)
+                    closestOnTriangle(x, _order[i], c);
+                continue;
+            }
+
+            // Visit nearer child first.
+            const int left = int(&n - &nodes[0]) + 1;
+            const int right = n.first;
+            const Scalar dl = boxDistance2(x, nodes[left].lower, nodes[left].upper);
+            const Scalar dr = boxDistance2(x, nodes[right].lower, nodes[right].upper);
+            if (dl < dr) {
+                if (dr < c.d2) stack[top++] = right;
+                if (dl < c.d2) stack[top++] = left;
+            } else {
+                if (dl < c.d2) stack[top++] = left;
+                if (dr < c.d2) stack[top++] = right;
+            }
+        }
+    }
+
+    Scalar SDFMesh::signedDistance(const Vector &x, const Closest &c) const
+    {
+        if (c.triangle < 0)
+            return std::numeric_limits<Scalar>::max();
+
+        Vector n;
+        if (c.feature == FEATURE_FACE)
+            n = _faceNormals[c.triangle];
+        else if (c.feature < FEATURE_EDGE)
+            n = _vertexNormals[_weld[_triangles(c.feature - FEATURE_VERTEX, c.triangle)]];
+        else
+            n = _edgeNormals[c.triangle * 3 + c.feature - FEATURE_EDGE];
+
+        const Scalar d = std::sqrt(c.d2);
+        return (x - c.p).dot(n) < Scalar(0) ? -d : d;
+    }
+
+    SDFResult
+    SDFMesh::fullEval(const Vector &x) const
+    {
+        Closest c;
+        closest(x, -1, c);
+        SDFResult r = {this, signedDistance(x, c)};
+        return r;
+    }
+
+    void SDFMesh::evalBatch(const std::vector<Vector> &x, std::vector<Scalar> &sdf) const
+    {
+        const int n = int(x.size());
+        sdf.resize(n);
+
+        util::parallelFor(0, (n + batchSize - 1) / batchSize, [this, &x, &sdf, n](int b) {
+            Closest c;
+            int hint = -1;
+            for (int i = b * batchSize; i < std::min<int>(n, (b + 1) * batchSize); ++i) {
+                closest(x[i], hint, c);
+                sdf[i] = signedDistance(x[i], c);
+                hint = c.triangle;
+            }
+        });
+    }
+
+    std::vector<float> SDFMesh::bake(const Vector &origin, const Index &dims, const Vector &spacing) const
+    {
+        std::vector<float> samples(size_t(std::max<int>(0, dims.x())) * std::max<int>(0, dims.y()) * std::max<int>(0, dims.z()));
+        if (samples.empty())
+            return samples;
+
+        util::parallelFor(0, dims.y() * dims.z(), [this, &samples, &origin, &dims, &spacing](int row) {
+            const int y = row % dims.y();
+            const int z = row / dims.y();
+
+            Closest c;
+            int hint = -1;
+            for (int x = 0; x < dims.x(); ++x) {
+                const Vector p = origin + Vector(Scalar(x), Scalar(y), Scalar(z)).cwiseProduct(spacing);
+                closest(p, hint, c);
+                samples[size_t(row) * dims.x() + x] = float(signedDistance(p, c));
+                hint = c.triangle;
+            }
+        });
+
+        return samples;
+    }
+
+    Vector SDFMesh::closestPoint(const Vector &x, int *triangle) const
+    {
+        Closest c;
+        closest(x, -1, c);
+        if (triangle)
+            *triangle = c.triangle;
+        return c.triangle >= 0 ? c.p : x;
+    }
+
+    Vector SDFMesh::lowerBounds() const
+    {
+        return _bvh.nodes().empty() ? Vector::Zero() : _bvh.nodes()[0].lower;
+    }
+
+    Vector SDFMesh::upperBounds() const
+    {
+        return _bvh.nodes().empty() ? Vector::Zero() : _bvh.nodes()[0].upper;
+    }
+
+	void SDFMesh::accept(SDFNodeVisitor &nv)
+	{
+		nv.visit(this);
+	}
+    
+}
@@ -9,6 +9,7 @@
 
 #include <volplay/sdf_node.h>
 #include <volplay/sdf_node_visitor.h>
+#include <algorithm>
 #include <limits>
 
 namespace volplay {
@@ -19,6 +20,38 @@ namespace volplay {
         return this->fullEval(x).sdf;
     }
     
+    Scalar
+    SDFNode::boundedEval(const Vector &x, Scalar, Scalar) const
+    {
+        return fullEval(x).sdf;
+    }
+
+    Scalar
+    SDFNode::lipschitz() const
+    {
+        return Scalar(1);
+    }
+
+    Scalar
+    SDFNode::safeEval(const Vector &x) const
+    {
+        return eval(x) / lipschitz();
+    }
+
+    Scalar
+    SDFNode::segmentLipschitz(const Vector &, const Vector &) const
+    {
+        return lipschitz();
+    }
+
+    math::Interval
+    SDFNode::evalInterval(const AlignedBox &box) const
+    {
+        const Scalar d = eval(box.center());
+        const Scalar r = box.diagonal().norm() * Scalar(0.5) * lipschitz();
+        return math::Interval(d - r, d + r);
+    }
+
     Vector
     SDFNode::gradient(const Vector &x, Scalar eps) const
     {
@@ -43,12 +76,12 @@ namespace volplay {
     }
     
     SDFNode::TraceOptions::TraceOptions()
-    :minT(0), maxT(std::numeric_limits<Scalar>::max()), stepFact(1), sdfThreshold(0.0001f), maxIter(500)
+    :method(SPHERE_TRACING), minT(0), maxT(std::numeric_limits<Scalar>::max()), stepFact(1), sdfThreshold(0.0001f), maxIter(500), intervalLength(0), exactIntersections(false)
     {
     }
     
     SDFNode::TraceResult::TraceResult()
-    :iter(0), t(0), sdf(0)
+    :iter(0), t(0), sdf(0), element(0)
     {
     }
    
@@ -64,28 +97,126 @@ namespace volplay {
         // around edges of objects.
         //
         // Note that the underlying assumption made by this algorithm is that nodes might
-        // underestimate the true distance, but do not overestimate it.
+        // underestimate the true distance, but do not overestimate it. Scenes containing nodes 
+        // that are not 1-Lipschitz, see SDFNode::lipschitz, are stepped by safeEval instead, 
+        // which scales every subtree by its own bound. Other scenes are stepped by boundedEval,
+        // which allows groups to skip children. The closest node is determined once tracing ends.
+        //
+        // Optionally, whenever the step is shorter than TraceOptions::intervalLength, the SDF is
+        // bounded over the box of the ray segment of that length. Segments bounded away from the
+        // surface are skipped at once and the segment length is doubled on success.
+        //
+        // Nodes that intersect rays in closed form skip tracing altogether if requested.
         
+        if (opts.exactIntersections) {
+            TraceResult exact;
+            if (intersectRay(o, d, opts.minT, opts.maxT, exact)) {
+                if (tr)
+                    *tr = exact;
+                return exact.t;
+            }
+        }
+
+        if (opts.method == SEGMENT_TRACING)
+            return traceSegments(o, d, opts, tr);
+
+        const bool scaled = lipschitz() != Scalar(1);
+        auto evalAt = [&](Scalar t) -> SDFResult {
+            // Values below the threshold end tracing, values beyond the remaining ray step past its end.
+            SDFResult r = {0, scaled ? safeEval(o + t * d) : boundedEval(o + t * d, opts.sdfThreshold, (opts.maxT - t) / opts.stepFact)};
+            return r;
+        };
+
         Scalar t = opts.minT;
-        SDFResult r = fullEval(o + t * d);
+        SDFResult r = evalAt(t);
+        Scalar segment = opts.intervalLength;
         
         int nIter = 0;
         while (nIter < opts.maxIter && t < opts.maxT && r.sdf > opts.sdfThreshold) {
-            t += r.sdf * opts.stepFact;
-            r = fullEval(o + t * d);
+            Scalar step = r.sdf * opts.stepFact;
+            if (step < segment) {
+                const Scalar end = std::min(t + segment, opts.maxT);
+                AlignedBox box(o + t * d);
+                box.extend(o + end * d);
+                if (evalInterval(box).lower > opts.sdfThreshold) {
+                    step = end - t;
+                    segment *= 2;
+                } else {
+                    segment = opts.intervalLength;
+                }
+            }
+            t += step;
+            r = evalAt(t);
             ++nIter;
         }
         
         if (tr) {
+            const SDFResult full = fullEval(o + t * d);
+            tr->t = t;
+            tr->iter = nIter;
+            tr->hit = std::abs(scaled ? r.sdf : full.sdf) < opts.sdfThreshold;
+            tr->sdf = full.sdf;
+            tr->node = full.node;
+            tr->element = full.element;
+        }
+        
+        return t;
+
+    }
+
+    bool
+    SDFNode::intersectRay(const Vector &, const Vector &, Scalar, Scalar, TraceResult &) const
+    {
+        return false;
+    }
+
+    Scalar
+    SDFNode::traceSegments(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr) const
+    {
+        // Segment tracing, see segmentStep. Steps never pass the end of the ray, so larger values 
+        // need not be evaluated exactly.
+        
+        Scalar t = opts.minT;
+        Scalar sdf = boundedEval(o + t * d, opts.sdfThreshold, opts.maxT - t);
+        Scalar segment(0);
+        
+        int nIter = 0;
+        while (nIter < opts.maxIter && t < opts.maxT && sdf > opts.sdfThreshold) {
+            t += segmentStep(o, d, t, sdf, opts.maxT, opts.stepFact, segment);
+            sdf = boundedEval(o + t * d, opts.sdfThreshold, opts.maxT - t);
+            ++nIter;
+        }
+        
+        if (tr) {
+            const SDFResult r = fullEval(o + t * d);
             tr->t = t;
             tr->sdf = r.sdf;
             tr->node = r.node;
+            tr->element = r.element;
             tr->iter = nIter;
             tr->hit = std::abs(r.sdf) < opts.sdfThreshold;
         }
         
         return t;
+    }
 
+    Scalar
+    SDFNode::segmentStep(const Vector &o, const Vector &d, Scalar t, Scalar sdf, Scalar maxT, Scalar stepFact, Scalar &segment) const
+    {
+        // The SDF cannot change faster than its Lipschitz bound along the segment ahead, so the 
+        // position can safely move forward by the SDF divided by that bound, but not beyond the end
+        // of the segment. The next segment is a multiple of the last step, so it grows while steps 
+        // are limited by segment lengths and shrinks when approaching a surface.
+        
+        const Scalar growth(2);
+        
+        if (segment <= Scalar(0))
+            segment = sdf * growth;
+        
+        const Scalar end = std::min(t + segment, maxT);
+        const Scalar step = std::min(sdf / segmentLipschitz(o + t * d, o + end * d), end - t) * stepFact;
+        segment = step * growth;
+        return step;
     }
 
     void
@@ -99,6 +230,12 @@ namespace volplay {
     {
         _attachments = other;
     }
+    
+    const SDFNode::AttachmentMap &
+    SDFNode::attachments() const
+    {
+        return _attachments;
+    }
 
 	bool
 	SDFNode::isGroup() const
@@ -11,6 +11,12 @@
 #include <volplay/sdf_node.h>
 #include <volplay/sdf_sphere.h>
 #include <volplay/sdf_box.h>
+#include <volplay/sdf_volume.h>
+#include <volplay/sdf_mesh.h>
+#include <volplay/sdf_sphere_set.h>
+#include <volplay/sdf_box_set.h>
+#include <volplay/sdf_capsule_set.h>
+#include <volplay/tsdf_volume.h>
 #include <volplay/sdf_plane.h>
 #include <volplay/sdf_group.h>
 #include <volplay/sdf_union.h>
@@ -42,6 +48,41 @@ namespace volplay {
 		visit(static_cast<SDFNode*>(n));
 	}
 
+	void SDFNodeVisitor::visit(SDFVolume *n)
+	{
+		visit(static_cast<SDFNode*>(n));
+	}
+
+	void SDFNodeVisitor::visit(SDFMesh *n)
+	{
+		visit(static_cast<SDFNode*>(n));
+	}
+
+	void SDFNodeVisitor::visit(SDFPrimitiveSet *n)
+	{
+		visit(static_cast<SDFNode*>(n));
+	}
+
+	void SDFNodeVisitor::visit(SDFSphereSet *n)
+	{
+		visit(static_cast<SDFPrimitiveSet*>(n));
+	}
+
+	void SDFNodeVisitor::visit(SDFBoxSet *n)
+	{
+		visit(static_cast<SDFPrimitiveSet*>(n));
+	}
+
+	void SDFNodeVisitor::visit(SDFCapsuleSet *n)
+	{
+		visit(static_cast<SDFPrimitiveSet*>(n));
+	}
+
+	void SDFNodeVisitor::visit(TSDFVolume *n)
+	{
+		visit(static_cast<SDFNode*>(n));
+	}
+
 	void SDFNodeVisitor::visit(SDFGroup *n)
 	{
 		visit(static_cast<SDFNode*>(n));
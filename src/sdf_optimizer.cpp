@@ -0,0 +1,286 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/sdf_optimizer.h>
+#include <volplay/sdf_group.h>
+#include <volplay/sdf_union.h>
+#include <volplay/sdf_intersection.h>
+#include <volplay/sdf_difference.h>
+#include <volplay/sdf_rigid_transform.h>
+#include <volplay/sdf_repetition.h>
+#include <volplay/sdf_displacement.h>
+#include <algorithm>
+#include <typeinfo>
+#include <utility>
+#include <cmath>
+
+namespace volplay {
+
+    namespace {
+
+        /** Cast to given node type only if node is exactly of that type, not derived from it. */
+        template<class T>
+        std::shared_ptr<T> exactCast(const SDFNodePtr &n)
+        {
+            if (n && typeid(*n) == typeid(T))
+                return std::static_pointer_cast<T>(n);
+            else
+                return std::shared_ptr<T>();
+        }
+
+        /** Test if group evaluates to the plain union of its children. */
+        bool isPassThrough(const SDFNodePtr &n)
+        {
+            if (exactCast<SDFUnion>(n)) {
+                return true;
+            } else if (SDFRigidTransformPtr t = exactCast<SDFRigidTransform>(n)) {
+                return t->worldToLocal().matrix().isApprox(AffineTransform::Identity().matrix());
+            } else if (SDFRepetitionPtr r = exactCast<SDFRepetition>(n)) {
+                const Vector &c = r->cellSizes();
+                return !std::isfinite(c.x()) && !std::isfinite(c.y()) && !std::isfinite(c.z());
+            } else if (SDFDisplacementPtr d = exactCast<SDFDisplacement>(n)) {
+                return !d->displacementFunction() && d->offset() == S(0);
+            }
+            return false;
+        }
+
+        /** Replace children of group with the given range of nodes. */
+        template<class Iterator>
+        void replaceChildren(SDFGroup *g, Iterator begin, Iterator end)
+        {
+            SDFGroup::SDFNodeArray nodes(begin, end);
+            g->clear();
+            for (size_t i = 0; i < nodes.size(); ++i)
+                g->add(nodes[i]);
+        }
+    }
+
+    SDFOptimizer::SDFOptimizer()
+        : _reorder(true)
+    {}
+
+    void
+    SDFOptimizer::setReorderByCostEnabled(bool enable)
+    {
+        _reorder = enable;
+    }
+
+    SDFNodePtr
+    SDFOptimizer::optimize(const SDFNodePtr &root)
+    {
+        if (!root)
+            return root;
+
+        // Wrap the root in a temporary union, so that the root itself is subject to
+        // simplification. If the root got flattened into the temporary union, the
+        // temporary union becomes the new root.
+        SDFUnionPtr holder = std::make_shared<SDFUnion>();
+        holder->add(root);
+
+        _visited.clear();
+        holder->accept(*this);
+        _visited.clear();
+
+        SDFNodePtr result = holder->size() == 1 ? *holder->begin() : holder;
+
+        if (_reorder)
+            reorderByCost(result.get());
+
+        return result;
+    }
+
+    void
+    SDFOptimizer::visit(SDFUnion *n)
+    {
+        if (!_visited.insert(n).second)
+            return;
+
+        simplifyChildren(n, true);
+    }
+
+    void
+    SDFOptimizer::visit(SDFIntersection *n)
+    {
+        if (!_visited.insert(n).second)
+            return;
+
+        simplifyChildren(n, false);
+    }
+
+    void
+    SDFOptimizer::visit(SDFDifference *n)
+    {
+        if (!_visited.insert(n).second)
+            return;
+
+        simplifyChildren(n, false);
+    }
+
+    void
+    SDFOptimizer::visit(SDFRigidTransform *n)
+    {
+        if (!_visited.insert(n).second)
+            return;
+
+        if (typeid(*n) != typeid(SDFRigidTransform)) {
+            simplifyChildren(n, true);
+            return;
+        }
+
+        bool changed = true;
+        while (changed) {
+            changed = false;
+
+            // Fold T1(T2(x)) into a single transform.
+            while (n->size() == 1) {
+                SDFRigidTransformPtr c = exactCast<SDFRigidTransform>(*n->begin());
+                if (!c || !c->attachments().empty())
+                    break;
+
+                n->setLocalToWorld(n->localToWorld() * c->localToWorld());
+                replaceChildren(n, c->begin(), c->end());
+                changed = true;
+            }
+
+            changed |= simplifyChildren(n, true);
+        }
+    }
+
+    void
+    SDFOptimizer::visit(SDFDisplacement *n)
+    {
+        if (!_visited.insert(n).second)
+            return;
+
+        if (typeid(*n) != typeid(SDFDisplacement)) {
+            simplifyChildren(n, true);
+            return;
+        }
+
+        bool changed = true;
+        while (changed) {
+            changed = false;
+
+            // Fold D1(D2(x)) into a single displacement when at most one of them has
+            // a non-constant displacement function.
+            while (n->size() == 1) {
+                SDFDisplacementPtr c = exactCast<SDFDisplacement>(*n->begin());
+                if (!c || !c->attachments().empty())
+                    break;
+                if (c->displacementFunction() && n->displacementFunction())
+                    break;
+
+                if (c->displacementFunction())
+                    n->setDisplacementFunction(c->displacementFunction(), c->displacementLipschitz());
+                n->setOffset(n->offset() + c->offset());
+                replaceChildren(n, c->begin(), c->end());
+                changed = true;
+            }
+
+            changed |= simplifyChildren(n, true);
+        }
+    }
+
+    bool
+    SDFOptimizer::simplifyChildren(SDFGroup *g, bool isUnion)
+    {
+        const bool isIntersection = typeid(*g) == typeid(SDFIntersection);
+        const bool isDifference = typeid(*g) == typeid(SDFDifference);
+
+        bool anyChange = false;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+
+            SDFGroup::SDFNodeArray result;
+            for (auto iter = g->begin(); iter != g->end(); ++iter) {
+                const SDFNodePtr &c = *iter;
+                const bool first = iter == g->begin();
+                SDFGroupPtr cg = std::dynamic_pointer_cast<SDFGroup>(c);
+
+                if (!cg || cg->size() == 0 || !cg->attachments().empty()) {
+                    result.push_back(c);
+                    continue;
+                }
+
+                // A child that represents the union of its children can be spliced into
+                // unions and into the subtracted part of differences.
+                const bool passThrough = isPassThrough(c);
+                const bool flattenUnion = passThrough && (isUnion || (isDifference && !first));
+                const bool flattenIntersection = isIntersection && exactCast<SDFIntersection>(c);
+                const bool flattenDifference = isDifference && first && exactCast<SDFDifference>(c);
+                const bool singleChild = cg->size() == 1 &&
+                    (passThrough || exactCast<SDFIntersection>(c) || exactCast<SDFDifference>(c));
+
+                if (flattenUnion || flattenIntersection || flattenDifference || singleChild) {
+                    result.insert(result.end(), cg->begin(), cg->end());
+                    changed = true;
+                } else {
+                    result.push_back(c);
+                }
+            }
+
+            if (changed) {
+                replaceChildren(g, result.begin(), result.end());
+                anyChange = true;
+            }
+        }
+
+        return anyChange;
+    }
+
+    Scalar
+    SDFOptimizer::estimateCost(const SDFNode *n)
+    {
+        // Every node accounts for a unit of cost. Displacement functions are opaque
+        // and assumed to be as expensive as a primitive.
+        Scalar cost(1);
+
+        const SDFDisplacement *d = dynamic_cast<const SDFDisplacement*>(n);
+        if (d && d->displacementFunction())
+            cost += S(1);
+
+        const SDFGroup *g = dynamic_cast<const SDFGroup*>(n);
+        if (g) {
+            for (auto iter = g->begin(); iter != g->end(); ++iter)
+                cost += estimateCost(iter->get());
+        }
+
+        return cost;
+    }
+
+    Scalar
+    SDFOptimizer::reorderByCost(SDFNode *n)
+    {
+        SDFGroup *g = dynamic_cast<SDFGroup*>(n);
+        if (!g)
+            return estimateCost(n);
+
+        std::vector< std::pair<Scalar, SDFNodePtr> > costs;
+        for (auto iter = g->begin(); iter != g->end(); ++iter)
+            costs.push_back(std::make_pair(reorderByCost(iter->get()), *iter));
+
+        // The first child of a difference is special and has to stay in front.
+        auto sortBegin = costs.begin();
+        if (typeid(*g) == typeid(SDFDifference) && sortBegin != costs.end())
+            ++sortBegin;
+
+        std::stable_sort(sortBegin, costs.end(),
+            [](const std::pair<Scalar, SDFNodePtr> &a, const std::pair<Scalar, SDFNodePtr> &b) {
+                return a.first < b.first;
+            });
+
+        g->clear();
+        for (size_t i = 0; i < costs.size(); ++i)
+            g->add(costs[i].second);
+
+        return estimateCost(n);
+    }
+
+}
@@ -9,6 +9,8 @@
 
 #include <volplay/sdf_plane.h>
 #include <volplay/sdf_node_visitor.h>
+#include <cmath>
+#include <limits>
 
 namespace volplay {
     
@@ -27,6 +29,58 @@ namespace volplay {
         return r;
     }
 
+    Scalar
+    SDFPlane::boundedEval(const Vector &x, Scalar, Scalar) const
+    {
+        return x.dot(_normal) + _w;
+    }
+
+    math::Interval
+    SDFPlane::evalInterval(const AlignedBox &box) const
+    {
+        const Scalar c = box.center().dot(_normal) + _w;
+        const Scalar r = (box.sizes() * Scalar(0.5)).dot(_normal.cwiseAbs());
+        return math::Interval(c - r, c + r);
+    }
+
+    Scalar
+    SDFPlane::segmentLipschitz(const Vector &a, const Vector &b) const
+    {
+        return std::abs((b - a).normalized().dot(_normal));
+    }
+
+    bool
+    SDFPlane::intersectRay(const Vector &o, const Vector &d, Scalar minT, Scalar maxT, TraceResult &r) const
+    {
+        const Scalar f = (o + minT * d).dot(_normal) + _w;
+
+        r.iter = 0;
+        r.node = this;
+        r.element = 0;
+        if (f <= Scalar(0)) {
+            // Starting inside.
+            r.t = minT;
+            r.sdf = f;
+            r.hit = f == Scalar(0);
+            return true;
+        }
+
+        const Scalar nd = d.dot(_normal);
+        const Scalar t = nd < Scalar(0) ? minT - f / nd : maxT;
+        if (!(t < maxT)) {
+            r.t = maxT;
+            r.sdf = std::numeric_limits<Scalar>::infinity();
+            r.node = 0;
+            r.hit = false;
+            return true;
+        }
+
+        r.t = t;
+        r.sdf = 0;
+        r.hit = true;
+        return true;
+    }
+
 	void 
 	SDFPlane::accept(SDFNodeVisitor &nv)
 	{
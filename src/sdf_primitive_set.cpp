@@ -0,0 +1,141 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/sdf_primitive_set.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace volplay {
+
+    /**
+        Lower bound of the SDF of primitives contained in the box. Primitives lie within their bounds, so
+        their distance is at least the distance to the box. Nothing is known for points inside.
+    */
+    inline Scalar boxLowerBound(const Vector &x, const Vector &lower, const Vector &upper)
+    {
+        const Scalar d2 = (x - x.cwiseMax(lower).cwiseMin(upper)).squaredNorm();
+        return d2 > Scalar(0) ? std::sqrt(d2) : -std::numeric_limits<Scalar>::infinity();
+    }
+
+    SDFResult
+    SDFPrimitiveSet::fullEval(const Vector &x) const
+    {
+        int element;
+        const Scalar sdf = closest(x, -std::numeric_limits<Scalar>::infinity(), std::numeric_limits<Scalar>::max(), element);
+        SDFResult r = {this, sdf, element >= 0 ? _ids[element] : 0};
+        return r;
+    }
+
+    Scalar
+    SDFPrimitiveSet::boundedEval(const Vector &x, Scalar lower, Scalar upper) const
+    {
+        int element;
+        return closest(x, lower, std::min(upper, std::numeric_limits<Scalar>::max()), element);
+    }
+
+    int
+    SDFPrimitiveSet::size() const
+    {
+        return int(_ids.size());
+    }
+
+    Vector
+    SDFPrimitiveSet::lowerBounds() const
+    {
+        return _bvh.nodes().empty() ? Vector::Zero() : _bvh.nodes()[0].lower;
+    }
+
+    Vector
+    SDFPrimitiveSet::upperBounds() const
+    {
+        return _bvh.nodes().empty() ? Vector::Zero() : _bvh.nodes()[0].upper;
+    }
+
+    void
+    SDFPrimitiveSet::buildHierarchy(const std::vector<AlignedBox> &bounds, int leafSize)
+    {
+        const int n = int(bounds.size());
+        _ids.resize(n);
+        for (int i = 0; i < n; ++i)
+            _ids[i] = i;
+
+        _bvh.build(bounds, _ids, std::min<int>(leafSize, MaxLeafSize));
+
+        _leafIndices.resize(n);
+        for (int i = 0; i < n; ++i)
+            _leafIndices[_ids[i]] = i;
+    }
+
+    int
+    SDFPrimitiveSet::elementId(int i) const
+    {
+        return _ids[i];
+    }
+
+    int
+    SDFPrimitiveSet::leafIndex(int element) const
+    {
+        return _leafIndices[element];
+    }
+
+    Scalar
+    SDFPrimitiveSet::closest(const Vector &x, Scalar lower, Scalar upper, int &element) const
+    {
+        // Finds the smallest distance below upper. Subtrees whose bounds are farther away than the
+        // closest primitive so far are skipped, and the search ends as soon as a primitive is closer
+        // than lower.
+        typedef util::BoundingVolumeHierarchy::Node Node;
+        const std::vector<Node> &nodes = _bvh.nodes();
+
+        Scalar best = upper;
+        element = -1;
+        if (nodes.empty())
+            return best;
+
+        // Depth of the hierarchy is logarithmic due to median splits.
+        int stack[64];
+        int top = 0;
+        stack[top++] = 0;
+
+        LeafArray sdf;
+        while (top > 0 && best > lower) {
+            const Node &n = nodes[stack[--top]];
+            if (boxLowerBound(x, n.lower, n.upper) >= best)
+                continue;
+
+            if (n.count > 0) {
+                evalLeaf(x, n.first, n.count, sdf);
+                int i;
+                const Scalar d = sdf.minCoeff(&i);
+                if (d < best) {
+                    best = d;
+                    element = n.first + i;
+                }
+                continue;
+            }
+
+            // Visit nearer child first.
+            const int left = int(&n - &nodes[0]) + 1;
+            const int right = n.first;
+            const Scalar dl = boxLowerBound(x, nodes[left].lower, nodes[left].upper);
+            const Scalar dr = boxLowerBound(x, nodes[right].lower, nodes[right].upper);
+            if (dl < dr) {
+                if (dr < best) stack[top++] = right;
+                if (dl < best) stack[top++] = left;
+            } else {
+                if (dl < best) stack[top++] = left;
+                if (dr < best) stack[top++] = right;
+            }
+        }
+
+        return best;
+    }
+
+}
@@ -46,18 +46,77 @@ namespace volplay {
                arg != -std::numeric_limits<T>::infinity();
     }
     
+    /** Fold position into the centered cell. */
+    inline Vector foldIntoCell(const Vector &x, const Vector &cellSizes)
+    {
+        const Vector halfCell = cellSizes / 2;
+		
+		return Vector(
+			isfinite(cellSizes(0)) ? (fmod(fabs(x(0)) + halfCell(0), cellSizes(0)) - halfCell(0)) : x(0),
+			isfinite(cellSizes(1)) ? (fmod(fabs(x(1)) + halfCell(1), cellSizes(1)) - halfCell(1)) : x(1),
+			isfinite(cellSizes(2)) ? (fmod(fabs(x(2)) + halfCell(2), cellSizes(2)) - halfCell(2)) : x(2)
+		);
+    }
+    
     SDFResult
     SDFRepetition::fullEval(const Vector &x) const
     {      
+        return SDFUnion::fullEval(foldIntoCell(x, _cellSizes));
+    }
+
+    Scalar
+    SDFRepetition::boundedEval(const Vector &x, Scalar lower, Scalar upper) const
+    {      
+        return SDFUnion::boundedEval(foldIntoCell(x, _cellSizes), lower, upper);
+    }
+
+    Scalar
+    SDFRepetition::safeEval(const Vector &x) const
+    {      
+        return SDFUnion::safeEval(foldIntoCell(x, _cellSizes));
+    }
+
+    math::Interval
+    SDFRepetition::evalInterval(const AlignedBox &box) const
+    {
         const Vector halfCell = _cellSizes / 2;
-		
-		const Vector modX(
-			isfinite(_cellSizes(0)) ? (fmod(fabs(x(0)) + halfCell(0), _cellSizes(0)) - halfCell(0)) : x(0),
-			isfinite(_cellSizes(1)) ? (fmod(fabs(x(1)) + halfCell(1), _cellSizes(1)) - halfCell(1)) : x(1),
-			isfinite(_cellSizes(2)) ? (fmod(fabs(x(2)) + halfCell(2), _cellSizes(2)) - halfCell(2)) : x(2)
-		);
         
-        return SDFUnion::fullEval(modX);
+        // Fold the range of absolute coordinates per axis. Ranges wrapping around the cell boundary 
+        // are widened to the entire cell.
+        Vector lower = box.min();
+        Vector upper = box.max();
+        for (int i = 0; i < 3; ++i) {
+            if (!isfinite(_cellSizes(i)))
+                continue;
+
+            const Scalar absMin = (box.min()(i) <= 0 && box.max()(i) >= 0) ? Scalar(0) : std::min(fabs(box.min()(i)), fabs(box.max()(i)));
+            const Scalar absMax = std::max(fabs(box.min()(i)), fabs(box.max()(i)));
+            lower(i) = fmod(absMin + halfCell(i), _cellSizes(i)) - halfCell(i);
+            upper(i) = lower(i) + (absMax - absMin);
+            if (upper(i) > halfCell(i)) {
+                lower(i) = -halfCell(i);
+                upper(i) = halfCell(i);
+            }
+        }
+        return SDFUnion::evalInterval(AlignedBox(lower, upper));
+    }
+
+    Scalar
+    SDFRepetition::segmentLipschitz(const Vector &, const Vector &) const
+    {
+        return lipschitz();
+    }
+
+    bool
+    SDFRepetition::intersectRay(const Vector &, const Vector &, Scalar, Scalar, TraceResult &) const
+    {
+        return false;
+    }
+
+    Scalar
+    SDFRepetition::trace(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr) const
+    {
+        return SDFNode::trace(o, d, opts, tr);
     }
 
 	void
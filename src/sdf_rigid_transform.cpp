@@ -9,19 +9,30 @@
 
 #include <volplay/sdf_rigid_transform.h>
 #include <volplay/sdf_node_visitor.h>
+#include <Eigen/SVD>
+#include <cmath>
 
 namespace volplay {
+
+    /** Largest factor by which the transform stretches distances. */
+    inline Scalar maxStretch(const AffineTransform &t)
+    {
+        Eigen::JacobiSVD<Eigen::Matrix<Scalar, 3, 3> > svd(t.linear());
+        const Scalar s = svd.singularValues()(0);
+        // Snap rigid transforms to exactly one to keep tracing unaffected by round-off.
+        return std::abs(s - Scalar(1)) < Scalar(1e-5) ? Scalar(1) : s;
+    }
     
     SDFRigidTransform::SDFRigidTransform()
-    : _worldToLocal(AffineTransform::Identity())
+    : _worldToLocal(AffineTransform::Identity()), _scale(1)
     {}
     
     SDFRigidTransform::SDFRigidTransform(const AffineTransform &t)
-    : _worldToLocal(t.inverse())
+    : _worldToLocal(t.inverse()), _scale(maxStretch(_worldToLocal))
     {}
     
     SDFRigidTransform::SDFRigidTransform(const AffineTransform &t, const SDFNodePtr &n)
-    : _worldToLocal(t.inverse())
+    : _worldToLocal(t.inverse()), _scale(maxStretch(_worldToLocal))
     {
 		this->add(n);
 	}
@@ -42,6 +53,7 @@ namespace volplay {
     SDFRigidTransform::setLocalToWorld(const AffineTransform &t)
     {
         _worldToLocal = t.inverse();
+        _scale = maxStretch(_worldToLocal);
     }
 
     
@@ -51,6 +63,54 @@ namespace volplay {
         return SDFUnion::fullEval(_worldToLocal * x);
     }
     
+    Scalar
+    SDFRigidTransform::boundedEval(const Vector &x, Scalar lower, Scalar upper) const
+    {
+        return SDFUnion::boundedEval(_worldToLocal * x, lower, upper);
+    }
+    
+    math::Interval
+    SDFRigidTransform::evalInterval(const AlignedBox &box) const
+    {
+        const Vector c = _worldToLocal * box.center();
+        const Vector h = _worldToLocal.linear().cwiseAbs() * (box.sizes() * Scalar(0.5));
+        return SDFUnion::evalInterval(AlignedBox(c - h, c + h));
+    }
+
+    Scalar
+    SDFRigidTransform::lipschitz() const
+    {
+        return _scale * SDFUnion::lipschitz();
+    }
+
+    Scalar
+    SDFRigidTransform::safeEval(const Vector &x) const
+    {
+        return SDFUnion::safeEval(_worldToLocal * x) / _scale;
+    }
+
+    Scalar
+    SDFRigidTransform::segmentLipschitz(const Vector &a, const Vector &b) const
+    {
+        // The rate of change along the segment is the rate along the transformed segment 
+        // times the stretch of the segment direction.
+        const Vector u = (b - a).normalized();
+        return SDFUnion::segmentLipschitz(_worldToLocal * a, _worldToLocal * b) * (_worldToLocal.linear() * u).norm();
+    }
+
+    bool
+    SDFRigidTransform::intersectRay(const Vector &o, const Vector &d, Scalar minT, Scalar maxT, TraceResult &r) const
+    {
+        // Affine maps preserve the ray parameterization.
+        return SDFUnion::intersectRay(_worldToLocal * o, _worldToLocal.linear() * d, minT, maxT, r);
+    }
+
+    Scalar
+    SDFRigidTransform::trace(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr) const
+    {
+        return SDFNode::trace(o, d, opts, tr);
+    }
+
 	void 
 	SDFRigidTransform::accept(SDFNodeVisitor &nv)
 	{
@@ -9,6 +9,9 @@
 
 #include <volplay/sdf_sphere.h>
 #include <volplay/sdf_node_visitor.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace volplay {
     
@@ -27,6 +30,71 @@ namespace volplay {
         return r;
     }
 
+    Scalar
+    SDFSphere::boundedEval(const Vector &x, Scalar, Scalar) const
+    {
+        return x.norm() - _radius;
+    }
+
+    math::Interval
+    SDFSphere::evalInterval(const AlignedBox &box) const
+    {
+        // Closest and farthest points of the box to the origin.
+        const Vector closest = Vector::Zero().cwiseMax(box.min()).cwiseMin(box.max());
+        const Vector farthest = box.min().cwiseAbs().cwiseMax(box.max().cwiseAbs());
+        return math::Interval(closest.norm() - _radius, farthest.norm() - _radius);
+    }
+
+    Scalar
+    SDFSphere::segmentLipschitz(const Vector &a, const Vector &b) const
+    {
+        // The rate of change along the segment is the cosine between the segment and the 
+        // direction to the origin. Its magnitude is smallest at the point closest to the origin 
+        // and increases towards both sides, so it is largest at either end.
+        const Vector u = (b - a).normalized();
+        const Scalar na = a.norm();
+        const Scalar nb = b.norm();
+        if (na == Scalar(0) || nb == Scalar(0))
+            return Scalar(1);
+        return std::max(std::abs(a.dot(u)) / na, std::abs(b.dot(u)) / nb);
+    }
+
+    bool
+    SDFSphere::intersectRay(const Vector &o, const Vector &d, Scalar minT, Scalar maxT, TraceResult &r) const
+    {
+        const Vector p = o + minT * d;
+        const Scalar f = p.norm() - _radius;
+
+        r.iter = 0;
+        r.node = this;
+        r.element = 0;
+        if (f <= Scalar(0)) {
+            // Starting inside.
+            r.t = minT;
+            r.sdf = f;
+            r.hit = f == Scalar(0);
+            return true;
+        }
+
+        // Smaller root of |p + s * d| = radius, if the ray approaches the sphere.
+        const Scalar b = p.dot(d);
+        const Scalar a = d.squaredNorm();
+        const Scalar disc = b * b - a * (p.squaredNorm() - _radius * _radius);
+        const Scalar t = disc >= Scalar(0) && b < Scalar(0) ? minT + (-b - std::sqrt(disc)) / a : maxT;
+        if (!(t < maxT)) {
+            r.t = maxT;
+            r.sdf = std::numeric_limits<Scalar>::infinity();
+            r.node = 0;
+            r.hit = false;
+            return true;
+        }
+
+        r.t = t;
+        r.sdf = 0;
+        r.hit = true;
+        return true;
+    }
+
 	void SDFSphere::accept(SDFNodeVisitor &nv)
 	{
 		nv.visit(this);
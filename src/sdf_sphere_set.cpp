@@ -0,0 +1,64 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/sdf_sphere_set.h>
+#include <volplay/sdf_node_visitor.h>
+#include <algorithm>
+
+namespace volplay {
+
+    SDFSphereSet::SDFSphereSet(const std::vector<Vector> &centers, const std::vector<Scalar> &radii, int leafSize)
+    {
+        const int n = int(std::min(centers.size(), radii.size()));
+
+        std::vector<AlignedBox> bounds(n);
+        for (int i = 0; i < n; ++i)
+            bounds[i] = AlignedBox(centers[i] - Vector::Constant(radii[i]), centers[i] + Vector::Constant(radii[i]));
+        buildHierarchy(bounds, leafSize);
+
+        _cx.resize(n);
+        _cy.resize(n);
+        _cz.resize(n);
+        _radii.resize(n);
+        for (int i = 0; i < n; ++i) {
+            const int e = elementId(i);
+            _cx(i) = centers[e].x();
+            _cy(i) = centers[e].y();
+            _cz(i) = centers[e].z();
+            _radii(i) = radii[e];
+        }
+    }
+
+    Vector
+    SDFSphereSet::center(int i) const
+    {
+        const int p = leafIndex(i);
+        return Vector(_cx(p), _cy(p), _cz(p));
+    }
+
+    Scalar
+    SDFSphereSet::radius(int i) const
+    {
+        return _radii(leafIndex(i));
+    }
+
+    void
+    SDFSphereSet::evalLeaf(const Vector &x, int first, int count, LeafArray &sdf) const
+    {
+        sdf = ((_cx.segment(first, count) - x.x()).square() +
+               (_cy.segment(first, count) - x.y()).square() +
+               (_cz.segment(first, count) - x.z()).square()).sqrt() - _radii.segment(first, count);
+    }
+
+	void SDFSphereSet::accept(SDFNodeVisitor &nv)
+	{
+		nv.visit(this);
+	}
+
+}
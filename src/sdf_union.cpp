@@ -10,6 +10,9 @@
 #include <volplay/sdf_union.h>
 #include <volplay/util/iterator_range.h>
 #include <volplay/sdf_node_visitor.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 namespace volplay {
     
@@ -22,20 +25,236 @@ namespace volplay {
         this->add(right);
     }
     
+    /** 
+        Children of a union, optionally restricted to the given positions. Allows to evaluate parts of 
+        a union without copying its children.
+    */
+    class UnionChildren {
+    public:
+        UnionChildren(const SDFGroup &g)
+            : _nodes(g.size() > 0 ? &*g.begin() : 0), _indices(0), _count(int(g.size()))
+        {}
+
+        UnionChildren(const SDFGroup &g, const int *indices, int count)
+            : _nodes(g.size() > 0 ? &*g.begin() : 0), _indices(indices), _count(count)
+        {}
+
+        int size() const { return _count; }
+        const SDFNode &operator[](int i) const { return *_nodes[_indices ? _indices[i] : i]; }
+
+    private:
+        const SDFNodePtr *_nodes;
+        const int *_indices;
+        int _count;
+    };
+
+    static SDFResult unionFullEval(const UnionChildren &c, const Vector &x)
+    {
+        SDFResult r = c[0].fullEval(x);
+        for (int i = 1; i < c.size(); ++i) {
+            SDFResult o = c[i].fullEval(x);
+            r = r.sdf < o.sdf ? r : o;            
+        }
+        return r;
+    }
+
+    static Scalar unionBoundedEval(const UnionChildren &c, const Vector &x, Scalar lower, Scalar upper)
+    {
+        // Children only matter below the smallest value seen so far.
+        Scalar r = c[0].boundedEval(x, lower, upper);
+        for (int i = 1; i < c.size() && r > lower; ++i) {
+            r = std::min(r, c[i].boundedEval(x, lower, std::min(upper, r)));
+        }
+        return r;
+    }
+
+    static math::Interval unionEvalInterval(const UnionChildren &c, const AlignedBox &box)
+    {
+        math::Interval r = c[0].evalInterval(box);
+        for (int i = 1; i < c.size(); ++i) {
+            r = math::min(r, c[i].evalInterval(box));
+        }
+        return r;
+    }
+
+    static Scalar unionSafeEval(const UnionChildren &c, const Vector &x)
+    {
+        Scalar r = c[0].safeEval(x);
+        for (int i = 1; i < c.size(); ++i) {
+            r = std::min(r, c[i].safeEval(x));
+        }
+        return r;
+    }
+
+    static Scalar unionSegmentLipschitz(const UnionChildren &c, const Vector &a, const Vector &b)
+    {
+        // Children whose lower bound along the segment exceeds the upper bound of another
+        // child are never closest on the segment and do not affect the rate of change. Global 
+        // bounds give a lower bound of each child before recursing, so children are evaluated 
+        // only up to where they could still be closest and culled ones are not descended into.
+        const Scalar length = (b - a).norm();
+        std::vector< std::pair<Scalar, Scalar> > bounds;
+        bounds.reserve(c.size());
+        
+        Scalar upper = std::numeric_limits<Scalar>::infinity();
+        for (int i = 0; i < c.size(); ++i) {
+            const Scalar cap = upper + c[i].lipschitz() * length;
+            const Scalar f = c[i].boundedEval(a, -std::numeric_limits<Scalar>::infinity(), cap);
+            if (f >= cap)
+                continue;
+
+            const Scalar l = c[i].segmentLipschitz(a, b);
+            bounds.push_back(std::make_pair(f - l * length, l));
+            upper = std::min(upper, f + l * length);
+        }
+        
+        Scalar l(0);
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            if (bounds[i].first <= upper)
+                l = std::max(l, bounds[i].second);
+        }
+        return l;
+    }
+
+    /** Union of some children of another union. Used to trace children separately. */
+    class UnionPart : public SDFNode {
+    public:
+        UnionPart(const UnionChildren &c)
+            : _c(c)
+        {}
+
+        virtual SDFResult fullEval(const Vector &x) const { return unionFullEval(_c, x); }
+        virtual Scalar boundedEval(const Vector &x, Scalar lower, Scalar upper) const { return unionBoundedEval(_c, x, lower, upper); }
+        virtual math::Interval evalInterval(const AlignedBox &box) const { return unionEvalInterval(_c, box); }
+        virtual Scalar safeEval(const Vector &x) const { return unionSafeEval(_c, x); }
+        virtual Scalar segmentLipschitz(const Vector &a, const Vector &b) const { return unionSegmentLipschitz(_c, a, b); }
+
+        virtual Scalar lipschitz() const
+        {
+            Scalar l = _c[0].lipschitz();
+            for (int i = 1; i < _c.size(); ++i)
+                l = std::max(l, _c[i].lipschitz());
+            return l;
+        }
+
+    private:
+        UnionChildren _c;
+    };
+
     SDFResult
     SDFUnion::fullEval(const Vector &x) const
     {
         assert(this->size() > 0);
+        return unionFullEval(UnionChildren(*this), x);
+    }
+
+    Scalar
+    SDFUnion::boundedEval(const Vector &x, Scalar lower, Scalar upper) const
+    {
+        assert(this->size() > 0);
+        return unionBoundedEval(UnionChildren(*this), x, lower, upper);
+    }
+
+    math::Interval
+    SDFUnion::evalInterval(const AlignedBox &box) const
+    {
+        assert(this->size() > 0);
+        return unionEvalInterval(UnionChildren(*this), box);
+    }
+
+    Scalar
+    SDFUnion::safeEval(const Vector &x) const
+    {
+        assert(this->size() > 0);
+        return unionSafeEval(UnionChildren(*this), x);
+    }
+
+    Scalar
+    SDFUnion::segmentLipschitz(const Vector &a, const Vector &b) const
+    {
+        assert(this->size() > 0);
+        return unionSegmentLipschitz(UnionChildren(*this), a, b);
+    }
+
+    /** Test if an exact ray intersection comes before another one. */
+    inline bool closerIntersection(const SDFNode::TraceResult &a, const SDFNode::TraceResult &b)
+    {
+        return a.t < b.t || (a.t == b.t && a.sdf < b.sdf);
+    }
+
+    bool
+    SDFUnion::intersectRay(const Vector &o, const Vector &d, Scalar minT, Scalar maxT, TraceResult &r) const
+    {
+        r.iter = 0;
+        r.t = maxT;
+        r.sdf = std::numeric_limits<Scalar>::infinity();
+        r.node = 0;
+        r.element = 0;
+        r.hit = false;
         
-        SDFGroup::SDFNodeArray::const_iterator i = this->begin();
+        for (SDFGroup::SDFNodeArray::const_iterator i = this->begin(); i != this->end(); ++i) {
+            TraceResult c;
+            if (!(*i)->intersectRay(o, d, minT, r.t, c))
+                return false;
+            if (closerIntersection(c, r))
+                r = c;
+        }
         
-        SDFResult r = (*i)->fullEval(x);
-        for (++i; i != this->end(); ++i) {
-            SDFResult o = (*i)->fullEval(x);
-            r = r.sdf < o.sdf ? r : o;            
+        return true;
+    }
+
+    Scalar
+    SDFUnion::trace(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr) const
+    {
+        if (!opts.exactIntersections)
+            return SDFNode::trace(o, d, opts, tr);
+        
+        TraceResult exact;
+        exact.t = opts.maxT;
+        exact.sdf = std::numeric_limits<Scalar>::infinity();
+        exact.node = 0;
+        exact.element = 0;
+        exact.hit = false;
+        
+        // Positions of children without closed form intersections. Small unions avoid allocations.
+        const int n = int(this->size());
+        int fixed[32];
+        std::vector<int> dynamic;
+        int *marched = fixed;
+        if (n > 32) {
+            dynamic.resize(n);
+            marched = &dynamic[0];
+        }
+
+        int nMarched = 0;
+        for (int i = 0; i < n; ++i) {
+            TraceResult c;
+            const SDFNode &child = **(this->begin() + i);
+            if (!child.intersectRay(o, d, opts.minT, exact.t, c))
+                marched[nMarched++] = i;
+            else if (closerIntersection(c, exact))
+                exact = c;
         }
         
-        return r;
+        if (nMarched == n)
+            return SDFNode::trace(o, d, opts, tr);
+        
+        // March the remaining children up to the closest exact intersection. Marching may end 
+        // early without a hit, which does not rule out the exact intersection.
+        if (nMarched > 0) {
+            TraceOptions marchOpts = opts;
+            marchOpts.maxT = exact.t;
+            marchOpts.exactIntersections = false;
+            
+            TraceResult m;
+            UnionPart(UnionChildren(*this, marched, nMarched)).trace(o, d, marchOpts, &m);
+            if (m.hit && (m.t < exact.t || !exact.hit))
+                exact = m;
+        }
+        
+        if (tr)
+            *tr = exact;
+        return exact.t;
     }
 
 	void
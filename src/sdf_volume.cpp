@@ -0,0 +1,233 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/sdf_volume.h>
+#include <volplay/sdf_node_visitor.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <limits>
+
+namespace volplay {
+
+    static const char volumeMagic[4] = {'V', 'P', 'V', 'L'};
+    static const int volumeVersion = 1;
+
+    /** Fixed size header of volume files. */
+    struct VolumeHeader {
+        char magic[4];
+        int version;
+        int dims[3];
+        float origin[3];
+        float spacing[3];
+        int brickSize;
+    };
+
+    /** Returns log2 of a power of two or -1 otherwise. */
+    static int powerOfTwoShift(int n)
+    {
+        int shift = 0;
+        while (shift < 30 && (1 << shift) < n)
+            ++shift;
+        return (n > 0 && (1 << shift) == n) ? shift : -1;
+    }
+
+    SDFVolume::SDFVolume()
+        : _samples(0), _dims(Index::Zero()), _bricks(Index::Zero()),
+          _origin(Vector::Zero()), _spacing(Vector::Ones()), _brickSize(0), _brickShift(0)
+    {}
+
+    bool SDFVolume::open(const std::string &filename)
+    {
+        _samples = 0;
+
+        if (!_file.open(filename))
+            return false;
+
+        VolumeHeader h;
+        if (_file.size() < sizeof(h)) {
+            _file.close();
+            return false;
+        }
+        memcpy(&h, _file.data(), sizeof(h));
+
+        const int shift = h.brickSize == 0 ? 0 : powerOfTwoShift(h.brickSize);
+        const Index dims(h.dims[0], h.dims[1], h.dims[2]);
+        if (!std::equal(h.magic, h.magic + 4, volumeMagic) || h.version != volumeVersion ||
+            shift < 0 || dims.minCoeff() < 2)
+        {
+            _file.close();
+            return false;
+        }
+
+        // Bricked volumes are padded to whole bricks.
+        Index stored = dims;
+        if (h.brickSize > 0)
+            stored = ((dims.array() + (h.brickSize - 1)) / h.brickSize * h.brickSize).matrix();
+
+        const size_t expected = sizeof(h) + size_t(stored.x()) * size_t(stored.y()) * size_t(stored.z()) * sizeof(float);
+        if (_file.size() != expected) {
+            _file.close();
+            return false;
+        }
+
+        _dims = dims;
+        _brickSize = h.brickSize;
+        _brickShift = shift;
+        _bricks = h.brickSize > 0 ? Index(stored / h.brickSize) : Index::Zero();
+        _origin = Vector(h.origin[0], h.origin[1], h.origin[2]);
+        _spacing = Vector(h.spacing[0], h.spacing[1], h.spacing[2]);
+
+        // Samples follow the header without padding. The header size is a multiple of four bytes
+        // and mapped memory is page aligned, so samples are properly aligned.
+        _samples = reinterpret_cast<const float *>(_file.data() + sizeof(h));
+        return true;
+    }
+
+    bool SDFVolume::isOpen() const
+    {
+        return _samples != 0;
+    }
+
+    const Index &SDFVolume::dimensions() const
+    {
+        return _dims;
+    }
+
+    const Vector &SDFVolume::origin() const
+    {
+        return _origin;
+    }
+
+    const Vector &SDFVolume::spacing() const
+    {
+        return _spacing;
+    }
+
+    int SDFVolume::brickSize() const
+    {
+        return _brickSize;
+    }
+
+    inline size_t SDFVolume::offset(int x, int y, int z) const
+    {
+        if (_brickSize == 0)
+            return (size_t(z) * size_t(_dims.y()) + size_t(y)) * size_t(_dims.x()) + size_t(x);
+
+        const int mask = _brickSize - 1;
+        const size_t brick = (size_t(z >> _brickShift) * size_t(_bricks.y()) + size_t(y >> _brickShift)) * size_t(_bricks.x()) + size_t(x >> _brickShift);
+        const size_t local = (size_t(((z & mask) << _brickShift) + (y & mask)) << _brickShift) + size_t(x & mask);
+        return (brick << (3 * _brickShift)) + local;
+    }
+
+    Scalar SDFVolume::sample(const Index &i) const
+    {
+        return Scalar(_samples[offset(i.x(), i.y(), i.z())]);
+    }
+
+    SDFResult
+    SDFVolume::fullEval(const Vector &x) const
+    {
+        SDFResult r = {this, std::numeric_limits<Scalar>::max()};
+        if (!isOpen())
+            return r;
+
+        // Continuous grid coordinates clamped to the grid.
+        const Vector p = ((x - _origin).array() / _spacing.array()).matrix();
+        const Vector maxp = (_dims.array() - 1).cast<Scalar>().matrix();
+        const Vector pc = p.cwiseMax(Vector::Zero()).cwiseMin(maxp);
+        const Scalar outside = ((p - pc).array() * _spacing.array()).matrix().norm();
+
+        const Index i = pc.array().floor().cast<Index::Scalar>().matrix().cwiseMin(_dims - Index::Constant(2));
+        const Vector t = pc - i.cast<Scalar>();
+
+        const float c000 = _samples[offset(i.x(),     i.y(),     i.z())];
+        const float c100 = _samples[offset(i.x() + 1, i.y(),     i.z())];
+        const float c010 = _samples[offset(i.x(),     i.y() + 1, i.z())];
+        const float c110 = _samples[offset(i.x() + 1, i.y() + 1, i.z())];
+        const float c001 = _samples[offset(i.x(),     i.y(),     i.z() + 1)];
+        const float c101 = _samples[offset(i.x() + 1, i.y(),     i.z() + 1)];
+        const float c011 = _samples[offset(i.x(),     i.y() + 1, i.z() + 1)];
+        const float c111 = _samples[offset(i.x() + 1, i.y() + 1, i.z() + 1)];
+
+        const Scalar c00 = c000 + (c100 - c000) * t.x();
+        const Scalar c10 = c010 + (c110 - c010) * t.x();
+        const Scalar c01 = c001 + (c101 - c001) * t.x();
+        const Scalar c11 = c011 + (c111 - c011) * t.x();
+        const Scalar c0 = c00 + (c10 - c00) * t.y();
+        const Scalar c1 = c01 + (c11 - c01) * t.y();
+
+        r.sdf = c0 + (c1 - c0) * t.z() + outside;
+        return r;
+    }
+
+	void SDFVolume::accept(SDFNodeVisitor &nv)
+	{
+		nv.visit(this);
+	}
+
+    bool SDFVolume::write(
+        const std::string &filename,
+        const Index &dims, const Vector &origin, const Vector &spacing,
+        const std::vector<float> &samples,
+        int brickSize)
+    {
+        const int shift = brickSize == 0 ? 0 : powerOfTwoShift(brickSize);
+        if (shift < 0 || dims.minCoeff() < 2 || samples.size() != size_t(dims.x()) * size_t(dims.y()) * size_t(dims.z()))
+            return false;
+
+        FILE *f = fopen(filename.c_str(), "wb");
+        if (f == 0)
+            return false;
+
+        VolumeHeader h;
+        memset(&h, 0, sizeof(h));
+        std::copy(volumeMagic, volumeMagic + 4, h.magic);
+        h.version = volumeVersion;
+        for (int i = 0; i < 3; ++i) {
+            h.dims[i] = dims(i);
+            h.origin[i] = float(origin(i));
+            h.spacing[i] = float(spacing(i));
+        }
+        h.brickSize = brickSize;
+
+        bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+
+        if (ok && brickSize == 0) {
+            ok = fwrite(&samples[0], sizeof(float), samples.size(), f) == samples.size();
+        } else if (ok) {
+            // Bricks in raw order, samples within bricks likewise. Padding repeats the border.
+            const Index bricks = ((dims.array() + (brickSize - 1)) / brickSize).matrix();
+            std::vector<float> brick(size_t(brickSize) * brickSize * brickSize);
+
+            for (int bz = 0; ok && bz < bricks.z(); ++bz) {
+                for (int by = 0; ok && by < bricks.y(); ++by) {
+                    for (int bx = 0; ok && bx < bricks.x(); ++bx) {
+                        size_t n = 0;
+                        for (int z = 0; z < brickSize; ++z) {
+                            const int gz = std::min<int>(bz * brickSize + z, dims.z() - 1);
+                            for (int y = 0; y < brickSize; ++y) {
+                                const int gy = std::min<int>(by * brickSize + y, dims.y() - 1);
+                                for (int x = 0; x < brickSize; ++x) {
+                                    const int gx = std::min<int>(bx * brickSize + x, dims.x() - 1);
+                                    brick[n++] = samples[(size_t(gz) * dims.y() + gy) * dims.x() + gx];
+                                }
+                            }
+                        }
+                        ok = fwrite(&brick[0], sizeof(float), brick.size(), f) == brick.size();
+                    }
+                }
+            }
+        }
+
+        fclose(f);
+        return ok;
+    }
+
+}
@@ -0,0 +1,174 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/surface/block_grid.h>
+#include <volplay/surface/indexed_surface.h>
+#include <volplay/sdf_node.h>
+#include <volplay/util/parallel.h>
+#include <algorithm>
+
+namespace volplay {
+
+    namespace surface {
+
+        BlockGrid::BlockGrid(const Index &lower, const Index &upper, int blockSize)
+            : _lower(lower), _upper(upper), _blockSize(std::max<int>(1, blockSize))
+        {
+            for (int i = 0; i < 3; ++i) {
+                const int voxels = std::max<int>(1, upper(i) - lower(i));
+                _nblocks(i) = (voxels + _blockSize - 1) / _blockSize;
+            }
+        }
+
+        int BlockGrid::size() const
+        {
+            return _nblocks.prod();
+        }
+
+        const Index &BlockGrid::lower() const
+        {
+            return _lower;
+        }
+
+        const Index &BlockGrid::upper() const
+        {
+            return _upper;
+        }
+
+        Index BlockGrid::blockLower(int b) const
+        {
+            const Index bc(b % _nblocks.x(), (b / _nblocks.x()) % _nblocks.y(), b / (_nblocks.x() * _nblocks.y()));
+            return _lower + bc * _blockSize;
+        }
+
+        Index BlockGrid::blockUpper(int b) const
+        {
+            return (blockLower(b) + Index::Constant(_blockSize)).cwiseMin(_upper);
+        }
+
+        Index BlockGrid::ownedUpper(int b) const
+        {
+            Index u = blockUpper(b);
+            for (int i = 0; i < 3; ++i) {
+                if (u(i) < _upper(i))
+                    u(i) -= 1;
+            }
+            return u;
+        }
+
+        int BlockGrid::owner(const Index &c) const
+        {
+            Index bc;
+            for (int i = 0; i < 3; ++i)
+                bc(i) = std::min<int>((c(i) - _lower(i)) / _blockSize, _nblocks(i) - 1);
+            return (bc.z() * _nblocks.y() + bc.y()) * _nblocks.x() + bc.x();
+        }
+
+        bool BlockGrid::contains(const Index &c) const
+        {
+            return (c.array() >= _lower.array()).all() && (c.array() <= _upper.array()).all();
+        }
+
+        bool BlockGrid::isEmpty(int b, const SDFNode &scene, const AffineTransform &toWorld, Scalar iso) const
+        {
+            const Vector l = toWorld * blockLower(b).cast<Scalar>();
+            const Vector u = toWorld * blockUpper(b).cast<Scalar>();
+            
+            const Scalar d = scene.eval((l + u) * Scalar(0.5)) - iso;
+            return std::abs(d) > (u - l).norm() * Scalar(0.5);
+        }
+
+        void BlockSamples::sample(const SDFNode &scene, const AffineTransform &toWorld, const Index &lower, const Index &upper, Scalar iso)
+        {
+            _lower = lower;
+            _dims = upper - lower + Index::Ones();
+            _samples.resize(_dims.prod());
+
+            Scalar *dst = &_samples[0];
+            for (int z = lower.z(); z <= upper.z(); ++z) {
+                for (int y = lower.y(); y <= upper.y(); ++y) {
+                    for (int x = lower.x(); x <= upper.x(); ++x) {
+                        *dst++ = scene.eval(toWorld * Vector(Scalar(x), Scalar(y), Scalar(z))) - iso;
+                    }
+                }
+            }
+        }
+
+        void BlockSamples::clear()
+        {
+            std::vector<Scalar>().swap(_samples);
+        }
+
+        void BlockMesh::reset(const Index &lower, const Index &upper, int subs)
+        {
+            _lower = lower;
+            _dims = upper - lower + Index::Ones();
+            _subs = subs;
+            keys.clear();
+            vertices.clear();
+            triangles.clear();
+        }
+
+        int BlockMesh::find(const Index &c, int sub) const
+        {
+            const int k = key(c, sub);
+            std::vector<int>::const_iterator i = std::lower_bound(keys.begin(), keys.end(), k);
+            return (i != keys.end() && *i == k) ? int(i - keys.begin()) : -1;
+        }
+
+        void assembleBlocks(const BlockGrid &grid, const std::vector<BlockMesh> &blocks, IndexedSurface &surface)
+        {
+            const int n = int(blocks.size());
+
+            std::vector<int> vertexOffsets(n + 1, 0);
+            for (int b = 0; b < n; ++b)
+                vertexOffsets[b + 1] = vertexOffsets[b] + int(blocks[b].vertices.size());
+
+            // Resolve references first, as triangles with unresolved references are dropped.
+            std::vector< std::vector<Index::Scalar> > faces(n);
+            util::parallelFor(0, n, [&](int b) {
+                const BlockMesh &m = blocks[b];
+                std::vector<Index::Scalar> &f = faces[b];
+                f.reserve(m.triangles.size());
+
+                for (size_t t = 0; t + 2 < m.triangles.size(); t += 3) {
+                    Index::Scalar ids[3];
+                    bool resolved = true;
+                    for (int k = 0; k < 3 && resolved; ++k) {
+                        const BlockVertexRef &r = m.triangles[t + k];
+                        const int o = grid.owner(r.corner);
+                        const int local = blocks[o].find(r.corner, r.sub);
+                        resolved = local >= 0;
+                        ids[k] = vertexOffsets[o] + local;
+                    }
+                    if (resolved)
+                        f.insert(f.end(), ids, ids + 3);
+                }
+            });
+
+            std::vector<int> triangleOffsets(n + 1, 0);
+            for (int b = 0; b < n; ++b)
+                triangleOffsets[b + 1] = triangleOffsets[b] + int(faces[b].size() / 3);
+
+            surface.vertices.resize(3, vertexOffsets[n]);
+            surface.faces.resize(3, triangleOffsets[n]);
+
+            util::parallelFor(0, n, [&](int b) {
+                const BlockMesh &m = blocks[b];
+
+                for (size_t i = 0; i < m.vertices.size(); ++i)
+                    surface.vertices.col(vertexOffsets[b] + i) = m.vertices[i];
+
+                for (size_t i = 0; i < faces[b].size(); ++i)
+                    surface.faces(i % 3, triangleOffsets[b] + i / 3) = faces[b][i];
+            });
+        }
+
+    }
+}
@@ -0,0 +1,421 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/surface/chunk_manager.h>
+#include <volplay/surface/indexed_surface.h>
+#include <volplay/surface/block_grid.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace volplay {
+
+    namespace surface {
+
+        ChunkManager::ChunkKey::ChunkKey()
+            : coords(Index::Zero()), level(0)
+        {}
+
+        ChunkManager::ChunkKey::ChunkKey(const Index &coords_, int level_)
+            : coords(coords_), level(level_)
+        {}
+
+        /** Offset of the n-th of the eight chunks in the unit cube spanned by a chunk. */
+        static Index cubeOffset(int n)
+        {
+            return Index(n & 1, (n >> 1) & 1, n >> 2);
+        }
+
+        /** Coordinates of the chunk containing voxel, given the voxels per chunk of its level. */
+        static Index chunkOf(const Index &voxel, int voxels)
+        {
+            Index c;
+            for (int i = 0; i < 3; ++i)
+                c(i) = voxel(i) >= 0 ? voxel(i) / voxels : -((voxels - 1 - voxel(i)) / voxels);
+            return c;
+        }
+
+        bool ChunkManager::ChunkKey::operator<(const ChunkKey &other) const
+        {
+            for (int i = 0; i < 3; ++i) {
+                if (coords(i) != other.coords(i))
+                    return coords(i) < other.coords(i);
+            }
+            return level < other.level;
+        }
+
+        ChunkManager::ChunkManager(SDFNodePtr scene, Scalar chunkLength, int voxelsPerChunk, int workers)
+            : _scene(scene),
+              _chunkLength(chunkLength),
+              _voxelsPerChunk(std::max<int>(1, voxelsPerChunk)),
+              _computeType(DualContouring::COMPUTE_NONLINEAR_DC),
+              _radius(chunkLength),
+              _lodDistance(std::numeric_limits<Scalar>::infinity()),
+              _maxLevel(0),
+              _budget(std::numeric_limits<size_t>::max()),
+              _bytes(0),
+              _busy(0),
+              _tick(0),
+              _resolves(0),
+              _stop(false)
+        {
+            for (int i = 0; i < std::max<int>(1, workers); ++i)
+                _workers.push_back(std::thread(&ChunkManager::work, this));
+        }
+
+        ChunkManager::~ChunkManager()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+                _queue.clear();
+            }
+            _queueChanged.notify_all();
+
+            for (size_t i = 0; i < _workers.size(); ++i)
+                _workers[i].join();
+        }
+
+        void ChunkManager::setExtractor(const DualContouring &dc, DualContouring::EComputeType et)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _dc = dc;
+            _computeType = et;
+        }
+
+        void ChunkManager::setViewRadius(Scalar r)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _radius = r;
+        }
+
+        void ChunkManager::setLevelOfDetail(Scalar distance, int maxLevel)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _lodDistance = distance;
+            _maxLevel = std::max<int>(0, maxLevel);
+        }
+
+        void ChunkManager::setMemoryBudget(size_t bytes)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _budget = bytes;
+            evict();
+        }
+
+        Vector ChunkManager::chunkLower(const Index &coords) const
+        {
+            return coords.cast<Scalar>() * _chunkLength;
+        }
+
+        int ChunkManager::levelFor(const Index &coords, const Vector &viewpoint) const
+        {
+            const Vector center = chunkLower(coords) + Vector::Constant(_chunkLength * Scalar(0.5));
+            const Scalar d = (center - viewpoint).norm();
+
+            int level = 0;
+            Scalar limit = _lodDistance;
+            while (level < _maxLevel && d > limit) {
+                ++level;
+                limit *= Scalar(2);
+            }
+            return level;
+        }
+
+        void ChunkManager::update(const Vector &viewpoint)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_tick;
+
+            const Index first = ((viewpoint - Vector::Constant(_radius)) / _chunkLength).array().floor().cast<Index::Scalar>();
+            const Index last = ((viewpoint + Vector::Constant(_radius)) / _chunkLength).array().floor().cast<Index::Scalar>();
+
+            // Chunks intersecting the view sphere, nearest first.
+            std::vector< std::pair<Scalar, ChunkKey> > view;
+            for (int z = first.z(); z <= last.z(); ++z) {
+                for (int y = first.y(); y <= last.y(); ++y) {
+                    for (int x = first.x(); x <= last.x(); ++x) {
+                        const Index c(x, y, z);
+                        const Vector l = chunkLower(c);
+                        const Vector u = l + Vector::Constant(_chunkLength);
+                        const Scalar d = (viewpoint.cwiseMax(l).cwiseMin(u) - viewpoint).norm();
+                        if (d <= _radius)
+                            view.push_back(std::make_pair(d, ChunkKey(c, levelFor(c, viewpoint))));
+                    }
+                }
+            }
+            std::stable_sort(view.begin(), view.end(), [](const std::pair<Scalar, ChunkKey> &a, const std::pair<Scalar, ChunkKey> &b) {
+                return a.first < b.first;
+            });
+
+            // Chunks queued for previous viewpoints but not started are dropped.
+            for (size_t i = 0; i < _queue.size(); ++i)
+                _entries.erase(_queue[i]);
+            _queue.clear();
+
+            _view.clear();
+            for (size_t i = 0; i < view.size(); ++i) {
+                const ChunkKey &key = view[i].second;
+                _view.push_back(key);
+
+                // Touch all cached levels of the chunk, as they serve as fallbacks.
+                EntryMap::iterator iter = _entries.lower_bound(ChunkKey(key.coords, std::numeric_limits<int>::min()));
+                for (; iter != _entries.end() && iter->first.coords == key.coords; ++iter)
+                    iter->second.lastUsed = _tick;
+
+                if (_entries.find(key) == _entries.end()) {
+                    Entry &e = _entries[key];
+                    e.bytes = 0;
+                    e.lastUsed = _tick;
+                    e.resolved = 0;
+                    e.pending = true;
+                    _queue.push_back(key);
+                }
+            }
+
+            evict();
+            _queueChanged.notify_all();
+        }
+
+        void ChunkManager::waitIdle()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _idle.wait(lock, [this]() { return _queue.empty() && _busy == 0; });
+        }
+
+        std::vector<ChunkManager::Chunk> ChunkManager::visibleChunks() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            std::vector<Chunk> chunks;
+            for (size_t i = 0; i < _view.size(); ++i) {
+                const ChunkKey &key = _view[i];
+
+                // Prefer the desired level, otherwise the closest level available.
+                EntryMap::const_iterator best = _entries.end();
+                EntryMap::const_iterator iter = _entries.lower_bound(ChunkKey(key.coords, std::numeric_limits<int>::min()));
+                for (; iter != _entries.end() && iter->first.coords == key.coords; ++iter) {
+                    if (!iter->second.surface)
+                        continue;
+                    if (best == _entries.end() || std::abs(iter->first.level - key.level) < std::abs(best->first.level - key.level))
+                        best = iter;
+                }
+
+                if (best != _entries.end()) {
+                    Chunk c;
+                    c.key = best->first;
+                    c.surface = best->second.surface;
+                    c.bytes = best->second.bytes;
+                    chunks.push_back(c);
+                }
+            }
+
+            return chunks;
+        }
+
+        size_t ChunkManager::memoryUsage() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _bytes;
+        }
+
+        size_t ChunkManager::cachedChunks() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            size_t n = 0;
+            for (EntryMap::const_iterator iter = _entries.begin(); iter != _entries.end(); ++iter) {
+                if (iter->second.surface)
+                    ++n;
+            }
+            return n;
+        }
+
+        void ChunkManager::work()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true) {
+                _queueChanged.wait(lock, [this]() { return _stop || !_queue.empty(); });
+                if (_stop)
+                    return;
+
+                const ChunkKey key = _queue.front();
+                _queue.pop_front();
+                ++_busy;
+
+                lock.unlock();
+                std::shared_ptr<MeshChunk> block = std::make_shared<MeshChunk>();
+                extract(key, *block);
+                lock.lock();
+
+                EntryMap::iterator iter = _entries.find(key);
+                if (iter != _entries.end()) {
+                    iter->second.block = block;
+
+                    // Faces of this chunk and of the chunks following it along each axis reference
+                    // its vertices. Resolve those cached, along with the blocks they reference.
+                    std::vector<ChunkKey> targets;
+                    std::vector<MeshChunkPtr> blocks;
+                    for (int n = 0; n < 8; ++n) {
+                        const ChunkKey target(key.coords + cubeOffset(n), key.level);
+                        EntryMap::const_iterator t = _entries.find(target);
+                        if (t == _entries.end() || !t->second.block)
+                            continue;
+
+                        targets.push_back(target);
+                        for (int m = 0; m < 8; ++m) {
+                            EntryMap::const_iterator r = _entries.find(ChunkKey(target.coords - cubeOffset(m), key.level));
+                            blocks.push_back(r != _entries.end() ? r->second.block : MeshChunkPtr());
+                        }
+                    }
+                    const unsigned long long resolves = ++_resolves;
+
+                    lock.unlock();
+                    std::vector< std::shared_ptr<const IndexedSurface> > surfaces(targets.size());
+                    for (size_t i = 0; i < targets.size(); ++i) {
+                        std::shared_ptr<IndexedSurface> s = std::make_shared<IndexedSurface>();
+                        resolve(targets[i], &blocks[i * 8], *s);
+                        surfaces[i] = s;
+                    }
+                    lock.lock();
+
+                    // Surfaces resolved by other workers in the meantime saw at least the same neighbors.
+                    for (size_t i = 0; i < targets.size(); ++i) {
+                        EntryMap::iterator t = _entries.find(targets[i]);
+                        if (t == _entries.end() || t->second.block != blocks[i * 8] || t->second.resolved > resolves)
+                            continue;
+
+                        Entry &e = t->second;
+                        _bytes -= e.bytes;
+                        e.surface = surfaces[i];
+                        e.bytes = e.surface->bytes() + e.block->bytes();
+                        e.resolved = resolves;
+                        _bytes += e.bytes;
+                    }
+
+                    iter = _entries.find(key);
+                    if (iter != _entries.end())
+                        iter->second.pending = false;
+                    evict();
+                }
+
+                --_busy;
+                if (_queue.empty() && _busy == 0)
+                    _idle.notify_all();
+            }
+        }
+
+        void ChunkManager::extract(const ChunkKey &key, MeshChunk &block) const
+        {
+            DualContouring dc;
+            DualContouring::EComputeType et;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                dc = _dc;
+                et = _computeType;
+            }
+
+            const int voxels = std::max<int>(1, _voxelsPerChunk >> key.level);
+            const Scalar h = _chunkLength / Scalar(voxels);
+            const Vector lower = chunkLower(key.coords);
+
+            // The grid extends one voxel beyond the chunk, which makes the chunk its first block 
+            // owning exactly the corners, edges and voxels within the chunk.
+            dc.setLowerBounds(lower);
+            dc.setUpperBounds(lower + Vector::Constant(_chunkLength + h));
+            dc.setResolution(Vector::Constant(h));
+            dc.computeBlock(_scene, BlockGrid(Index::Zero(), Index::Constant(voxels + 1), voxels), 0, block, et);
+
+            // Move voxels from the grid of the chunk to the grid of the level.
+            const Index offset = key.coords * voxels;
+            for (size_t i = 0; i < block.voxels.size(); ++i)
+                block.voxels[i] += offset;
+            for (size_t i = 0; i < block.quads.size(); ++i)
+                block.quads[i] += offset;
+        }
+
+        void ChunkManager::resolve(const ChunkKey &key, const MeshChunkPtr *blocks, IndexedSurface &s) const
+        {
+            const int voxels = std::max<int>(1, _voxelsPerChunk >> key.level);
+            const MeshChunk &own = *blocks[0];
+
+            // Vertices are appended once per referenced vertex, keyed by block and local index.
+            std::map<std::pair<int, int>, int> ids;
+            std::vector<Vector> vertices;
+            std::vector<Index::Scalar> faces;
+            faces.reserve(own.quads.size() / 4 * 6);
+
+            for (size_t i = 0; i + 3 < own.quads.size(); i += 4) {
+                // Prefer vertices of the chunks owning the voxels, so that neighbors share seam vertices.
+                // Otherwise fall back to the approximations generated by this chunk for voxels below it.
+                int slots[4], locals[4];
+                bool resolved = true;
+                for (int j = 0; j < 4 && resolved; ++j) {
+                    const Index &v = own.quads[i + j];
+                    const Index below = key.coords - chunkOf(v, voxels);
+
+                    slots[j] = below.x() + 2 * below.y() + 4 * below.z();
+                    locals[j] = blocks[slots[j]] ? blocks[slots[j]]->find(v) : -1;
+                    if (locals[j] < 0) {
+                        slots[j] = 0;
+                        locals[j] = own.find(v);
+                    }
+                    resolved = locals[j] >= 0;
+                }
+
+                // Quads referencing vertices no block generated are dropped, as by mergeChunks.
+                if (!resolved)
+                    continue;
+
+                Index::Scalar q[4];
+                for (int j = 0; j < 4; ++j) {
+                    const std::pair<std::map<std::pair<int, int>, int>::iterator, bool> r =
+                        ids.insert(std::make_pair(std::make_pair(slots[j], locals[j]), int(vertices.size())));
+                    if (r.second)
+                        vertices.push_back(blocks[slots[j]]->vertices[locals[j]]);
+                    q[j] = r.first->second;
+                }
+
+                const Index::Scalar tris[6] = { q[0], q[1], q[2], q[0], q[2], q[3] };
+                faces.insert(faces.end(), tris, tris + 6);
+            }
+
+            s.vertices.resize(3, vertices.size());
+            for (size_t i = 0; i < vertices.size(); ++i)
+                s.vertices.col(i) = vertices[i];
+
+            s.faces.resize(3, faces.size() / 3);
+            for (size_t i = 0; i < faces.size(); ++i)
+                s.faces(i % 3, i / 3) = faces[i];
+        }
+
+        void ChunkManager::evict()
+        {
+            // Requires the lock to be held. Chunks of the current view are never evicted.
+            while (_bytes > _budget) {
+                EntryMap::iterator victim = _entries.end();
+                for (EntryMap::iterator iter = _entries.begin(); iter != _entries.end(); ++iter) {
+                    const Entry &e = iter->second;
+                    if (e.pending || e.lastUsed == _tick)
+                        continue;
+                    if (victim == _entries.end() || e.lastUsed < victim->second.lastUsed)
+                        victim = iter;
+                }
+
+                if (victim == _entries.end())
+                    break;
+
+                _bytes -= victim->second.bytes;
+                _entries.erase(victim);
+            }
+        }
+
+    }
+}
@@ -0,0 +1,108 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/surface/corner_sample_cache.h>
+#include <volplay/sdf_node.h>
+#include <volplay/util/parallel.h>
+#include <algorithm>
+#include <limits>
+
+namespace volplay {
+
+    namespace surface {
+
+        CornerSampleCache::CornerSampleCache(const SDFNodePtr &scene, const AffineTransform &toWorld, const Index &lower, const Index &upper)
+            : _scene(scene), _toWorld(toWorld), _lower(lower), _upper(upper), _evaluations(0), _intervalEvaluations(0)
+        {
+            _nx = upper.x() - lower.x() + 1;
+            _ny = upper.y() - lower.y() + 1;
+            _slices[0].resize(_nx * _ny);
+            _slices[1].resize(_nx * _ny);
+            _sliceZ[0] = _sliceZ[1] = std::numeric_limits<Index::Scalar>::min();
+        }
+
+        void CornerSampleCache::setPruningLevels(const std::vector<Scalar> &levels)
+        {
+            _levels = levels;
+        }
+
+        void CornerSampleCache::moveTo(Index::Scalar z)
+        {
+            if (_sliceZ[slot(z)] != z)
+                sampleSlice(z);
+            if (z < _upper.z() && _sliceZ[slot(z + 1)] != z + 1)
+                sampleSlice(z + 1);
+        }
+
+        size_t CornerSampleCache::evaluations() const
+        {
+            return _evaluations;
+        }
+
+        size_t CornerSampleCache::intervalEvaluations() const
+        {
+            return _intervalEvaluations;
+        }
+
+        void CornerSampleCache::sampleSlice(Index::Scalar z)
+        {
+            std::vector<Scalar> &s = _slices[slot(z)];
+
+            // Rows of tiles are sampled in parallel.
+            const int tileRows = (int(_ny) + TileSize - 1) / TileSize;
+            std::vector<size_t> evaluations(tileRows, 0);
+            std::vector<size_t> intervalEvaluations(tileRows, 0);
+
+            util::parallelFor(0, tileRows, [&](int ty) {
+                const Index::Scalar y0 = _lower.y() + ty * TileSize;
+                const Index::Scalar y1 = std::min<Index::Scalar>(y0 + TileSize - 1, _upper.y());
+
+                for (Index::Scalar x0 = _lower.x(); x0 <= _upper.x(); x0 += TileSize) {
+                    const Index::Scalar x1 = std::min<Index::Scalar>(x0 + TileSize - 1, _upper.x());
+
+                    if (!_levels.empty()) {
+                        // Box of the tile and all corners sharing an edge with it.
+                        AlignedBox box(_toWorld * Vector(Scalar(x0 - 1), Scalar(y0 - 1), Scalar(z - 1)));
+                        box.extend(_toWorld * Vector(Scalar(x1 + 1), Scalar(y1 + 1), Scalar(z + 1)));
+
+                        const math::Interval r = _scene->evalInterval(box);
+                        ++intervalEvaluations[ty];
+
+                        bool crossed = false;
+                        for (size_t l = 0; l < _levels.size() && !crossed; ++l)
+                            crossed = r.contains(_levels[l]);
+
+                        if (!crossed) {
+                            for (Index::Scalar y = y0; y <= y1; ++y) {
+                                Scalar *dst = &s[(y - _lower.y()) * _nx + (x0 - _lower.x())];
+                                std::fill(dst, dst + (x1 - x0 + 1), r.lower);
+                            }
+                            continue;
+                        }
+                    }
+
+                    for (Index::Scalar y = y0; y <= y1; ++y) {
+                        Scalar *dst = &s[(y - _lower.y()) * _nx + (x0 - _lower.x())];
+                        for (Index::Scalar x = x0; x <= x1; ++x) {
+                            *dst++ = _scene->eval(_toWorld * Vector(Scalar(x), Scalar(y), Scalar(z)));
+                        }
+                    }
+                    evaluations[ty] += size_t((x1 - x0 + 1) * (y1 - y0 + 1));
+                }
+            });
+
+            _sliceZ[slot(z)] = z;
+            for (int ty = 0; ty < tileRows; ++ty) {
+                _evaluations += evaluations[ty];
+                _intervalEvaluations += intervalEvaluations[ty];
+            }
+        }
+
+    }
+}
@@ -9,14 +9,27 @@
 
 #include <volplay/surface/dual_contouring.h>
 #include <volplay/surface/indexed_surface.h>
+#include <volplay/surface/corner_sample_cache.h>
+#include <volplay/surface/block_grid.h>
+#include <volplay/surface/mesh_chunk.h>
+#include <volplay/surface/hermite_cache.h>
+#include <volplay/surface/locality_optimizer.h>
 #include <volplay/sdf_node.h>
 #include <volplay/sdf_displacement.h>
+#include <volplay/sdf_repetition.h>
+#include <volplay/sdf_node_visitor.h>
 #include <volplay/sdf_make.h>
 #include <volplay/util/function_output_iterator.h>
 #include <volplay/util/voxel_grid.h>
 #include <volplay/math/sign.h>
 #include <volplay/math/root.h>
+#include <volplay/math/qef.h>
+#include <volplay/util/parallel.h>
 #include <iostream>
+#include <atomic>
+#include <set>
+#include <algorithm>
+#include <limits>
 
 namespace volplay {
     
@@ -26,7 +39,16 @@ namespace volplay {
             : _lower(Vector::Constant(S(-1))),
               _upper(Vector::Constant(S(1))),
               _resolution(Vector::Constant(S(0.01))),
-              _iso(S(0))
+              _iso(S(0)),
+              _rootFinder(ROOT_BRENT),
+              _rootTolerance(S(0.001)),
+              _faceType(FACE_TRIANGLES),
+              _simplifyError(S(0)),
+              _chunkSize(64),
+              _periodic(true),
+              _svdThreshold(S(0.1)),
+              _locality(false),
+              _pruneIntervals(false)
         {}
 
         void DualContouring::setLowerBounds(const Vector &lower)
@@ -44,11 +66,80 @@ namespace volplay {
             _resolution = resolution;
         }
 
+        const Vector &DualContouring::lowerBounds() const
+        {
+            return _lower;
+        }
+
+        const Vector &DualContouring::upperBounds() const
+        {
+            return _upper;
+        }
+
+        const Vector &DualContouring::resolution() const
+        {
+            return _resolution;
+        }
+
         void DualContouring::setIsoLevel(Scalar s)
         {
             _iso = s;
         }
 
+        void DualContouring::setRootFinder(ERootFinder rf)
+        {
+            _rootFinder = rf;
+        }
+
+        void DualContouring::setRootTolerance(Scalar tol)
+        {
+            _rootTolerance = tol;
+        }
+
+        void DualContouring::setFaceType(EFaceType ft)
+        {
+            _faceType = ft;
+        }
+
+        void DualContouring::setSimplificationError(Scalar maxError)
+        {
+            _simplifyError = maxError;
+        }
+
+        void DualContouring::setChunkSize(int voxels)
+        {
+            _chunkSize = voxels;
+        }
+
+        void DualContouring::setPeriodicityEnabled(bool enable)
+        {
+            _periodic = enable;
+        }
+
+        void DualContouring::setSingularValueThreshold(Scalar threshold)
+        {
+            _svdThreshold = threshold;
+        }
+
+        void DualContouring::setLocalityOptimizationEnabled(bool enable)
+        {
+            _locality = enable;
+        }
+
+        void DualContouring::setIntervalPruningEnabled(bool enable)
+        {
+            _pruneIntervals = enable;
+        }
+
+        DualContouring::Statistics::Statistics()
+            : cornerEvaluations(0), rootEvaluations(0), normalEvaluations(0), intervalEvaluations(0), crossingEdges(0), acmrBefore(0), acmrAfter(0)
+        {}
+
+        const DualContouring::Statistics &DualContouring::statistics() const
+        {
+            return _stats;
+        }
+
         /** Data associated with edges crossed by surface. */
         struct Hermite {
             Vector p;
@@ -60,6 +151,12 @@ namespace volplay {
             {}
         };
 
+        /** Edge crossed by the surface along with the SDF values at its corners. */
+        struct EdgeCrossing {
+            util::voxelgrid::VoxelEdge e;
+            Scalar sdf[2];
+        };
+
         /** Describes the world. */
         struct WorldInfo {
             SDFNodePtr scene;
@@ -70,252 +167,1539 @@ namespace volplay {
 
             util::voxelgrid::SparseVoxelEdgeProperty<Hermite> eHermite;
 
+            std::atomic<size_t> rootEvaluations;
+            std::atomic<size_t> normalEvaluations;
+
+            bool pruneIntervals;
+            size_t intervalEvaluations;
+
             WorldInfo(SDFNodePtr scene_, const Vector &lower_, const Vector &upper_, const Vector &resolution_)
-                : scene(scene_), lower(lower_), upper(upper_), resolution(resolution_)
+                : scene(scene_), lower(lower_), upper(upper_), resolution(resolution_), rootEvaluations(0), normalEvaluations(0), pruneIntervals(false), intervalEvaluations(0)
             {
                 toGrid = util::voxelgrid::buildWorldToLocal(lower, resolution);
                 toWorld = toGrid.inverse();
             }
-        };
-        
-        /** Computes edge itersection using a linear model assumption */
-        class EdgeIntersectionLinear {
-        public:
-            EdgeIntersectionLinear()
-            {}
 
-            bool operator()(const util::voxelgrid::VoxelEdge &e, WorldInfo &wi, Hermite &h) const
+            /** 
+                Test if voxels of the grid, shifted by offset, can be stored by packed keys. Includes
+                neighbors of boundary voxels.
+            */
+            bool packable(const Index &offset = Index::Zero()) const
             {
-                // Edge vertices in world space, SDFs and signs
-                Vector verts[2] = {Vector(wi.toWorld * e.first.cast<Scalar>()), Vector(wi.toWorld * e.second.cast<Scalar>())};
-                Scalar sdf[2] = { wi.scene->eval(verts[0]), wi.scene->eval(verts[1]) };
-                int sgn[2] = { math::sign(sdf[0]), math::sign(sdf[1]) };
+                namespace vg = util::voxelgrid;
+                return
+                    vg::isPackable(vg::worldToVoxel(toGrid, lower) + offset - Index::Ones()) &&
+                    vg::isPackable(vg::worldToVoxel(toGrid, upper) + offset + Index::Ones());
+            }
+        };
 
-                if ((sgn[0] - sgn[1]) == 0)
-                    return false;
+        /** Edge in world space oriented such that the first vertex is inside. */
+        struct OrientedEdge {
+            Vector verts[2];
+            Scalar sdf[2];
+            bool needFlip;
+
+            OrientedEdge(const EdgeCrossing &c, const WorldInfo &wi)
+                : needFlip(false)
+            {
+                verts[0] = wi.toWorld * c.e.first.cast<Scalar>();
+                verts[1] = wi.toWorld * c.e.second.cast<Scalar>();
+                sdf[0] = c.sdf[0];
+                sdf[1] = c.sdf[1];
 
-                bool needFlip = false;
-                if (sgn[0] >= sgn[1]) {                    
+                if (math::sign(sdf[0]) >= math::sign(sdf[1])) {
                     std::swap(verts[0], verts[1]);
                     std::swap(sdf[0], sdf[1]);
                     needFlip = true;
-                } 
-                
-                // Determine hermite data. Under the linear assumption a single step of the secant method
-                // should bring us to the root.
-                Vector v = verts[1] - verts[0];
-                Scalar t = S(1) - sdf[1]  * (S(1) / (sdf[1] - sdf[0]));
-                
+                }
+            }
+
+            /** Length of edge in world units. */
+            Scalar length() const
+            {
+                return (verts[1] - verts[0]).norm();
+            }
+
+            /** 
+                Parameter of the root under the linear assumption. A single step of the secant method 
+                brings us there. Iterative root finders start from this estimate and keep it, clamped to 
+                the edge, in case the edge does not bracket a root due to rounding. When running out of 
+                iterations they report their best estimate instead.
+            */
+            Scalar linearRoot() const
+            {
+                return S(1) - sdf[1] * (S(1) / (sdf[1] - sdf[0]));
+            }
+
+            /** Point at parameter t along edge. */
+            Vector at(Scalar t) const
+            {
+                return verts[0] + t * (verts[1] - verts[0]);
+            }
+
+            /** Fill hermite data for root at parameter t. Normal is computed from the scene if not given. */
+            bool toHermite(Scalar t, WorldInfo &wi, Hermite &h, const Vector *n = 0) const
+            {
                 if (t == Scalar(1)) // Exclude intersections on corners of other voxels.
                     return false;
-                                
-                h.needFlip = needFlip;
-                h.p = verts[0] + t * v;
-                h.n = wi.scene->normal(h.p);
 
+                h.needFlip = needFlip;
+                h.p = at(t);
+                if (n) {
+                    h.n = *n;
+                } else {
+                    h.n = wi.scene->normal(h.p);
+                    wi.normalEvaluations += 6;
+                }
                 return true;
             }
         };
+
+        /** Intersects each crossing edge independently and in parallel using a per edge root functor. */
+        template<class RootFnc>
+        void intersectEdgesParallel(const RootFnc &fnc, const std::vector<EdgeCrossing> &crossings, WorldInfo &wi, std::vector<Hermite> &hermites, std::vector<char> &valid)
+        {
+            hermites.resize(crossings.size());
+            valid.resize(crossings.size());
+            util::parallelFor(0, int(crossings.size()), [&](int i) {
+                valid[i] = fnc(OrientedEdge(crossings[i], wi), wi, hermites[i]) ? 1 : 0;
+            });
+        }
+        
+        /** Computes edge itersection using a linear model assumption */
+        class EdgeIntersectionLinear {
+        public:
+            EdgeIntersectionLinear()
+            {}
+
+            void operator()(const std::vector<EdgeCrossing> &crossings, WorldInfo &wi, std::vector<Hermite> &hermites, std::vector<char> &valid) const
+            {
+                intersectEdgesParallel(*this, crossings, wi, hermites, valid);
+            }
+
+            bool operator()(const OrientedEdge &oe, WorldInfo &wi, Hermite &h) const
+            {
+                return oe.toHermite(oe.linearRoot(), wi, h);
+            }
+        };
         
-        /** Computes edge itersection using a non linear model assumption */
+        /** Computes edge itersection using a non linear model assumption and Brent's method. */
         class EdgeIntersectionNonLinear {
         public:
             EdgeIntersectionNonLinear()
             {}
+
+            void operator()(const std::vector<EdgeCrossing> &crossings, WorldInfo &wi, std::vector<Hermite> &hermites, std::vector<char> &valid) const
+            {
+                intersectEdgesParallel(*this, crossings, wi, hermites, valid);
+            }
             
-            bool operator()(const util::voxelgrid::VoxelEdge &e, WorldInfo &wi, Hermite &h) const
+            bool operator()(const OrientedEdge &oe, WorldInfo &wi, Hermite &h) const
             {
-                // Edge vertices in world space, SDFs and signs
-                Vector verts[2] = {Vector(wi.toWorld * e.first.cast<Scalar>()), Vector(wi.toWorld * e.second.cast<Scalar>())};
-                Scalar sdf[2] = { wi.scene->eval(verts[0]), wi.scene->eval(verts[1]) };
-                int sgn[2] = { math::sign(sdf[0]), math::sign(sdf[1]) };
-                
-                if ((sgn[0] - sgn[1]) == 0)
-                    return false;
-                
-                bool needFlip = false;
-                if (sgn[0] >= sgn[1]) {
-                    std::swap(verts[0], verts[1]);
-                    std::swap(sdf[0], sdf[1]);
-                    needFlip = true;
+                size_t evals = 0;
+                auto f = [&](S x) { ++evals; return wi.scene->eval(oe.at(x)); };
+
+                Scalar t = oe.linearRoot();
+                if (!math::findRootBrent(f, S(0), S(1), oe.sdf[0], oe.sdf[1], S(0), 100, t))
+                    t = std::min(std::max(t, S(0)), S(1));
+                wi.rootEvaluations += evals;
+
+                return oe.toHermite(t, wi, h);
+            }
+        };
+
+        /** Computes edge itersection using a non linear model assumption and the Illinois method. */
+        class EdgeIntersectionIllinois {
+        public:
+            EdgeIntersectionIllinois(Scalar tol)
+                : _tol(tol)
+            {}
+
+            void operator()(const std::vector<EdgeCrossing> &crossings, WorldInfo &wi, std::vector<Hermite> &hermites, std::vector<char> &valid) const
+            {
+                intersectEdgesParallel(*this, crossings, wi, hermites, valid);
+            }
+
+            bool operator()(const OrientedEdge &oe, WorldInfo &wi, Hermite &h) const
+            {
+                size_t evals = 0;
+                auto f = [&](S x) { ++evals; return wi.scene->eval(oe.at(x)); };
+
+                Scalar t = oe.linearRoot();
+                if (!math::findRootIllinois(f, S(0), S(1), oe.sdf[0], oe.sdf[1], _tol, 100, t, _tol * oe.length()))
+                    t = std::min(std::max(t, S(0)), S(1));
+                wi.rootEvaluations += evals;
+
+                return oe.toHermite(t, wi, h);
+            }
+
+        private:
+            Scalar _tol;
+        };
+
+        /**
+            Evaluate SDF and its gradient from four samples on a tetrahedron around x.
+
+            The value is the mean of the samples, which deviates from the SDF at x by
+            O(eps^2) only.
+        */
+        inline Scalar evalWithGradient(const SDFNode &scene, const Vector &x, Vector &g, Scalar eps = Scalar(0.0001))
+        {
+            const Scalar f0 = scene.eval(x + Vector( eps, -eps, -eps));
+            const Scalar f1 = scene.eval(x + Vector(-eps, -eps,  eps));
+            const Scalar f2 = scene.eval(x + Vector(-eps,  eps, -eps));
+            const Scalar f3 = scene.eval(x + Vector( eps,  eps,  eps));
+
+            const Scalar invDenom = Scalar(1) / (Scalar(4) * eps);
+            g = Vector(f0 - f1 - f2 + f3, -f0 - f1 + f2 + f3, -f0 + f1 - f2 + f3) * invDenom;
+            return (f0 + f1 + f2 + f3) * Scalar(0.25);
+        }
+
+        /** 
+            Computes edge itersection using a non linear model assumption and Newton's method.
+
+            The derivative along the edge is taken from the SDF gradient. The gradient of the
+            last iterate is reused as surface normal.
+        */
+        class EdgeIntersectionNewton {
+        public:
+            EdgeIntersectionNewton(Scalar tol)
+                : _tol(tol)
+            {}
+
+            void operator()(const std::vector<EdgeCrossing> &crossings, WorldInfo &wi, std::vector<Hermite> &hermites, std::vector<char> &valid) const
+            {
+                intersectEdgesParallel(*this, crossings, wi, hermites, valid);
+            }
+
+            bool operator()(const OrientedEdge &oe, WorldInfo &wi, Hermite &h) const
+            {
+                const Vector v = oe.verts[1] - oe.verts[0];
+                Vector g = Vector::Zero();
+                size_t evals = 0;
+                auto fdf = [&](S x, S &fx, S &dfx) {
+                    const Vector p = oe.at(x);
+                    fx = evalWithGradient(*wi.scene, p, g);
+                    dfx = g.dot(v);
+                    evals += 4;
+                };
+
+                Scalar t = oe.linearRoot();
+                if (!math::findRootNewton(fdf, S(0), S(1), oe.sdf[0], oe.sdf[1], _tol, 100, t, _tol * oe.length()))
+                    t = std::min(std::max(t, S(0)), S(1));
+                wi.rootEvaluations += evals;
+
+                const Scalar len = g.norm();
+                if (len > Scalar(0)) {
+                    const Vector n = g / len;
+                    return oe.toHermite(t, wi, h, &n);
+                } else {
+                    return oe.toHermite(t, wi, h);
                 }
-                
-                // Determine hermite data.
-                Vector v = verts[1] - verts[0];
-                Scalar t;
-                auto f = [&](S x) { return wi.scene->eval(verts[0] + x * v); };
-                math::findRootBrent(f, S(0), S(1), S(0), 100, t);
-                
-                if (t == Scalar(1)) // Exclude intersections on corners of other voxels.
-                    return false;
-                
-                h.needFlip = needFlip;
-                h.p = verts[0] + t * v;
-                h.n = wi.scene->normal(h.p);
-                
-                return true;
             }
+
+        private:
+            Scalar _tol;
+        };
+
+        /** 
+            Computes edge itersection using a non linear model assumption and the Illinois method.
+
+            All edges are advanced in lockstep. Each iteration evaluates the scene at the current
+            estimates of all unconverged edges in parallel.
+        */
+        class EdgeIntersectionIllinoisBatched {
+        public:
+            EdgeIntersectionIllinoisBatched(Scalar tol)
+                : _tol(tol)
+            {}
+
+            void operator()(const std::vector<EdgeCrossing> &crossings, WorldInfo &wi, std::vector<Hermite> &hermites, std::vector<char> &valid) const
+            {
+                std::vector<OrientedEdge> edges;
+                std::vector<math::IllinoisBracket> brackets;
+                std::vector<Scalar> ftol;
+                std::vector<int> active;
+
+                edges.reserve(crossings.size());
+                brackets.reserve(crossings.size());
+                ftol.reserve(crossings.size());
+                for (size_t i = 0; i < crossings.size(); ++i) {
+                    edges.push_back(OrientedEdge(crossings[i], wi));
+                    brackets.push_back(math::IllinoisBracket(S(0), S(1), edges[i].sdf[0], edges[i].sdf[1]));
+                    ftol.push_back(_tol * edges[i].length());
+                    if (!brackets[i].converged(_tol, ftol[i]))
+                        active.push_back(int(i));
+                }
+
+                std::vector<Scalar> x, fx;
+                for (int iter = 0; iter < 100 && !active.empty(); ++iter) {
+                    x.resize(active.size());
+                    fx.resize(active.size());
+
+                    for (size_t i = 0; i < active.size(); ++i)
+                        x[i] = brackets[active[i]].next();
+
+                    util::parallelFor(0, int(active.size()), [&](int i) {
+                        fx[i] = wi.scene->eval(edges[active[i]].at(x[i]));
+                    });
+                    wi.rootEvaluations += active.size();
+
+                    size_t n = 0;
+                    for (size_t i = 0; i < active.size(); ++i) {
+                        math::IllinoisBracket &b = brackets[active[i]];
+                        b.update(fx[i]);
+                        if (!b.converged(_tol, ftol[active[i]]))
+                            active[n++] = active[i];
+                    }
+                    active.resize(n);
+                }
+
+                hermites.resize(crossings.size());
+                valid.resize(crossings.size());
+                util::parallelFor(0, int(crossings.size()), [&](int i) {
+                    valid[i] = edges[i].toHermite(brackets[i].root(), wi, hermites[i]) ? 1 : 0;
+                });
+            }
+
+        private:
+            Scalar _tol;
         };
 
 
         /** Vertex placement by minimizing the quadric error function QEF as described in Dual Contouring of Hermite data */
         class VertexPlacementDC {
         public:
-            void operator()(const util::voxelgrid::Voxel &v, WorldInfo &wi, Vector &x) const
+            VertexPlacementDC(Scalar threshold)
+                :_threshold(threshold)
+            {}
+
+            void operator()(const std::vector<util::voxelgrid::Voxel> &voxels, WorldInfo &wi, IndexedSurface::VertexMatrix &x) const
             {
-                // Solve for plane intersection
+                // Accumulate the planes of all crossing edges of each voxel in fixed size
+                // QEFs and solve them in one batch.
+                math::QEFBatch qefs;
+                qefs.resize(voxels.size());
+
                 util::voxelgrid::VoxelEdge edges[12];
-                util::voxelgrid::edges(v, edges);
-                
-                // Determine number of planes and mass point
-                Vector m = Vector::Zero(3);
-                util::voxelgrid::Voxel::Index nActive = 0;
-                for (int i = 0; i < 12; ++i) {
-                    if (wi.eHermite.isSet(edges[i])) {
-                        m += wi.eHermite[edges[i]].p;
-                        ++nActive;
+                for (size_t v = 0; v < voxels.size(); ++v) {
+                    util::voxelgrid::edges(voxels[v], edges);
+                    for (int i = 0; i < 12; ++i) {
+                        if (const Hermite *h = wi.eHermite.find(edges[i]))
+                            qefs.add(v, h->p, h->n);
                     }
                 }
-                m /= Scalar(nActive);
 
-                // Build A.x = b, where b is being translated towards the mass point origin
-				Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> A(nActive, 3);
-                Eigen::Matrix<Scalar, Eigen::Dynamic, 1> b(nActive);
-               
-                nActive = 0;                
-                for (int i = 0; i < 12; ++i) {
-                    if (wi.eHermite.isSet(edges[i])) {
-                        const Hermite &h = wi.eHermite[edges[i]];
-                        A.row(nActive) = h.n.transpose();
-                        b(nActive) = h.n.dot(h.p - m);
-                        ++nActive;
-                    } 
-                }
+                // Singular values below threshold are truncated, vertices move towards the mass point instead.
+                qefs.solve(_threshold, x);
+            }
 
-                // Solve
-                Eigen::JacobiSVD< Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> > svd(A, Eigen::ComputeThinU | Eigen::ComputeThinV);
-                svd.setThreshold(Scalar(0.1) / svd.singularValues()(0));
-                x = svd.solve(b) + m;
+            /** Singular value threshold of QEFs. */
+            Scalar threshold() const
+            {
+                return _threshold;
             }
+
+        private:
+            Scalar _threshold;
         };
 
         /** Vertex at midpoint of cell. */
         class VertexPlacementMidpoint {
         public:
-            void operator()(const util::voxelgrid::Voxel &v, WorldInfo &wi, Vector &x) const
+            void operator()(const std::vector<util::voxelgrid::Voxel> &voxels, WorldInfo &wi, IndexedSurface::VertexMatrix &x) const
             {
-                x = (wi.toWorld * v.cast<Scalar>()) + wi.resolution * Scalar(0.5);
+                x.resize(3, voxels.size());
+                for (size_t v = 0; v < voxels.size(); ++v) {
+                    x.col(v) = (wi.toWorld * voxels[v].cast<Scalar>()) + wi.resolution * Scalar(0.5);
+                }
             }
         };
 
-        /** Actual computation method */
-        template<class EdgeIntersectionFnc, class VertexPlacementFnc>
-        IndexedSurface
-        computeSurface(
-            WorldInfo &wi,
-            EdgeIntersectionFnc eisect,
-            VertexPlacementFnc vplace)
+        /** Singular value threshold for QEFs of collapsed cells. Matches the threshold of vertices placed by QEFs. */
+        inline Scalar simplifyThreshold(const VertexPlacementDC &vplace)
+        {
+            return vplace.threshold();
+        }
+
+        /** Singular value threshold for QEFs of collapsed cells with other vertex placements. */
+        template<class VertexPlacementFnc>
+        inline Scalar simplifyThreshold(const VertexPlacementFnc &)
+        {
+            return Scalar(0.1);
+        }
+
+        /** Cell of the simplification octree. */
+        struct OctreeCell {
+            /** Cell coordinates at the current level. */
+            util::voxelgrid::Voxel key;
+            /** Merged QEF of all leaves. */
+            math::QEF qef;
+            /** Whether the cell may still be merged with its siblings. */
+            bool collapsible;
+            /** Indices of surface voxels covered. */
+            std::vector<int> leaves;
+        };
+
+        /** Orders cells by the key of their parent. */
+        struct ParentOrder {
+            bool operator()(const OctreeCell &a, const OctreeCell &b) const
+            {
+                const util::voxelgrid::Voxel pa = a.key / 2, pb = b.key / 2;
+                return std::lexicographical_compare(pa.data(), pa.data() + 3, pb.data(), pb.data() + 3);
+            }
+        };
+
+        /** 
+            Test if collapsing a cell preserves the topology of the surface.
+
+            Simplified version of the tests in Ju et al. The cell corners must not all share the
+            same sign, so that small components are not removed, and each cell edge may be crossed
+            at most once.
+        */
+        bool isCollapseSafe(WorldInfo &wi, const util::voxelgrid::Voxel &minCorner, int size)
         {
             namespace vg = util::voxelgrid;
 
-            // Iterate all edges and remember those with an surface itersection. 
-            // For each such edge record the intersection (Hermite) edge data and
-            // mark surrounding voxels to contain vertices.
-            
-            vg::SparseVoxelSet voxelsWithVertices;
-            vg::edges(vg::worldToVoxel(wi.toGrid, wi.lower), vg::worldToVoxel(wi.toGrid, wi.upper), util::oiter([&](const vg::VoxelEdge &e) {
-                
-                Hermite h;               
-                if (eisect(e, wi, h)) {
-                    wi.eHermite[e] = h;
-
-                    // Mark surrounding voxels
-                    util::voxelgrid::Voxel voxels[4];
-                    util::voxelgrid::voxels(e, voxels);
-
-                    voxelsWithVertices.set(voxels[0]);
-                    voxelsWithVertices.set(voxels[1]);
-                    voxelsWithVertices.set(voxels[2]);
-                    voxelsWithVertices.set(voxels[3]);
+            int positive = 0;
+            for (int i = 0; i < 8; ++i) {
+                const vg::Voxel c = minCorner + vg::Voxel(i & 1, (i >> 1) & 1, (i >> 2) & 1) * size;
+                if (math::sign(wi.scene->eval(wi.toWorld * c.cast<Scalar>())) > 0)
+                    ++positive;
+            }
+            if (positive == 0 || positive == 8)
+                return false;
+
+            vg::VoxelEdge edges[12];
+            vg::edges(edges);
+            for (int i = 0; i < 12; ++i) {
+                const vg::Voxel axis = edges[i].second - edges[i].first;
+                const vg::Voxel start = minCorner + edges[i].first * size;
+
+                int crossings = 0;
+                for (int k = 0; k < size; ++k) {
+                    if (wi.eHermite.isSet(vg::VoxelEdge(start + axis * k, start + axis * (k + 1))))
+                        ++crossings;
                 }
+                if (crossings > 1)
+                    return false;
+            }
 
-            }));
+            return true;
+        }
 
-            // Solve for each marked voxel from the previous step
-            IndexedSurface surface;
-            surface.vertices.resize(3, voxelsWithVertices.size());
+        /**
+            Adaptive simplification of Dual Contouring as described in
 
-			vg::SparseVoxelProperty<vg::Voxel::Index> voxelToIndex(0);
-			vg::Voxel::Index count = 0;
-            for (auto iter = voxelsWithVertices.begin(); iter != voxelsWithVertices.end(); ++iter) {
+            Ju, Tao, et al. "Dual contouring of hermite data." 
+            ACM Transactions on Graphics (TOG). Vol. 21. No. 3. ACM, 2002. 
+
+            An octree is built bottom-up over the surface voxels. Eight sibling cells are merged 
+            into their parent when all of them could be merged so far, the error of their merged QEF 
+            is at most maxError, its minimizer lies within the parent and the collapse is topologically 
+            safe. Afterwards all voxels of a collapsed cell share the vertex of that cell. Vertices of
+            voxels not collapsed are taken from x. QEFs of collapsed cells are solved truncating singular
+            values below svdThreshold.
+        */
+        void simplifyOctree(const std::vector<util::voxelgrid::Voxel> &voxels, WorldInfo &wi, Scalar maxError, Scalar svdThreshold, IndexedSurface::VertexMatrix &x, std::vector<int> &vertexOf)
+        {
+            namespace vg = util::voxelgrid;
 
-                Vector x;
-                vplace(*iter, wi, x);
-                surface.vertices.col(count) = x;
-                voxelToIndex[*iter] = count++;                
+            // Cells are aligned to an origin below all voxels that may carry vertices, so keys stay non-negative.
+            const vg::Voxel origin = vg::worldToVoxel(wi.toGrid, wi.lower) - vg::Voxel::Ones();
+            const int extent = (vg::worldToVoxel(wi.toGrid, wi.upper) - origin).maxCoeff() + 1;
+
+            std::vector<OctreeCell> cells(voxels.size());
+            vg::VoxelEdge edges[12];
+            for (size_t v = 0; v < voxels.size(); ++v) {
+                OctreeCell &c = cells[v];
+                c.key = voxels[v] - origin;
+                c.collapsible = true;
+                c.leaves.push_back(int(v));
+
+                vg::edges(voxels[v], edges);
+                for (int i = 0; i < 12; ++i) {
+                    if (const Hermite *h = wi.eHermite.find(edges[i]))
+                        c.qef.add(h->p, h->n);
+                }
             }
 
-            // Build topology
-            // Actually dual contouring generates quads. We triangulate them however, for compatibility issues
-            // with most external 3D viewers.
-            
-            surface.faces.resize(3, wi.eHermite.size() * 2);
-            count = 0;  
-            for (auto iter = wi.eHermite.begin(); iter != wi.eHermite.end(); ++iter) {
-                vg::Voxel v[4];                
-                util::voxelgrid::voxels((iter->second.needFlip ? vg::flipEdge(iter->first) : iter->first), v);
+            std::vector<Vector> positions;
+            vertexOf.assign(voxels.size(), -1);
+            auto finalize = [&](const OctreeCell &c, int level) {
+                if (c.leaves.empty())
+                    return;
+
+                const int idx = int(positions.size());
+                positions.push_back(level == 0 ? Vector(x.col(c.leaves[0])) : c.qef.solve(svdThreshold));
+                for (size_t i = 0; i < c.leaves.size(); ++i)
+                    vertexOf[c.leaves[i]] = idx;
+            };
+
+            int level = 0;
+            while (!cells.empty()) {
+                if ((1 << level) >= extent) {
+                    for (size_t i = 0; i < cells.size(); ++i)
+                        finalize(cells[i], level);
+                    break;
+                }
+
+                std::sort(cells.begin(), cells.end(), ParentOrder());
+
+                const int size = 1 << (level + 1);
+                std::vector<OctreeCell> parents;
+                for (size_t i = 0; i < cells.size();) {
+                    size_t j = i + 1;
+                    while (j < cells.size() && cells[j].key / 2 == cells[i].key / 2)
+                        ++j;
+
+                    OctreeCell p;
+                    p.key = cells[i].key / 2;
+                    p.collapsible = true;
+                    for (size_t k = i; k < j; ++k) {
+                        p.collapsible &= cells[k].collapsible;
+                        p.qef.merge(cells[k].qef);
+                    }
+
+                    if (p.collapsible) {
+                        Scalar err;
+                        const Vector v = p.qef.solve(svdThreshold, &err);
+                        const vg::Voxel minCorner = origin + p.key * size;
+                        const Vector l = wi.toWorld * minCorner.cast<Scalar>();
+                        const Vector u = wi.toWorld * vg::Voxel(minCorner + vg::Voxel::Constant(size)).cast<Scalar>();
+
+                        p.collapsible = 
+                            err <= maxError &&
+                            (v.array() >= l.array()).all() && (v.array() <= u.array()).all() &&
+                            isCollapseSafe(wi, minCorner, size);
+                    }
+
+                    if (p.collapsible) {
+                        for (size_t k = i; k < j; ++k)
+                            p.leaves.insert(p.leaves.end(), cells[k].leaves.begin(), cells[k].leaves.end());
+                    } else {
+                        // Children become final. The parent is kept as a marker that prevents its ancestors from collapsing.
+                        for (size_t k = i; k < j; ++k)
+                            finalize(cells[k], level);
+                    }
+
+                    parents.push_back(p);
+                    i = j;
+                }
 
-                surface.faces(0, count) = voxelToIndex[v[0]];
-                surface.faces(1, count) = voxelToIndex[v[1]];
-                surface.faces(2, count) = voxelToIndex[v[2]];
-                count += 1;
-                surface.faces(0, count) = voxelToIndex[v[0]];
-                surface.faces(1, count) = voxelToIndex[v[2]];
-                surface.faces(2, count) = voxelToIndex[v[3]];
-                count += 1;                
+                cells.swap(parents);
+                ++level;
             }
 
-            return surface;
-            
-            /* Code for Quads
-            surface.faces.resize(4, wi.eHermite.size());
-            count = 0;  
-            for (auto iter = wi.eHermite.begin(); iter != wi.eHermite.end(); ++iter, ++count) {
-                vg::Voxel v[4];
-                util::voxelgrid::voxels(iter->first, v);
-                surface.faces(0, count) = voxelToIndex[v[0]];
-                surface.faces(1, count) = voxelToIndex[v[1]];
-                surface.faces(2, count) = voxelToIndex[v[2]];
-                surface.faces(3, count) = voxelToIndex[v[3]];
-            }
-            std::cout << "faces done." << std::endl;
-            */
+            x.resize(3, positions.size());
+            for (size_t i = 0; i < positions.size(); ++i)
+                x.col(i) = positions[i];
         }
 
-        IndexedSurface
-        DualContouring::compute(SDFNodePtr scene, EComputeType et)
+        /** 
+            Add a face of the simplified mesh. Corners of the quad may share vertices when the quad
+            spans collapsed cells, which yields triangles or degenerate faces. Degenerate faces and 
+            duplicates are skipped.
+        */
+        void addSimplifiedFace(const int quad[4], bool quads, std::vector<int> &indices, std::set< std::vector<int> > &seen)
         {
-            WorldInfo wi(scene, _lower, _upper, _resolution);
+            std::vector<int> poly;
+            for (int i = 0; i < 4; ++i) {
+                if (quad[i] != quad[(i + 1) % 4])
+                    poly.push_back(quad[i]);
+            }
 
-            // If iso-level is other then zero, we simply offset the entire scene
-            // by the constant negative iso value.
-            if (_iso != S(0)) {
-                wi.scene = make()
-                    .displacement().fnc([this](const Vector &v) -> S { return -_iso;})
-                        .wrap().node(wi.scene)
-                    .end();   
+            std::vector<int> key(poly);
+            std::sort(key.begin(), key.end());
+            if (poly.size() < 3 || std::unique(key.begin(), key.end()) != key.end())
+                return;
+            if (!seen.insert(key).second)
+                return;
+
+            if (quads) {
+                // Faces of a surface share their number of vertices, so triangles become degenerate quads.
+                if (poly.size() == 3)
+                    poly.push_back(poly[2]);
+                indices.insert(indices.end(), poly.begin(), poly.end());
+            } else {
+                indices.push_back(poly[0]); indices.push_back(poly[1]); indices.push_back(poly[2]);
+                if (poly.size() == 4) {
+                    indices.push_back(poly[0]); indices.push_back(poly[2]); indices.push_back(poly[3]);
+                }
             }
+        }
 
-            switch (et) {
-            case COMPUTE_NONLINEAR_DC:
-                return computeSurface(wi, EdgeIntersectionNonLinear(), VertexPlacementDC());
-            case COMPUTE_LINEAR_DC:
-                return computeSurface(wi, EdgeIntersectionLinear(), VertexPlacementDC());
-            case COMPUTE_MIDPOINT:
-                return computeSurface(wi, EdgeIntersectionLinear(), VertexPlacementMidpoint());
-            default:
-                return IndexedSurface();
+        /**
+            Visit all edges between corners [lower, upper] along with the SDF values at their corners. 
+            Returns the number of scene evaluations.
+            
+            The SDF is sampled once per grid corner, one z-slice at a time. Edges are visited in the 
+            same order as util::voxelgrid::edges does, reporting the +x, +y, +z edge of each corner.
+            When interval pruning is enabled in wi, corners that cannot be part of edges crossing any 
+            of the levels are not sampled.
+        */
+        template<class EdgeVisitor>
+        size_t sweepEdges(WorldInfo &wi, const util::voxelgrid::Voxel &lower, const util::voxelgrid::Voxel &upper, const std::vector<Scalar> &levels, EdgeVisitor visitEdge)
+        {
+            namespace vg = util::voxelgrid;
+
+            CornerSampleCache samples(wi.scene, wi.toWorld, lower, upper);
+            if (wi.pruneIntervals)
+                samples.setPruningLevels(levels);
+
+            for (vg::Voxel::Scalar z = lower.z(); z <= upper.z(); ++z) {
+                samples.moveTo(z);
+                for (vg::Voxel::Scalar y = lower.y(); y <= upper.y(); ++y) {
+                    for (vg::Voxel::Scalar x = lower.x(); x <= upper.x(); ++x) {
+                        const Scalar s = samples(x, y, z);
+                        if (x < upper.x())
+                            visitEdge(vg::VoxelEdge(vg::Voxel(x, y, z), vg::Voxel(x + 1, y, z)), s, samples(x + 1, y, z));
+                        if (y < upper.y())
+                            visitEdge(vg::VoxelEdge(vg::Voxel(x, y, z), vg::Voxel(x, y + 1, z)), s, samples(x, y + 1, z));
+                        if (z < upper.z())
+                            visitEdge(vg::VoxelEdge(vg::Voxel(x, y, z), vg::Voxel(x, y, z + 1)), s, samples(x, y, z + 1));
+                    }
+                }
             }
+
+            wi.intervalEvaluations += samples.intervalEvaluations();
+            return samples.evaluations();
+        }
+
+        /**
+            Find all edges between corners [lower, upper] crossed by the surface. Returns the number of
+            scene evaluations.
+        */
+        size_t findCrossings(WorldInfo &wi, const util::voxelgrid::Voxel &lower, const util::voxelgrid::Voxel &upper, std::vector<EdgeCrossing> &crossings)
+        {
+            namespace vg = util::voxelgrid;
+
+            return sweepEdges(wi, lower, upper, std::vector<Scalar>(1, S(0)), [&](const vg::VoxelEdge &e, Scalar s0, Scalar s1) {
+                if (math::sign(s0) == math::sign(s1))
+                    return;
+
+                EdgeCrossing c;
+                c.e = e;
+                c.sdf[0] = s0;
+                c.sdf[1] = s1;
+                crossings.push_back(c);
+            });
+        }
+
+        /**
+            Find all edges between corners [lower, upper] crossed by the iso surfaces of multiple levels
+            in a single sweep. SDF values of crossings are relative to their level. Returns the number 
+            of scene evaluations.
+        */
+        size_t findCrossings(WorldInfo &wi, const util::voxelgrid::Voxel &lower, const util::voxelgrid::Voxel &upper, const std::vector<Scalar> &levels, std::vector< std::vector<EdgeCrossing> > &crossings)
+        {
+            namespace vg = util::voxelgrid;
+
+            crossings.resize(levels.size());
+            return sweepEdges(wi, lower, upper, levels, [&](const vg::VoxelEdge &e, Scalar s0, Scalar s1) {
+                for (size_t l = 0; l < levels.size(); ++l) {
+                    const Scalar t0 = s0 - levels[l];
+                    const Scalar t1 = s1 - levels[l];
+                    if (math::sign(t0) == math::sign(t1))
+                        continue;
+
+                    EdgeCrossing c;
+                    c.e = e;
+                    c.sdf[0] = t0;
+                    c.sdf[1] = t1;
+                    crossings[l].push_back(c);
+                }
+            });
+        }
+
+        /** 
+            Refine intersections of crossing edges, store their Hermite data in wi and collect the 
+            voxels carrying vertices.
+        */
+        template<class EdgeIntersectionFnc>
+        void refineCrossings(
+            WorldInfo &wi,
+            EdgeIntersectionFnc eisect,
+            const std::vector<EdgeCrossing> &crossings,
+            std::vector<util::voxelgrid::Voxel> &voxels,
+            DualContouring::Statistics &stats)
+        {
+            namespace vg = util::voxelgrid;
+
+            stats.crossingEdges = crossings.size();
+
+            // Refine intersections of all crossing edges at once.
+            std::vector<Hermite> hermites;
+            std::vector<char> valid;
+            eisect(crossings, wi, hermites, valid);
+
+            // For each crossing edge record the intersection (Hermite) edge data and
+            // mark surrounding voxels to contain vertices.
+            vg::SparseVoxelSet voxelsWithVertices;
+            voxelsWithVertices.reserve(crossings.size());
+            wi.eHermite.reserve(crossings.size());
+            for (size_t i = 0; i < crossings.size(); ++i) {
+                if (!valid[i])
+                    continue;
+
+                wi.eHermite[crossings[i].e] = hermites[i];
+
+                // Mark surrounding voxels
+                vg::Voxel voxels[4];
+                vg::voxels(crossings[i].e, voxels);
+
+                voxelsWithVertices.set(voxels[0]);
+                voxelsWithVertices.set(voxels[1]);
+                voxelsWithVertices.set(voxels[2]);
+                voxelsWithVertices.set(voxels[3]);
+            }
+
+            stats.rootEvaluations = wi.rootEvaluations;
+            stats.normalEvaluations = wi.normalEvaluations;
+
+            voxels.assign(voxelsWithVertices.begin(), voxelsWithVertices.end());
+        }
+
+        /** 
+            Sample the whole grid, store the Hermite data of all crossing edges in wi and 
+            collect the voxels carrying vertices.
+        */
+        template<class EdgeIntersectionFnc>
+        void sampleHermite(
+            WorldInfo &wi,
+            EdgeIntersectionFnc eisect,
+            std::vector<util::voxelgrid::Voxel> &voxels,
+            DualContouring::Statistics &stats)
+        {
+            namespace vg = util::voxelgrid;
+            
+            std::vector<EdgeCrossing> crossings;
+            stats.cornerEvaluations = findCrossings(wi, vg::worldToVoxel(wi.toGrid, wi.lower), vg::worldToVoxel(wi.toGrid, wi.upper), crossings);
+            stats.intervalEvaluations = wi.intervalEvaluations;
+            refineCrossings(wi, eisect, crossings, voxels, stats);
+        }
+
+        /** Place vertices in voxels and generate one quad per edge carrying Hermite data in wi. */
+        template<class VertexPlacementFnc>
+        IndexedSurface
+        buildSurface(
+            WorldInfo &wi,
+            const std::vector<util::voxelgrid::Voxel> &voxels,
+            VertexPlacementFnc vplace,
+            DualContouring::EFaceType faceType,
+            Scalar simplifyError)
+        {
+            namespace vg = util::voxelgrid;
+
+            // Solve for each marked voxel from the previous step
+            IndexedSurface surface;
+            vplace(voxels, wi, surface.vertices);
+
+			vg::SparseVoxelProperty<vg::Voxel::Index> voxelToIndex(0);
+			vg::Voxel::Index count = 0;
+            voxelToIndex.reserve(voxels.size());
+            if (simplifyError > Scalar(0)) {
+                std::vector<int> vertexOf;
+                simplifyOctree(voxels, wi, simplifyError, simplifyThreshold(vplace), surface.vertices, vertexOf);
+                for (size_t i = 0; i < voxels.size(); ++i) {
+                    voxelToIndex[voxels[i]] = vertexOf[i];
+                }
+            } else {
+                for (size_t i = 0; i < voxels.size(); ++i) {
+                    voxelToIndex[voxels[i]] = count++;
+                }
+            }
+
+            // Build topology
+            // Dual contouring generates one quad per crossing edge. Unless quads are requested, they
+            // are triangulated for compatibility with most external 3D viewers.
+            
+            const bool quads = (faceType == DualContouring::FACE_QUADS);
+
+            if (simplifyError > Scalar(0)) {
+                // Quads spanning cells of different sizes collapse to triangles or vanish.
+                std::vector<int> indices;
+                std::set< std::vector<int> > seen;
+                for (auto iter = wi.eHermite.begin(); iter != wi.eHermite.end(); ++iter) {
+                    vg::Voxel v[4];
+                    util::voxelgrid::voxels((iter->second.needFlip ? vg::flipEdge(iter->first) : iter->first), v);
+
+                    const int quad[4] = {
+                        int(voxelToIndex[v[0]]), int(voxelToIndex[v[1]]), int(voxelToIndex[v[2]]), int(voxelToIndex[v[3]])
+                    };
+                    addSimplifiedFace(quad, quads, indices, seen);
+                }
+
+                const int rows = quads ? 4 : 3;
+                surface.faces = Eigen::Map<IndexedSurface::FaceMatrix>(indices.data(), rows, indices.size() / rows);
+                return surface;
+            }
+
+            surface.faces.resize(quads ? 4 : 3, wi.eHermite.size() * (quads ? 1 : 2));
+            count = 0;  
+            for (auto iter = wi.eHermite.begin(); iter != wi.eHermite.end(); ++iter) {
+                vg::Voxel v[4];                
+                util::voxelgrid::voxels((iter->second.needFlip ? vg::flipEdge(iter->first) : iter->first), v);
+
+                if (quads) {
+                    surface.faces(0, count) = voxelToIndex[v[0]];
+                    surface.faces(1, count) = voxelToIndex[v[1]];
+                    surface.faces(2, count) = voxelToIndex[v[2]];
+                    surface.faces(3, count) = voxelToIndex[v[3]];
+                    count += 1;
+                } else {
+                    surface.faces(0, count) = voxelToIndex[v[0]];
+                    surface.faces(1, count) = voxelToIndex[v[1]];
+                    surface.faces(2, count) = voxelToIndex[v[2]];
+                    count += 1;
+                    surface.faces(0, count) = voxelToIndex[v[0]];
+                    surface.faces(1, count) = voxelToIndex[v[2]];
+                    surface.faces(2, count) = voxelToIndex[v[3]];
+                    count += 1;                
+                }
+            }
+
+            return surface;
+        }
+
+        /** Actual computation method */
+        template<class EdgeIntersectionFnc, class VertexPlacementFnc>
+        IndexedSurface
+        computeSurface(
+            WorldInfo &wi,
+            EdgeIntersectionFnc eisect,
+            VertexPlacementFnc vplace,
+            DualContouring::EFaceType faceType,
+            Scalar simplifyError,
+            DualContouring::Statistics &stats)
+        {
+            std::vector<util::voxelgrid::Voxel> voxels;
+            sampleHermite(wi, eisect, voxels, stats);
+            return buildSurface(wi, voxels, vplace, faceType, simplifyError);
+        }
+
+        /** Extract surfaces of multiple iso levels, sharing a single sweep of corner samples. */
+        template<class EdgeIntersectionFnc, class VertexPlacementFnc>
+        std::vector<IndexedSurface>
+        computeIsoSurfaces(
+            WorldInfo &wi,
+            const std::vector<Scalar> &levels,
+            EdgeIntersectionFnc eisect,
+            VertexPlacementFnc vplace,
+            DualContouring::EFaceType faceType,
+            Scalar simplifyError,
+            DualContouring::Statistics &stats)
+        {
+            namespace vg = util::voxelgrid;
+
+            std::vector< std::vector<EdgeCrossing> > crossings;
+            stats.cornerEvaluations = findCrossings(wi, vg::worldToVoxel(wi.toGrid, wi.lower), vg::worldToVoxel(wi.toGrid, wi.upper), levels, crossings);
+            stats.intervalEvaluations = wi.intervalEvaluations;
+
+            // Intersections are refined on the scene offset by the level.
+            std::vector<SDFNodePtr> scenes(levels.size(), wi.scene);
+            for (size_t l = 0; l < levels.size(); ++l) {
+                if (levels[l] != S(0)) {
+                    scenes[l] = make()
+                        .displacement().offset(-levels[l])
+                            .wrap().node(wi.scene)
+                        .end();
+                }
+            }
+
+            // Levels are processed in turn, as refinement and surface construction run in parallel.
+            std::vector<IndexedSurface> surfaces(levels.size());
+            for (size_t l = 0; l < levels.size(); ++l) {
+                WorldInfo lwi(scenes[l], wi.lower, wi.upper, wi.resolution);
+                std::vector<vg::Voxel> voxels;
+                DualContouring::Statistics levelStats;
+                refineCrossings(lwi, eisect, crossings[l], voxels, levelStats);
+                surfaces[l] = buildSurface(lwi, voxels, vplace, faceType, simplifyError);
+
+                stats.crossingEdges += levelStats.crossingEdges;
+                stats.rootEvaluations += levelStats.rootEvaluations;
+                stats.normalEvaluations += levelStats.normalEvaluations;
+            }
+
+            return surfaces;
+        }
+
+        /** Finds an SDFRepetition at the root of a scene. */
+        class RootRepetitionFinder : public SDFNodeVisitor {
+        public:
+            RootRepetitionFinder()
+                : repetition(0), atRoot(true)
+            {}
+
+            /* Visit node */
+            virtual void visit(SDFNode *)
+            {
+                atRoot = false;
+            }
+
+            /* Visit node */
+            virtual void visit(SDFRepetition *n)
+            {
+                if (atRoot)
+                    repetition = n;
+                atRoot = false;
+            }
+
+            SDFRepetition *repetition;
+            bool atRoot;
+        };
+
+        /** 
+            Determine the period in voxels of each axis of a scene. Zero denotes a non-periodic axis.
+            Periodicity is reported only for repetitions at the root of the scene whose cells span 
+            an integral number of voxels and whose cell borders fall on grid corners.
+        */
+        Index findPeriods(const SDFNodePtr &scene, const Vector &lower, const Vector &resolution, Index &offset)
+        {
+            RootRepetitionFinder f;
+            scene->accept(f);
+
+            Index periods = Index::Zero();
+            offset.setZero();
+            if (!f.repetition)
+                return periods;
+
+            const Vector &c = f.repetition->cellSizes();
+            for (int i = 0; i < 3; ++i) {
+                if (!(c(i) > Scalar(0)) || c(i) == std::numeric_limits<Scalar>::infinity())
+                    continue;
+
+                const Scalar n = c(i) / resolution(i);
+                const Scalar o = lower(i) / resolution(i);
+                if (std::abs(n - std::floor(n + Scalar(0.5))) > Scalar(1e-3) || std::abs(o - std::floor(o + Scalar(0.5))) > Scalar(1e-3))
+                    continue;
+
+                periods(i) = Index::Scalar(std::floor(n + Scalar(0.5)));
+                offset(i) = Index::Scalar(std::floor(o + Scalar(0.5)));
+            }
+
+            return periods;
+        }
+
+        /** Floor division for negative numerators. */
+        inline Index::Scalar floorDiv(Index::Scalar a, Index::Scalar b)
+        {
+            return (a >= 0) ? a / b : -((-a + b - 1) / b);
+        }
+
+        /**
+            Extract the surface of a scene repeated along the axes with non-zero period.
+
+            SDFRepetition mirrors the space at the origin, so along each periodic axis the scene consists 
+            of translated copies of the tile spanning [0, period] for positive coordinates and mirrored 
+            copies for negative coordinates. Only a single tile is sampled, intersected and solved for
+            vertices. The tile at [period, 2 * period] is used rather than the one at the origin, since
+            normals of the latter are distorted along the mirror plane. The surface is then assembled by mapping all edges crossed within the 
+            bounds onto the tile. Each edge is generated by exactly one tile, so the copies are stitched 
+            without duplicate faces and share vertices across tile borders.
+
+            All coordinates below are global grid corners, i.e. local grid coordinates shifted by offset.
+        */
+        template<class EdgeIntersectionFnc, class VertexPlacementFnc>
+        IndexedSurface
+        computePeriodicSurface(
+            WorldInfo &wi,
+            const Index &periods,
+            const Index &offset,
+            EdgeIntersectionFnc eisect,
+            VertexPlacementFnc vplace,
+            DualContouring::EFaceType faceType,
+            DualContouring::Statistics &stats)
+        {
+            namespace vg = util::voxelgrid;
+
+            const vg::Voxel lower = offset;
+            const vg::Voxel upper = vg::worldToVoxel(wi.toGrid, wi.upper) + offset;
+
+            // Sample and intersect the tile. Tile coordinates in [0, period] correspond to global
+            // coordinates shifted by one period.
+            const vg::Voxel shift = periods;
+            const vg::Voxel toTile = offset - shift;
+
+            vg::Voxel tileLower = lower, tileUpper = upper;
+            for (int i = 0; i < 3; ++i) {
+                if (periods(i) > 0) {
+                    tileLower(i) = 0;
+                    tileUpper(i) = periods(i);
+                }
+            }
+
+            std::vector<EdgeCrossing> crossings;
+            stats.cornerEvaluations = findCrossings(wi, tileLower - toTile, tileUpper - toTile, crossings);
+            stats.intervalEvaluations = wi.intervalEvaluations;
+            stats.crossingEdges = crossings.size();
+
+            std::vector<Hermite> hermites;
+            std::vector<char> valid;
+            eisect(crossings, wi, hermites, valid);
+
+            // Vertices of tile voxels. Voxels of periodic axes lie in [0, period - 1].
+            vg::SparseVoxelSet tileVoxels;
+            for (size_t i = 0; i < crossings.size(); ++i) {
+                if (!valid[i])
+                    continue;
+
+                wi.eHermite[crossings[i].e] = hermites[i];
+
+                vg::Voxel voxels[4];
+                vg::voxels(crossings[i].e, voxels);
+                for (int j = 0; j < 4; ++j) {
+                    const vg::Voxel g = voxels[j] + toTile;
+                    bool inside = true;
+                    for (int k = 0; k < 3; ++k)
+                        inside &= periods(k) == 0 || (g(k) >= 0 && g(k) < periods(k));
+                    if (inside)
+                        tileVoxels.set(voxels[j]);
+                }
+            }
+
+            stats.rootEvaluations = wi.rootEvaluations;
+            stats.normalEvaluations = wi.normalEvaluations;
+
+            std::vector<vg::Voxel> voxels(tileVoxels.begin(), tileVoxels.end());
+            IndexedSurface::VertexMatrix tileVertices;
+            vplace(voxels, wi, tileVertices);
+
+            vg::SparseVoxelProperty<int> tileIndex(-1);
+            for (size_t i = 0; i < voxels.size(); ++i)
+                tileIndex[voxels[i] + toTile] = int(i);
+
+            // Map global voxels to tile voxels, creating transformed vertices on first use.
+            std::vector<Vector> positions;
+            vg::SparseVoxelProperty<int> voxelToIndex(-1);
+            auto vertexOf = [&](const vg::Voxel &v) {
+                int &idx = voxelToIndex[v];
+                if (idx >= 0)
+                    return idx;
+
+                vg::Voxel t = v;
+                bool mirror[3] = {false, false, false};
+                Index::Scalar tile[3] = {0, 0, 0};
+                for (int i = 0; i < 3; ++i) {
+                    if (periods(i) == 0)
+                        continue;
+                    tile[i] = floorDiv(v(i), periods(i));
+                    mirror[i] = tile[i] < 0;
+                    t(i) = mirror[i] ? (tile[i] + 1) * periods(i) - v(i) - 1 : v(i) - tile[i] * periods(i);
+                }
+
+                const int *tp = tileIndex.find(t);
+                if (tp == 0)
+                    return -1;
+                const int ti = *tp;
+
+                Vector p = tileVertices.col(ti);
+                for (int i = 0; i < 3; ++i) {
+                    if (periods(i) == 0)
+                        continue;
+                    const Scalar c = Scalar(periods(i)) * wi.resolution(i);
+                    p(i) -= c;
+                    p(i) = mirror[i] ? Scalar(tile[i] + 1) * c - p(i) : p(i) + Scalar(tile[i]) * c;
+                }
+
+                idx = int(positions.size());
+                positions.push_back(p);
+                return idx;
+            };
+
+            // Enumerate the tiles overlapping the bounds.
+            Index firstTile = Index::Zero(), lastTile = Index::Zero();
+            for (int i = 0; i < 3; ++i) {
+                if (periods(i) > 0) {
+                    firstTile(i) = floorDiv(lower(i), periods(i));
+                    lastTile(i) = floorDiv(upper(i), periods(i));
+                }
+            }
+
+            const bool quads = (faceType == DualContouring::FACE_QUADS);
+            std::vector<int> indices;
+
+            for (int tz = firstTile.z(); tz <= lastTile.z(); ++tz) {
+                for (int ty = firstTile.y(); ty <= lastTile.y(); ++ty) {
+                    for (int tx = firstTile.x(); tx <= lastTile.x(); ++tx) {
+                        const Index tile(tx, ty, tz);
+
+                        for (auto iter = wi.eHermite.begin(); iter != wi.eHermite.end(); ++iter) {
+                            const vg::Voxel a = iter->first.first + toTile;
+                            Index::Scalar axis;
+                            (iter->first.second - iter->first.first).maxCoeff(&axis);
+
+                            // Tiles own edges starting in [0, period). Perpendicular to the mirror plane
+                            // mirrored tiles own (0, period] instead, so that every edge has one owner.
+                            vg::Voxel g = a;
+                            bool owned = true, flip = iter->second.needFlip;
+                            for (int i = 0; i < 3 && owned; ++i) {
+                                if (periods(i) == 0)
+                                    continue;
+
+                                const bool mirror = tile(i) < 0;
+                                if (i == axis) {
+                                    owned = a(i) < periods(i);
+                                    g(i) = mirror ? (tile(i) + 1) * periods(i) - a(i) - 1 : a(i) + tile(i) * periods(i);
+                                    flip ^= mirror;
+                                } else {
+                                    owned = mirror ? a(i) > 0 : a(i) < periods(i);
+                                    g(i) = mirror ? (tile(i) + 1) * periods(i) - a(i) : a(i) + tile(i) * periods(i);
+                                }
+                            }
+
+                            vg::Voxel gb = g;
+                            gb(axis) += 1;
+                            if (!owned || (g.array() < lower.array()).any() || (gb.array() > upper.array()).any())
+                                continue;
+
+                            const vg::VoxelEdge e(g, gb);
+                            vg::Voxel v[4];
+                            vg::voxels((flip ? vg::flipEdge(e) : e), v);
+
+                            int quad[4];
+                            bool complete = true;
+                            for (int j = 0; j < 4; ++j) {
+                                quad[j] = vertexOf(v[j]);
+                                complete &= quad[j] >= 0;
+                            }
+                            if (!complete)
+                                continue;
+
+                            if (quads) {
+                                indices.insert(indices.end(), quad, quad + 4);
+                            } else {
+                                indices.push_back(quad[0]); indices.push_back(quad[1]); indices.push_back(quad[2]);
+                                indices.push_back(quad[0]); indices.push_back(quad[2]); indices.push_back(quad[3]);
+                            }
+                        }
+                    }
+                }
+            }
+
+            IndexedSurface surface;
+            surface.vertices.resize(3, positions.size());
+            for (size_t i = 0; i < positions.size(); ++i)
+                surface.vertices.col(i) = positions[i];
+
+            const int rows = quads ? 4 : 3;
+            surface.faces = Eigen::Map<IndexedSurface::FaceMatrix>(indices.data(), rows, indices.size() / rows);
+            return surface;
+        }
+
+        /** 
+            Extract the part of the surface owned by block b. 
+            
+            Corners of the block are sampled, which covers all edges of voxels owned by the block. 
+            Vertices are generated for owned voxels, faces for owned crossing edges.
+        */
+        template<class EdgeIntersectionFnc, class VertexPlacementFnc>
+        void computeChunk(
+            WorldInfo &wi,
+            const BlockGrid &grid,
+            int b,
+            EdgeIntersectionFnc eisect,
+            VertexPlacementFnc vplace,
+            MeshChunk &chunk,
+            DualContouring::Statistics &stats)
+        {
+            namespace vg = util::voxelgrid;
+
+            auto owner = [&grid](const vg::Voxel &v) {
+                return grid.owner(v.cwiseMax(grid.lower()).cwiseMin(grid.upper()));
+            };
+
+            std::vector<EdgeCrossing> crossings;
+            stats.cornerEvaluations += findCrossings(wi, grid.blockLower(b), grid.blockUpper(b), crossings);
+            stats.intervalEvaluations += wi.intervalEvaluations;
+            stats.crossingEdges += crossings.size();
+
+            std::vector<Hermite> hermites;
+            std::vector<char> valid;
+            eisect(crossings, wi, hermites, valid);
+
+            chunk.voxels.clear();
+            chunk.quads.clear();
+            for (size_t i = 0; i < crossings.size(); ++i) {
+                if (!valid[i])
+                    continue;
+
+                wi.eHermite[crossings[i].e] = hermites[i];
+
+                vg::Voxel voxels[4];
+                vg::voxels(crossings[i].e, voxels);
+                for (int j = 0; j < 4; ++j) {
+                    if (owner(voxels[j]) == b)
+                        chunk.voxels.push_back(voxels[j]);
+                }
+
+                if (grid.owner(crossings[i].e.first) == b) {
+                    vg::voxels((hermites[i].needFlip ? vg::flipEdge(crossings[i].e) : crossings[i].e), voxels);
+                    chunk.quads.insert(chunk.quads.end(), voxels, voxels + 4);
+                }
+            }
+
+            std::sort(chunk.voxels.begin(), chunk.voxels.end(), VoxelOrder());
+            chunk.voxels.erase(std::unique(chunk.voxels.begin(), chunk.voxels.end()), chunk.voxels.end());
+
+            IndexedSurface::VertexMatrix x;
+            vplace(chunk.voxels, wi, x);
+
+            chunk.vertices.resize(chunk.voxels.size());
+            for (size_t i = 0; i < chunk.voxels.size(); ++i)
+                chunk.vertices[i] = x.col(i);
+
+            stats.rootEvaluations += wi.rootEvaluations;
+            stats.normalEvaluations += wi.normalEvaluations;
+        }
+
+        /**
+            Invoke fnc with the edge intersection and vertex placement functors selected by the compute
+            type and root finder, along with the error of adaptive simplification. Midpoints are not 
+            simplified, as collapsing cells requires QEFs. Returns false for unknown compute types.
+        */
+        template<class Fnc>
+        bool dispatchExtraction(
+            DualContouring::EComputeType et, 
+            DualContouring::ERootFinder rf, 
+            Scalar rootTolerance, 
+            Scalar svdThreshold, 
+            Scalar simplifyError, 
+            Fnc &fnc)
+        {
+            switch (et) {
+            case DualContouring::COMPUTE_NONLINEAR_DC:
+                switch (rf) {
+                case DualContouring::ROOT_ILLINOIS:
+                    fnc(EdgeIntersectionIllinois(rootTolerance), VertexPlacementDC(svdThreshold), simplifyError);
+                    break;
+                case DualContouring::ROOT_NEWTON:
+                    fnc(EdgeIntersectionNewton(rootTolerance), VertexPlacementDC(svdThreshold), simplifyError);
+                    break;
+                case DualContouring::ROOT_ILLINOIS_BATCHED:
+                    fnc(EdgeIntersectionIllinoisBatched(rootTolerance), VertexPlacementDC(svdThreshold), simplifyError);
+                    break;
+                default:
+                    fnc(EdgeIntersectionNonLinear(), VertexPlacementDC(svdThreshold), simplifyError);
+                    break;
+                }
+                return true;
+            case DualContouring::COMPUTE_LINEAR_DC:
+                fnc(EdgeIntersectionLinear(), VertexPlacementDC(svdThreshold), simplifyError);
+                return true;
+            case DualContouring::COMPUTE_MIDPOINT:
+                fnc(EdgeIntersectionLinear(), VertexPlacementMidpoint(), S(0));
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        /** Extracts a block of a block grid. */
+        struct BlockExtraction {
+            WorldInfo &wi;
+            const BlockGrid &grid;
+            int b;
+            MeshChunk &chunk;
+            DualContouring::Statistics &stats;
+
+            template<class EdgeIntersectionFnc, class VertexPlacementFnc>
+            void operator()(EdgeIntersectionFnc eisect, VertexPlacementFnc vplace, Scalar)
+            {
+                computeChunk(wi, grid, b, eisect, vplace, chunk, stats);
+            }
+        };
+
+        BlockGrid DualContouring::blockGrid(int blockSize) const
+        {
+            namespace vg = util::voxelgrid;
+
+            const AffineTransform toGrid = vg::buildWorldToLocal(_lower, _resolution);
+            return BlockGrid(vg::worldToVoxel(toGrid, _lower), vg::worldToVoxel(toGrid, _upper), blockSize);
+        }
+
+        void
+        DualContouring::computeBlock(SDFNodePtr scene, const BlockGrid &grid, int b, MeshChunk &chunk, EComputeType et)
+        {
+            if (_iso != S(0)) {
+                scene = make()
+                    .displacement().offset(-_iso)
+                        .wrap().node(scene)
+                    .end();   
+            }
+
+            if (!util::voxelgrid::isPackable(grid.lower() - Index::Ones()) || !util::voxelgrid::isPackable(grid.upper() + Index::Ones())) {
+                chunk = MeshChunk();
+                return;
+            }
+
+            // Hermite data is kept for the current block only.
+            WorldInfo wi(scene, _lower, _upper, _resolution);
+            wi.pruneIntervals = _pruneIntervals;
+
+            BlockExtraction extraction = {wi, grid, b, chunk, _stats};
+            if (!dispatchExtraction(et, _rootFinder, _rootTolerance, _svdThreshold, _simplifyError, extraction))
+                chunk = MeshChunk();
+        }
+
+        bool
+        DualContouring::computeChunked(SDFNodePtr scene, const std::string &prefix, EComputeType et)
+        {
+            _stats = Statistics();
+
+            if (!WorldInfo(scene, _lower, _upper, _resolution).packable())
+                return false;
+
+            const BlockGrid grid = blockGrid(_chunkSize);
+
+            ChunkManifest m;
+            m.lower = grid.lower();
+            m.upper = grid.upper();
+            m.blockSize = _chunkSize;
+            m.quads = (_faceType == FACE_QUADS);
+
+            MeshChunk chunk;
+            for (int b = 0; b < grid.size(); ++b) {
+                computeBlock(scene, grid, b, chunk, et);
+
+                if (!chunk.write(ChunkManifest::chunkFilename(prefix, b).c_str()))
+                    return false;
+
+                m.vertexCounts.push_back(int(chunk.voxels.size()));
+                m.quadCounts.push_back(int(chunk.quads.size() / 4));
+            }
+
+            return m.write(prefix);
+        }
+
+        /** Extract surface, exploiting periodicity when present. */
+        template<class EdgeIntersectionFnc, class VertexPlacementFnc>
+        IndexedSurface
+        extractSurface(
+            WorldInfo &wi,
+            const Index &periods,
+            const Index &offset,
+            EdgeIntersectionFnc eisect,
+            VertexPlacementFnc vplace,
+            DualContouring::EFaceType faceType,
+            Scalar simplifyError,
+            DualContouring::Statistics &stats)
+        {
+            if ((periods.array() > 0).any() && simplifyError <= Scalar(0))
+                return computePeriodicSurface(wi, periods, offset, eisect, vplace, faceType, stats);
+            else
+                return computeSurface(wi, eisect, vplace, faceType, simplifyError, stats);
+        }
+
+        /** Reorder surface for vertex cache and memory locality when enabled. */
+        void optimizeLocality(bool enabled, IndexedSurface &surface, DualContouring::Statistics &stats)
+        {
+            if (!enabled)
+                return;
+
+            LocalityOptimizer lo;
+            lo.apply(surface);
+            stats.acmrBefore = lo.statistics().acmrBefore;
+            stats.acmrAfter = lo.statistics().acmrAfter;
+        }
+
+        /** Reorder surfaces when enabled. Cache miss ratios are averaged weighted by faces. */
+        void optimizeLocality(bool enabled, std::vector<IndexedSurface> &surfaces, DualContouring::Statistics &stats)
+        {
+            if (!enabled)
+                return;
+
+            Scalar before(0), after(0), faces(0);
+            for (size_t i = 0; i < surfaces.size(); ++i) {
+                optimizeLocality(enabled, surfaces[i], stats);
+                const Scalar n = Scalar(surfaces[i].faces.cols());
+                before += stats.acmrBefore * n;
+                after += stats.acmrAfter * n;
+                faces += n;
+            }
+            stats.acmrBefore = faces > 0 ? before / faces : Scalar(0);
+            stats.acmrAfter = faces > 0 ? after / faces : Scalar(0);
+        }
+
+        /** Extracts the surface of a scene, see extractSurface. */
+        struct SurfaceExtraction {
+            WorldInfo &wi;
+            const Index &periods;
+            const Index &offset;
+            DualContouring::EFaceType faceType;
+            DualContouring::Statistics &stats;
+            IndexedSurface &surface;
+
+            template<class EdgeIntersectionFnc, class VertexPlacementFnc>
+            void operator()(EdgeIntersectionFnc eisect, VertexPlacementFnc vplace, Scalar simplifyError)
+            {
+                surface = extractSurface(wi, periods, offset, eisect, vplace, faceType, simplifyError, stats);
+            }
+        };
+
+        IndexedSurface
+        DualContouring::compute(SDFNodePtr scene, EComputeType et)
+        {
+            WorldInfo wi(scene, _lower, _upper, _resolution);
+            wi.pruneIntervals = _pruneIntervals;
+
+            Index offset = Index::Zero();
+            const Index periods = _periodic ? findPeriods(scene, _lower, _resolution, offset) : Index::Zero();
+
+            // If iso-level is other then zero, we simply offset the entire scene
+            // by the constant negative iso value.
+            if (_iso != S(0)) {
+                wi.scene = make()
+                    .displacement().offset(-_iso)
+                        .wrap().node(wi.scene)
+                    .end();   
+            }
+
+            _stats = Statistics();
+
+            IndexedSurface surface;
+            if (!wi.packable(offset))
+                return surface;
+
+            SurfaceExtraction extraction = {wi, periods, offset, _faceType, _stats, surface};
+            dispatchExtraction(et, _rootFinder, _rootTolerance, _svdThreshold, _simplifyError, extraction);
+
+            optimizeLocality(_locality, surface, _stats);
+            return surface;
+        }
+
+        /** Extracts the surfaces of multiple iso levels, see computeIsoSurfaces. */
+        struct IsoSurfaceExtraction {
+            WorldInfo &wi;
+            const std::vector<Scalar> &levels;
+            DualContouring::EFaceType faceType;
+            DualContouring::Statistics &stats;
+            std::vector<IndexedSurface> &surfaces;
+
+            template<class EdgeIntersectionFnc, class VertexPlacementFnc>
+            void operator()(EdgeIntersectionFnc eisect, VertexPlacementFnc vplace, Scalar simplifyError)
+            {
+                surfaces = computeIsoSurfaces(wi, levels, eisect, vplace, faceType, simplifyError, stats);
+            }
+        };
+
+        std::vector<IndexedSurface>
+        DualContouring::computeIsoLevels(SDFNodePtr scene, const std::vector<Scalar> &levels, EComputeType et)
+        {
+            WorldInfo wi(scene, _lower, _upper, _resolution);
+            wi.pruneIntervals = _pruneIntervals;
+
+            _stats = Statistics();
+
+            std::vector<IndexedSurface> surfaces;
+            if (!wi.packable())
+                return std::vector<IndexedSurface>(levels.size());
+
+            IsoSurfaceExtraction extraction = {wi, levels, _faceType, _stats, surfaces};
+            if (!dispatchExtraction(et, _rootFinder, _rootTolerance, _svdThreshold, _simplifyError, extraction))
+                surfaces.resize(levels.size());
+
+            optimizeLocality(_locality, surfaces, _stats);
+            return surfaces;
+        }
+
+        /** Samples Hermite data of a scene, see sampleHermite. */
+        struct HermiteSampling {
+            WorldInfo &wi;
+            std::vector<util::voxelgrid::Voxel> &voxels;
+            DualContouring::Statistics &stats;
+
+            template<class EdgeIntersectionFnc, class VertexPlacementFnc>
+            void operator()(EdgeIntersectionFnc eisect, VertexPlacementFnc, Scalar)
+            {
+                sampleHermite(wi, eisect, voxels, stats);
+            }
+        };
+
+        bool
+        DualContouring::saveHermiteData(SDFNodePtr scene, const std::string &filename, EComputeType et)
+        {
+            namespace vg = util::voxelgrid;
+
+            WorldInfo wi(scene, _lower, _upper, _resolution);
+            wi.pruneIntervals = _pruneIntervals;
+
+            if (_iso != S(0)) {
+                wi.scene = make()
+                    .displacement().offset(-_iso)
+                        .wrap().node(wi.scene)
+                    .end();
+            }
+
+            _stats = Statistics();
+
+            if (!wi.packable())
+                return false;
+
+            std::vector<vg::Voxel> voxels;
+            HermiteSampling sampling = {wi, voxels, _stats};
+            dispatchExtraction(et, _rootFinder, _rootTolerance, _svdThreshold, _simplifyError, sampling);
+
+            std::vector<HermiteCache::Edge> edges;
+            edges.reserve(wi.eHermite.size());
+            for (auto iter = wi.eHermite.begin(); iter != wi.eHermite.end(); ++iter) {
+                const vg::VoxelEdge e = iter->first;
+                const Hermite &h = iter->second;
+
+                HermiteCache::Edge r;
+                for (int i = 0; i < 3; ++i) {
+                    r.corner[i] = e.first(i);
+                    r.p[i] = h.p(i);
+                    r.n[i] = h.n(i);
+                }
+                r.axis = (unsigned char)((e.second - e.first).dot(vg::Voxel(0, 1, 2)));
+                r.flip = h.needFlip ? 1 : 0;
+                r.reserved[0] = r.reserved[1] = 0;
+                edges.push_back(r);
+            }
+
+            return HermiteCache::write(filename, _lower, _upper, _resolution, edges, voxels);
+        }
+
+        IndexedSurface
+        DualContouring::computeFromHermiteData(const HermiteCache &cache, EComputeType et)
+        {
+            namespace vg = util::voxelgrid;
+
+            WorldInfo wi(SDFNodePtr(), cache.lowerBounds(), cache.upperBounds(), cache.resolution());
+            if (!wi.packable()) {
+                _stats = Statistics();
+                return IndexedSurface();
+            }
+
+            for (int i = 0; i < cache.edgeCount(); ++i) {
+                const HermiteCache::Edge &r = cache.edge(i);
+
+                const vg::Voxel first(r.corner[0], r.corner[1], r.corner[2]);
+                const vg::Voxel second = first + vg::Voxel::Unit(r.axis);
+
+                Hermite &h = wi.eHermite[vg::VoxelEdge(first, second)];
+                h.p = Vector(r.p[0], r.p[1], r.p[2]);
+                h.n = Vector(r.n[0], r.n[1], r.n[2]);
+                h.needFlip = r.flip != 0;
+            }
+
+            std::vector<vg::Voxel> voxels(cache.voxelCount());
+            for (int i = 0; i < cache.voxelCount(); ++i)
+                voxels[i] = cache.voxel(i);
+
+            _stats = Statistics();
+            _stats.crossingEdges = size_t(cache.edgeCount());
+
+            // Adaptive simplification needs the scene to test collapses and is not applied.
+            IndexedSurface surface;
+            if (et == COMPUTE_MIDPOINT)
+                surface = buildSurface(wi, voxels, VertexPlacementMidpoint(), _faceType, S(0));
+            else
+                surface = buildSurface(wi, voxels, VertexPlacementDC(_svdThreshold), _faceType, S(0));
+
+            optimizeLocality(_locality, surface, _stats);
+            return surface;
         }
 
     }
@@ -0,0 +1,148 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/surface/hermite_cache.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+namespace volplay {
+
+    namespace surface {
+
+        static const char hermiteMagic[4] = {'V', 'P', 'H', 'C'};
+        static const int hermiteVersion = 1;
+
+        /** Fixed size header of cache files. */
+        struct HermiteHeader {
+            char magic[4];
+            int version;
+            Scalar lower[3];
+            Scalar upper[3];
+            Scalar resolution[3];
+            int edgeCount;
+            int voxelCount;
+        };
+
+        HermiteCache::HermiteCache()
+            : _lower(Vector::Zero()), _upper(Vector::Zero()), _resolution(Vector::Zero()),
+              _edges(0), _voxels(0), _edgeCount(0), _voxelCount(0)
+        {}
+
+        bool HermiteCache::open(const std::string &filename)
+        {
+            _edges = 0;
+            _voxels = 0;
+            _edgeCount = 0;
+            _voxelCount = 0;
+
+            if (!_file.open(filename))
+                return false;
+
+            HermiteHeader h;
+            if (_file.size() < sizeof(h)) {
+                _file.close();
+                return false;
+            }
+            memcpy(&h, _file.data(), sizeof(h));
+
+            const size_t expected = sizeof(h) + 
+                size_t(h.edgeCount) * sizeof(Edge) + 
+                size_t(h.voxelCount) * 3 * sizeof(Index::Scalar);
+
+            if (!std::equal(h.magic, h.magic + 4, hermiteMagic) || h.version != hermiteVersion || 
+                h.edgeCount < 0 || h.voxelCount < 0 || _file.size() != expected) 
+            {
+                _file.close();
+                return false;
+            }
+
+            _lower = Vector(h.lower[0], h.lower[1], h.lower[2]);
+            _upper = Vector(h.upper[0], h.upper[1], h.upper[2]);
+            _resolution = Vector(h.resolution[0], h.resolution[1], h.resolution[2]);
+
+            // Records follow the header without padding. Mapped memory is page aligned and 
+            // all record sizes are multiples of four bytes, so records are properly aligned.
+            _edgeCount = h.edgeCount;
+            _voxelCount = h.voxelCount;
+            _edges = reinterpret_cast<const Edge *>(_file.data() + sizeof(h));
+            _voxels = reinterpret_cast<const Index::Scalar *>(_edges + _edgeCount);
+            return true;
+        }
+
+        bool HermiteCache::write(
+            const std::string &filename,
+            const Vector &lower, const Vector &upper, const Vector &resolution,
+            const std::vector<Edge> &edges,
+            const std::vector<Index> &voxels)
+        {
+            FILE *f = fopen(filename.c_str(), "wb");
+            if (f == 0)
+                return false;
+
+            HermiteHeader h;
+            memset(&h, 0, sizeof(h));
+            std::copy(hermiteMagic, hermiteMagic + 4, h.magic);
+            h.version = hermiteVersion;
+            for (int i = 0; i < 3; ++i) {
+                h.lower[i] = lower(i);
+                h.upper[i] = upper(i);
+                h.resolution[i] = resolution(i);
+            }
+            h.edgeCount = int(edges.size());
+            h.voxelCount = int(voxels.size());
+
+            bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+            if (ok && !edges.empty())
+                ok = fwrite(&edges[0], sizeof(Edge), edges.size(), f) == edges.size();
+            for (size_t i = 0; ok && i < voxels.size(); ++i)
+                ok = fwrite(voxels[i].data(), sizeof(Index::Scalar), 3, f) == 3;
+
+            fclose(f);
+            return ok;
+        }
+
+        const Vector &HermiteCache::lowerBounds() const
+        {
+            return _lower;
+        }
+
+        const Vector &HermiteCache::upperBounds() const
+        {
+            return _upper;
+        }
+
+        const Vector &HermiteCache::resolution() const
+        {
+            return _resolution;
+        }
+
+        int HermiteCache::edgeCount() const
+        {
+            return _edgeCount;
+        }
+
+        const HermiteCache::Edge &HermiteCache::edge(int i) const
+        {
+            return _edges[i];
+        }
+
+        int HermiteCache::voxelCount() const
+        {
+            return _voxelCount;
+        }
+
+        Index HermiteCache::voxel(int i) const
+        {
+            const Index::Scalar *v = _voxels + 3 * i;
+            return Index(v[0], v[1], v[2]);
+        }
+
+    }
+}
@@ -0,0 +1,235 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/surface/incremental_mesher.h>
+#include <volplay/util/voxel_grid.h>
+#include <volplay/util/parallel.h>
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace volplay {
+
+    namespace surface {
+
+        IncrementalMesher::IncrementalMesher(const DualContouring &dc, int blockSize, DualContouring::EComputeType et)
+            : _dc(dc),
+              _computeType(et),
+              _grid(dc.blockGrid(blockSize)),
+              _toGrid(util::voxelgrid::buildWorldToLocal(dc.lowerBounds(), dc.resolution())),
+              _blocks(_grid.size()),
+              _blockSurfaces(_grid.size()),
+              _dirty(_grid.size(), 1),
+              _assembled(false),
+              _extracted(0)
+        {}
+
+        const std::vector<int> &IncrementalMesher::compute(SDFNodePtr scene)
+        {
+            std::fill(_dirty.begin(), _dirty.end(), 1);
+            return update(scene);
+        }
+
+        void IncrementalMesher::markDirty(const Vector &lower, const Vector &upper)
+        {
+            // Corners whose samples may change. The margin covers edge intersections and normals 
+            // evaluated slightly outside of the region.
+            const Vector l = _toGrid * lower;
+            const Vector u = _toGrid * upper;
+            Index cl, cu;
+            for (int i = 0; i < 3; ++i) {
+                cl(i) = Index::Scalar(std::floor(l(i))) - 1;
+                cu(i) = Index::Scalar(std::ceil(u(i))) + 1;
+            }
+
+            if ((cu.array() < _grid.lower().array()).any() || (cl.array() > _grid.upper().array()).any())
+                return;
+
+            // Edges and voxels touching these corners start up to one voxel below. Voxels outside
+            // the grid belong to the blocks at its border, so clamping to the grid preserves ownership.
+            const Index vl = (cl - Index::Ones()).cwiseMax(_grid.lower()).cwiseMin(_grid.upper());
+            const Index vu = cu.cwiseMax(_grid.lower()).cwiseMin(_grid.upper());
+
+            for (int b = 0; b < _grid.size(); ++b) {
+                const Index bl = _grid.blockLower(b);
+                const Index bu = _grid.ownedUpper(b);
+                if ((bl.array() <= vu.array()).all() && (bu.array() >= vl.array()).all())
+                    _dirty[b] = 1;
+            }
+        }
+
+        const std::vector<int> &IncrementalMesher::update(SDFNodePtr scene)
+        {
+            std::vector<char> changed(_grid.size(), 0);
+
+            _extracted = 0;
+            for (int b = 0; b < _grid.size(); ++b) {
+                if (!_dirty[b])
+                    continue;
+
+                _dc.computeBlock(scene, _grid, b, _blocks[b], _computeType);
+                _dirty[b] = 0;
+                ++_extracted;
+
+                // Faces reference voxels at most one below the edges they belong to, so only this 
+                // block and the blocks following it along each axis reference its vertices.
+                const Index u = _grid.ownedUpper(b);
+                for (int n = 0; n < 8; ++n) {
+                    const Index c = u + Index(n & 1, (n >> 1) & 1, n >> 2);
+                    if (_grid.contains(c))
+                        changed[_grid.owner(c)] = 1;
+                }
+            }
+
+            _changed.clear();
+            for (int b = 0; b < _grid.size(); ++b) {
+                if (changed[b])
+                    _changed.push_back(b);
+            }
+
+            util::parallelFor(0, int(_changed.size()), [&](int i) {
+                resolveBlock(_changed[i]);
+            });
+
+            if (!_changed.empty())
+                _assembled = false;
+
+            return _changed;
+        }
+
+        const IndexedSurface &IncrementalMesher::blockSurface(int b) const
+        {
+            return _blockSurfaces[b];
+        }
+
+        const IndexedSurface &IncrementalMesher::surface() const
+        {
+            if (!_assembled)
+                assemble();
+            return _surface;
+        }
+
+        int IncrementalMesher::extractedBlocks() const
+        {
+            return _extracted;
+        }
+
+        int IncrementalMesher::blockCount() const
+        {
+            return _grid.size();
+        }
+
+        bool IncrementalMesher::resolveQuad(const MeshChunk &m, size_t i, int *owners, int *locals) const
+        {
+            // Voxels outside of the grid belong to the blocks at its border.
+            for (int j = 0; j < 4; ++j) {
+                const Index &v = m.quads[i + j];
+                owners[j] = _grid.owner(v.cwiseMax(_grid.lower()).cwiseMin(_grid.upper()));
+                locals[j] = _blocks[owners[j]].find(v);
+                if (locals[j] < 0)
+                    return false;
+            }
+            return true;
+        }
+
+        void IncrementalMesher::resolveBlock(int b)
+        {
+            const MeshChunk &m = _blocks[b];
+
+            // Vertices of other blocks are appended once per referenced vertex.
+            std::vector<Vector> vertices(m.vertices);
+            std::map<std::pair<int, int>, int> copies;
+            std::vector<Index::Scalar> faces;
+            faces.reserve(m.quads.size() / 4 * 6);
+
+            for (size_t i = 0; i + 3 < m.quads.size(); i += 4) {
+                // Quads referencing vertices their owning blocks did not generate are dropped, as by mergeChunks.
+                int owners[4], locals[4];
+                if (!resolveQuad(m, i, owners, locals))
+                    continue;
+
+                Index::Scalar ids[4];
+                for (int j = 0; j < 4; ++j) {
+                    if (owners[j] == b) {
+                        ids[j] = locals[j];
+                        continue;
+                    }
+
+                    const std::pair<std::map<std::pair<int, int>, int>::iterator, bool> r = 
+                        copies.insert(std::make_pair(std::make_pair(owners[j], locals[j]), int(vertices.size())));
+                    if (r.second)
+                        vertices.push_back(_blocks[owners[j]].vertices[locals[j]]);
+                    ids[j] = r.first->second;
+                }
+
+                const Index::Scalar tris[6] = { ids[0], ids[1], ids[2], ids[0], ids[2], ids[3] };
+                faces.insert(faces.end(), tris, tris + 6);
+            }
+
+            IndexedSurface &s = _blockSurfaces[b];
+            s.vertices.resize(3, vertices.size());
+            for (size_t i = 0; i < vertices.size(); ++i)
+                s.vertices.col(i) = vertices[i];
+
+            s.faces.resize(3, faces.size() / 3);
+            for (size_t i = 0; i < faces.size(); ++i)
+                s.faces(i % 3, i / 3) = faces[i];
+        }
+
+        void IncrementalMesher::assemble() const
+        {
+            const int n = int(_blocks.size());
+
+            std::vector<int> vertexOffsets(n + 1, 0);
+            for (int b = 0; b < n; ++b)
+                vertexOffsets[b + 1] = vertexOffsets[b] + int(_blocks[b].vertices.size());
+
+            // Resolve references first, as quads with unresolved references are dropped.
+            std::vector< std::vector<Index::Scalar> > faces(n);
+            util::parallelFor(0, n, [&](int b) {
+                const MeshChunk &m = _blocks[b];
+                std::vector<Index::Scalar> &f = faces[b];
+                f.reserve(m.quads.size() / 4 * 6);
+
+                for (size_t i = 0; i + 3 < m.quads.size(); i += 4) {
+                    int owners[4], locals[4];
+                    if (!resolveQuad(m, i, owners, locals))
+                        continue;
+
+                    Index::Scalar ids[4];
+                    for (int j = 0; j < 4; ++j)
+                        ids[j] = vertexOffsets[owners[j]] + locals[j];
+
+                    const Index::Scalar tris[6] = { ids[0], ids[1], ids[2], ids[0], ids[2], ids[3] };
+                    f.insert(f.end(), tris, tris + 6);
+                }
+            });
+
+            std::vector<int> faceOffsets(n + 1, 0);
+            for (int b = 0; b < n; ++b)
+                faceOffsets[b + 1] = faceOffsets[b] + int(faces[b].size() / 3);
+
+            _surface.vertices.resize(3, vertexOffsets[n]);
+            _surface.faces.resize(3, faceOffsets[n]);
+
+            util::parallelFor(0, n, [&](int b) {
+                const MeshChunk &m = _blocks[b];
+
+                for (size_t i = 0; i < m.vertices.size(); ++i)
+                    _surface.vertices.col(vertexOffsets[b] + i) = m.vertices[i];
+
+                for (size_t i = 0; i < faces[b].size(); ++i)
+                    _surface.faces(i % 3, faceOffsets[b] + i / 3) = faces[b][i];
+            });
+
+            _assembled = true;
+        }
+
+    }
+}
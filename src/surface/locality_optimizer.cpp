@@ -0,0 +1,230 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/surface/locality_optimizer.h>
+#include <volplay/surface/indexed_surface.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+
+namespace volplay {
+
+    namespace surface {
+
+        LocalityOptimizer::Statistics::Statistics()
+            : acmrBefore(0), acmrAfter(0)
+        {}
+
+        LocalityOptimizer::LocalityOptimizer()
+            : _cacheSize(16)
+        {}
+
+        void LocalityOptimizer::setCacheSize(int size)
+        {
+            _cacheSize = std::max<int>(3, size);
+        }
+
+        const LocalityOptimizer::Statistics &LocalityOptimizer::statistics() const
+        {
+            return _stats;
+        }
+
+        /** Spread the lower 21 bits of x so that two zero bits follow each bit. */
+        inline uint64_t spreadBits(uint64_t x)
+        {
+            x &= 0x1fffff;
+            x = (x | (x << 32)) & 0x001f00000000ffffULL;
+            x = (x | (x << 16)) & 0x001f0000ff0000ffULL;
+            x = (x | (x << 8)) & 0x100f00f00f00f00fULL;
+            x = (x | (x << 4)) & 0x10c30c30c30c30c3ULL;
+            x = (x | (x << 2)) & 0x1249249249249249ULL;
+            return x;
+        }
+
+        /** Permutation of vertices sorting them along a Morton curve over their bounding box. */
+        void mortonOrder(const IndexedSurface::VertexMatrix &v, std::vector<int> &order)
+        {
+            const int n = int(v.cols());
+            order.resize(n);
+            if (n == 0)
+                return;
+
+            const Vector lower = v.rowwise().minCoeff();
+            const Vector extent = (v.rowwise().maxCoeff() - lower).cwiseMax(Vector::Constant(Scalar(1e-12)));
+            const Vector scale = extent.cwiseInverse() * Scalar((1 << 21) - 1);
+
+            std::vector< std::pair<uint64_t, int> > codes(n);
+            for (int i = 0; i < n; ++i) {
+                const Vector q = (v.col(i) - lower).cwiseProduct(scale);
+                codes[i].first = 
+                    spreadBits(uint64_t(q.x())) | 
+                    (spreadBits(uint64_t(q.y())) << 1) | 
+                    (spreadBits(uint64_t(q.z())) << 2);
+                codes[i].second = i;
+            }
+            std::sort(codes.begin(), codes.end());
+
+            for (int i = 0; i < n; ++i)
+                order[i] = codes[i].second;
+        }
+
+        /** 
+            Face order of Tipsify for a FIFO cache of size k. Vertices are expected to be in an order 
+            with spatial locality, as it serves to find the next vertex when fanning runs into a dead end.
+        */
+        void tipsify(const IndexedSurface::FaceMatrix &f, int nVertices, int k, std::vector<int> &order)
+        {
+            const int nFaces = int(f.cols());
+            const int rows = int(f.rows());
+
+            // Faces incident to each vertex in compressed row form.
+            std::vector<int> live(nVertices, 0);
+            for (int i = 0; i < nFaces; ++i) {
+                for (int j = 0; j < rows; ++j)
+                    ++live[f(j, i)];
+            }
+
+            std::vector<int> offsets(nVertices + 1, 0);
+            for (int v = 0; v < nVertices; ++v)
+                offsets[v + 1] = offsets[v] + live[v];
+
+            std::vector<int> incident(offsets[nVertices]);
+            std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+            for (int i = 0; i < nFaces; ++i) {
+                for (int j = 0; j < rows; ++j)
+                    incident[fill[f(j, i)]++] = i;
+            }
+
+            std::vector<int> cacheTime(nVertices, 0);
+            std::vector<char> emitted(nFaces, 0);
+            std::vector<int> deadEnd;
+            std::vector<int> candidates;
+
+            order.clear();
+            order.reserve(nFaces);
+
+            int time = k + 1;
+            int cursor = 0;
+            int fan = nFaces > 0 ? 0 : -1;
+
+            while (fan >= 0) {
+                candidates.clear();
+
+                for (int o = offsets[fan]; o < offsets[fan + 1]; ++o) {
+                    const int face = incident[o];
+                    if (emitted[face])
+                        continue;
+
+                    emitted[face] = 1;
+                    order.push_back(face);
+
+                    for (int j = 0; j < rows; ++j) {
+                        const int v = f(j, face);
+                        deadEnd.push_back(v);
+                        candidates.push_back(v);
+                        --live[v];
+                        if (time - cacheTime[v] > k)
+                            cacheTime[v] = time++;
+                    }
+                }
+
+                // Prefer the candidate still in cache longest whose remaining faces fit into the cache.
+                fan = -1;
+                int best = -1;
+                for (size_t i = 0; i < candidates.size(); ++i) {
+                    const int v = candidates[i];
+                    if (live[v] <= 0)
+                        continue;
+
+                    const int age = time - cacheTime[v];
+                    const int p = (age + 2 * live[v] <= k) ? age : 0;
+                    if (p > best) {
+                        best = p;
+                        fan = v;
+                    }
+                }
+
+                if (fan >= 0)
+                    continue;
+
+                // Dead end, restart from recently used vertices or the next vertex in order.
+                while (!deadEnd.empty() && fan < 0) {
+                    const int v = deadEnd.back();
+                    deadEnd.pop_back();
+                    if (live[v] > 0)
+                        fan = v;
+                }
+
+                while (fan < 0 && cursor < nVertices) {
+                    if (live[cursor] > 0)
+                        fan = cursor;
+                    ++cursor;
+                }
+            }
+        }
+
+        void LocalityOptimizer::apply(IndexedSurface &s)
+        {
+            _stats = Statistics();
+            _stats.acmrBefore = averageCacheMissRatio(s, _cacheSize);
+
+            const int nVertices = int(s.vertices.cols());
+            const int nFaces = int(s.faces.cols());
+
+            // Vertices in Morton order.
+            std::vector<int> order;
+            mortonOrder(s.vertices, order);
+
+            std::vector<int> remap(nVertices);
+            IndexedSurface::VertexMatrix vertices(3, nVertices);
+            for (int i = 0; i < nVertices; ++i) {
+                remap[order[i]] = i;
+                vertices.col(i) = s.vertices.col(order[i]);
+            }
+            s.vertices.swap(vertices);
+
+            for (int i = 0; i < nFaces; ++i) {
+                for (int j = 0; j < int(s.faces.rows()); ++j)
+                    s.faces(j, i) = remap[s.faces(j, i)];
+            }
+
+            // Faces in cache friendly order.
+            tipsify(s.faces, nVertices, _cacheSize, order);
+
+            IndexedSurface::FaceMatrix faces(s.faces.rows(), nFaces);
+            for (int i = 0; i < nFaces; ++i)
+                faces.col(i) = s.faces.col(order[i]);
+            s.faces.swap(faces);
+
+            _stats.acmrAfter = averageCacheMissRatio(s, _cacheSize);
+        }
+
+        Scalar LocalityOptimizer::averageCacheMissRatio(const IndexedSurface &s, int cacheSize)
+        {
+            const int rows = int(s.faces.rows());
+            const size_t triangles = size_t(s.faces.cols()) * size_t(std::max<int>(1, rows - 2));
+            if (triangles == 0)
+                return Scalar(0);
+
+            // A vertex is in cache when less than cacheSize misses happened since it was loaded.
+            std::vector<long long> loaded(s.vertices.cols(), -1);
+            long long misses = 0;
+            for (int i = 0; i < int(s.faces.cols()); ++i) {
+                for (int j = 0; j < rows; ++j) {
+                    long long &t = loaded[s.faces(j, i)];
+                    if (t < 0 || misses - t > cacheSize)
+                        t = misses++;
+                }
+            }
+
+            return Scalar(misses) / Scalar(triangles);
+        }
+
+    }
+}
@@ -0,0 +1,420 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/surface/marching_cubes.h>
+#include <volplay/surface/indexed_surface.h>
+#include <volplay/surface/block_grid.h>
+#include <volplay/sdf_node.h>
+#include <volplay/util/voxel_grid.h>
+#include <volplay/util/parallel.h>
+
+namespace volplay {
+
+    namespace surface {
+
+        /** 
+            Edges of a cube given by the offset of their minimum corner and their axis. The 
+            order matches util::voxelgrid::edges.
+        */
+        static const int mcEdges[12][4] = {
+            {0, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 1, 1, 0},
+            {0, 0, 0, 1}, {1, 0, 0, 1}, {0, 0, 1, 1}, {1, 0, 1, 1},
+            {0, 0, 0, 2}, {1, 0, 0, 2}, {0, 1, 0, 2}, {1, 1, 0, 2}
+        };
+
+        /**
+            Triangulation of the 256 cube configurations. 
+            
+            Bit i of the configuration is set when corner (i & 1, (i >> 1) & 1, (i >> 2) & 1) 
+            is inside. Each row lists up to five triangles as triples of edge indices terminated 
+            by -1. Triangles are oriented counter-clockwise when seen from outside. Ambiguous faces
+            are resolved by separating inside corners, which is consistent between neighboring cubes.
+        */
+static const int mcTriangleTable[256][16] = {
+            {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 9, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 8, 1, 8, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 1, 10, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 8, 1, 8, 9, 1, 9, 5, -1, -1, -1, -1, -1, -1, -1},
+            {5, 11, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 5, 11, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 11, 0, 11, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 9, 4, 9, 11, 4, 11, 1, -1, -1, -1, -1, -1, -1, -1},
+            {5, 11, 10, 5, 10, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {5, 11, 10, 5, 10, 8, 5, 8, 0, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 11, 0, 11, 10, 0, 10, 4, -1, -1, -1, -1, -1, -1, -1},
+            {9, 11, 10, 9, 10, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {2, 8, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 6, 2, 4, 2, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 2, 8, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {2, 9, 5, 2, 5, 4, 2, 4, 6, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 4, 2, 8, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 6, 1, 6, 2, 1, 2, 0, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 1, 10, 4, 2, 8, 6, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 6, 1, 6, 2, 1, 2, 9, 1, 9, 5, -1, -1, -1, -1},
+            {5, 11, 1, 2, 8, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 6, 2, 4, 2, 0, 5, 11, 1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 11, 0, 11, 1, 2, 8, 6, -1, -1, -1, -1, -1, -1, -1},
+            {4, 6, 2, 4, 2, 9, 4, 9, 11, 4, 11, 1, -1, -1, -1, -1},
+            {2, 8, 6, 5, 11, 10, 5, 10, 4, -1, -1, -1, -1, -1, -1, -1},
+            {5, 11, 10, 5, 10, 6, 5, 6, 2, 5, 2, 0, -1, -1, -1, -1},
+            {0, 9, 11, 0, 11, 10, 0, 10, 4, 2, 8, 6, -1, -1, -1, -1},
+            {2, 9, 11, 2, 11, 10, 2, 10, 6, -1, -1, -1, -1, -1, -1, -1},
+            {7, 9, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 7, 9, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 2, 7, 0, 7, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {7, 5, 4, 7, 4, 8, 7, 8, 2, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 4, 7, 9, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 8, 1, 8, 0, 7, 9, 2, -1, -1, -1, -1, -1, -1, -1},
+            {0, 2, 7, 0, 7, 5, 1, 10, 4, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 8, 1, 8, 2, 1, 2, 7, 1, 7, 5, -1, -1, -1, -1},
+            {5, 11, 1, 7, 9, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 5, 11, 1, 7, 9, 2, -1, -1, -1, -1, -1, -1, -1},
+            {0, 2, 7, 0, 7, 11, 0, 11, 1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 2, 4, 2, 7, 4, 7, 11, 4, 11, 1, -1, -1, -1, -1},
+            {7, 9, 2, 5, 11, 10, 5, 10, 4, -1, -1, -1, -1, -1, -1, -1},
+            {5, 11, 10, 5, 10, 8, 5, 8, 0, 7, 9, 2, -1, -1, -1, -1},
+            {0, 2, 7, 0, 7, 11, 0, 11, 10, 0, 10, 4, -1, -1, -1, -1},
+            {7, 11, 10, 7, 10, 8, 7, 8, 2, -1, -1, -1, -1, -1, -1, -1},
+            {7, 9, 8, 7, 8, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 6, 7, 4, 7, 9, 4, 9, 0, -1, -1, -1, -1, -1, -1, -1},
+            {0, 8, 6, 0, 6, 7, 0, 7, 5, -1, -1, -1, -1, -1, -1, -1},
+            {4, 6, 7, 4, 7, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 4, 7, 9, 8, 7, 8, 6, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 6, 1, 6, 7, 1, 7, 9, 1, 9, 0, -1, -1, -1, -1},
+            {0, 8, 6, 0, 6, 7, 0, 7, 5, 1, 10, 4, -1, -1, -1, -1},
+            {1, 10, 6, 1, 6, 7, 1, 7, 5, -1, -1, -1, -1, -1, -1, -1},
+            {5, 11, 1, 7, 9, 8, 7, 8, 6, -1, -1, -1, -1, -1, -1, -1},
+            {4, 6, 7, 4, 7, 9, 4, 9, 0, 5, 11, 1, -1, -1, -1, -1},
+            {0, 8, 6, 0, 6, 7, 0, 7, 11, 0, 11, 1, -1, -1, -1, -1},
+            {4, 6, 7, 4, 7, 11, 4, 11, 1, -1, -1, -1, -1, -1, -1, -1},
+            {5, 11, 10, 5, 10, 4, 7, 9, 8, 7, 8, 6, -1, -1, -1, -1},
+            {5, 11, 10, 5, 10, 6, 5, 6, 7, 5, 7, 9, 5, 9, 0, -1},
+            {0, 8, 6, 0, 6, 7, 0, 7, 11, 0, 11, 10, 0, 10, 4, -1},
+            {7, 11, 10, 7, 10, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {6, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {6, 10, 3, 4, 8, 9, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1},
+            {1, 3, 6, 1, 6, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {1, 3, 6, 1, 6, 8, 1, 8, 0, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 1, 3, 6, 1, 6, 4, -1, -1, -1, -1, -1, -1, -1},
+            {1, 3, 6, 1, 6, 8, 1, 8, 9, 1, 9, 5, -1, -1, -1, -1},
+            {5, 11, 1, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 5, 11, 1, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 11, 0, 11, 1, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 9, 4, 9, 11, 4, 11, 1, 6, 10, 3, -1, -1, -1, -1},
+            {6, 4, 5, 6, 5, 11, 6, 11, 3, -1, -1, -1, -1, -1, -1, -1},
+            {5, 11, 3, 5, 3, 6, 5, 6, 8, 5, 8, 0, -1, -1, -1, -1},
+            {0, 9, 11, 0, 11, 3, 0, 3, 6, 0, 6, 4, -1, -1, -1, -1},
+            {6, 8, 9, 6, 9, 11, 6, 11, 3, -1, -1, -1, -1, -1, -1, -1},
+            {2, 8, 10, 2, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 10, 3, 4, 3, 2, 4, 2, 0, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 2, 8, 10, 2, 10, 3, -1, -1, -1, -1, -1, -1, -1},
+            {2, 9, 5, 2, 5, 4, 2, 4, 10, 2, 10, 3, -1, -1, -1, -1},
+            {1, 3, 2, 1, 2, 8, 1, 8, 4, -1, -1, -1, -1, -1, -1, -1},
+            {1, 3, 2, 1, 2, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 1, 3, 2, 1, 2, 8, 1, 8, 4, -1, -1, -1, -1},
+            {1, 3, 2, 1, 2, 9, 1, 9, 5, -1, -1, -1, -1, -1, -1, -1},
+            {5, 11, 1, 2, 8, 10, 2, 10, 3, -1, -1, -1, -1, -1, -1, -1},
+            {4, 10, 3, 4, 3, 2, 4, 2, 0, 5, 11, 1, -1, -1, -1, -1},
+            {0, 9, 11, 0, 11, 1, 2, 8, 10, 2, 10, 3, -1, -1, -1, -1},
+            {4, 10, 3, 4, 3, 2, 4, 2, 9, 4, 9, 11, 4, 11, 1, -1},
+            {2, 8, 4, 2, 4, 5, 2, 5, 11, 2, 11, 3, -1, -1, -1, -1},
+            {5, 11, 3, 5, 3, 2, 5, 2, 0, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 11, 0, 11, 3, 0, 3, 2, 0, 2, 8, 0, 8, 4, -1},
+            {2, 9, 11, 2, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {7, 9, 2, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 7, 9, 2, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1},
+            {0, 2, 7, 0, 7, 5, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1},
+            {7, 5, 4, 7, 4, 8, 7, 8, 2, 6, 10, 3, -1, -1, -1, -1},
+            {1, 3, 6, 1, 6, 4, 7, 9, 2, -1, -1, -1, -1, -1, -1, -1},
+            {1, 3, 6, 1, 6, 8, 1, 8, 0, 7, 9, 2, -1, -1, -1, -1},
+            {0, 2, 7, 0, 7, 5, 1, 3, 6, 1, 6, 4, -1, -1, -1, -1},
+            {1, 3, 6, 1, 6, 8, 1, 8, 2, 1, 2, 7, 1, 7, 5, -1},
+            {5, 11, 1, 7, 9, 2, 6, 10, 3, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 5, 11, 1, 7, 9, 2, 6, 10, 3, -1, -1, -1, -1},
+            {0, 2, 7, 0, 7, 11, 0, 11, 1, 6, 10, 3, -1, -1, -1, -1},
+            {4, 8, 2, 4, 2, 7, 4, 7, 11, 4, 11, 1, 6, 10, 3, -1},
+            {7, 9, 2, 6, 4, 5, 6, 5, 11, 6, 11, 3, -1, -1, -1, -1},
+            {5, 11, 3, 5, 3, 6, 5, 6, 8, 5, 8, 0, 7, 9, 2, -1},
+            {0, 2, 7, 0, 7, 11, 0, 11, 3, 0, 3, 6, 0, 6, 4, -1},
+            {7, 11, 3, 7, 3, 6, 7, 6, 8, 7, 8, 2, -1, -1, -1, -1},
+            {7, 9, 8, 7, 8, 10, 7, 10, 3, -1, -1, -1, -1, -1, -1, -1},
+            {4, 10, 3, 4, 3, 7, 4, 7, 9, 4, 9, 0, -1, -1, -1, -1},
+            {0, 8, 10, 0, 10, 3, 0, 3, 7, 0, 7, 5, -1, -1, -1, -1},
+            {7, 5, 4, 7, 4, 10, 7, 10, 3, -1, -1, -1, -1, -1, -1, -1},
+            {1, 3, 7, 1, 7, 9, 1, 9, 8, 1, 8, 4, -1, -1, -1, -1},
+            {1, 3, 7, 1, 7, 9, 1, 9, 0, -1, -1, -1, -1, -1, -1, -1},
+            {0, 8, 4, 0, 4, 1, 0, 1, 3, 0, 3, 7, 0, 7, 5, -1},
+            {1, 3, 7, 1, 7, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {5, 11, 1, 7, 9, 8, 7, 8, 10, 7, 10, 3, -1, -1, -1, -1},
+            {4, 10, 3, 4, 3, 7, 4, 7, 9, 4, 9, 0, 5, 11, 1, -1},
+            {0, 8, 10, 0, 10, 3, 0, 3, 7, 0, 7, 11, 0, 11, 1, -1},
+            {4, 10, 3, 4, 3, 7, 4, 7, 11, 4, 11, 1, -1, -1, -1, -1},
+            {7, 9, 8, 7, 8, 4, 7, 4, 5, 7, 5, 11, 7, 11, 3, -1},
+            {5, 11, 3, 5, 3, 7, 5, 7, 9, 5, 9, 0, -1, -1, -1, -1},
+            {0, 8, 4, 7, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {7, 11, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {3, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 3, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 3, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {3, 11, 7, 4, 8, 9, 4, 9, 5, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 4, 3, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 8, 1, 8, 0, 3, 11, 7, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 1, 10, 4, 3, 11, 7, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 8, 1, 8, 9, 1, 9, 5, 3, 11, 7, -1, -1, -1, -1},
+            {5, 7, 3, 5, 3, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 5, 7, 3, 5, 3, 1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 7, 0, 7, 3, 0, 3, 1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 9, 4, 9, 7, 4, 7, 3, 4, 3, 1, -1, -1, -1, -1},
+            {3, 10, 4, 3, 4, 5, 3, 5, 7, -1, -1, -1, -1, -1, -1, -1},
+            {5, 7, 3, 5, 3, 10, 5, 10, 8, 5, 8, 0, -1, -1, -1, -1},
+            {0, 9, 7, 0, 7, 3, 0, 3, 10, 0, 10, 4, -1, -1, -1, -1},
+            {3, 10, 8, 3, 8, 9, 3, 9, 7, -1, -1, -1, -1, -1, -1, -1},
+            {2, 8, 6, 3, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 6, 2, 4, 2, 0, 3, 11, 7, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 2, 8, 6, 3, 11, 7, -1, -1, -1, -1, -1, -1, -1},
+            {2, 9, 5, 2, 5, 4, 2, 4, 6, 3, 11, 7, -1, -1, -1, -1},
+            {1, 10, 4, 2, 8, 6, 3, 11, 7, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 6, 1, 6, 2, 1, 2, 0, 3, 11, 7, -1, -1, -1, -1},
+            {0, 9, 5, 1, 10, 4, 2, 8, 6, 3, 11, 7, -1, -1, -1, -1},
+            {1, 10, 6, 1, 6, 2, 1, 2, 9, 1, 9, 5, 3, 11, 7, -1},
+            {5, 7, 3, 5, 3, 1, 2, 8, 6, -1, -1, -1, -1, -1, -1, -1},
+            {4, 6, 2, 4, 2, 0, 5, 7, 3, 5, 3, 1, -1, -1, -1, -1},
+            {0, 9, 7, 0, 7, 3, 0, 3, 1, 2, 8, 6, -1, -1, -1, -1},
+            {4, 6, 2, 4, 2, 9, 4, 9, 7, 4, 7, 3, 4, 3, 1, -1},
+            {2, 8, 6, 3, 10, 4, 3, 4, 5, 3, 5, 7, -1, -1, -1, -1},
+            {5, 7, 3, 5, 3, 10, 5, 10, 6, 5, 6, 2, 5, 2, 0, -1},
+            {0, 9, 7, 0, 7, 3, 0, 3, 10, 0, 10, 4, 2, 8, 6, -1},
+            {2, 9, 7, 2, 7, 3, 2, 3, 10, 2, 10, 6, -1, -1, -1, -1},
+            {3, 11, 9, 3, 9, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 3, 11, 9, 3, 9, 2, -1, -1, -1, -1, -1, -1, -1},
+            {0, 2, 3, 0, 3, 11, 0, 11, 5, -1, -1, -1, -1, -1, -1, -1},
+            {3, 11, 5, 3, 5, 4, 3, 4, 8, 3, 8, 2, -1, -1, -1, -1},
+            {1, 10, 4, 3, 11, 9, 3, 9, 2, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 8, 1, 8, 0, 3, 11, 9, 3, 9, 2, -1, -1, -1, -1},
+            {0, 2, 3, 0, 3, 11, 0, 11, 5, 1, 10, 4, -1, -1, -1, -1},
+            {1, 10, 8, 1, 8, 2, 1, 2, 3, 1, 3, 11, 1, 11, 5, -1},
+            {5, 9, 2, 5, 2, 3, 5, 3, 1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 5, 9, 2, 5, 2, 3, 5, 3, 1, -1, -1, -1, -1},
+            {0, 2, 3, 0, 3, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 2, 4, 2, 3, 4, 3, 1, -1, -1, -1, -1, -1, -1, -1},
+            {3, 10, 4, 3, 4, 5, 3, 5, 9, 3, 9, 2, -1, -1, -1, -1},
+            {5, 9, 2, 5, 2, 3, 5, 3, 10, 5, 10, 8, 5, 8, 0, -1},
+            {0, 2, 3, 0, 3, 10, 0, 10, 4, -1, -1, -1, -1, -1, -1, -1},
+            {3, 10, 8, 3, 8, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {3, 11, 9, 3, 9, 8, 3, 8, 6, -1, -1, -1, -1, -1, -1, -1},
+            {4, 6, 3, 4, 3, 11, 4, 11, 9, 4, 9, 0, -1, -1, -1, -1},
+            {0, 8, 6, 0, 6, 3, 0, 3, 11, 0, 11, 5, -1, -1, -1, -1},
+            {3, 11, 5, 3, 5, 4, 3, 4, 6, -1, -1, -1, -1, -1, -1, -1},
+            {1, 10, 4, 3, 11, 9, 3, 9, 8, 3, 8, 6, -1, -1, -1, -1},
+            {1, 10, 6, 1, 6, 3, 1, 3, 11, 1, 11, 9, 1, 9, 0, -1},
+            {0, 8, 6, 0, 6, 3, 0, 3, 11, 0, 11, 5, 1, 10, 4, -1},
+            {1, 10, 6, 1, 6, 3, 1, 3, 11, 1, 11, 5, -1, -1, -1, -1},
+            {5, 9, 8, 5, 8, 6, 5, 6, 3, 5, 3, 1, -1, -1, -1, -1},
+            {4, 6, 3, 4, 3, 1, 4, 1, 5, 4, 5, 9, 4, 9, 0, -1},
+            {0, 8, 6, 0, 6, 3, 0, 3, 1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 6, 3, 4, 3, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {3, 10, 4, 3, 4, 5, 3, 5, 9, 3, 9, 8, 3, 8, 6, -1},
+            {5, 9, 0, 3, 10, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 8, 6, 0, 6, 3, 0, 3, 10, 0, 10, 4, -1, -1, -1, -1},
+            {3, 10, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {6, 10, 11, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 6, 10, 11, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 6, 10, 11, 6, 11, 7, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 9, 4, 9, 5, 6, 10, 11, 6, 11, 7, -1, -1, -1, -1},
+            {1, 11, 7, 1, 7, 6, 1, 6, 4, -1, -1, -1, -1, -1, -1, -1},
+            {1, 11, 7, 1, 7, 6, 1, 6, 8, 1, 8, 0, -1, -1, -1, -1},
+            {0, 9, 5, 1, 11, 7, 1, 7, 6, 1, 6, 4, -1, -1, -1, -1},
+            {1, 11, 7, 1, 7, 6, 1, 6, 8, 1, 8, 9, 1, 9, 5, -1},
+            {5, 7, 6, 5, 6, 10, 5, 10, 1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 5, 7, 6, 5, 6, 10, 5, 10, 1, -1, -1, -1, -1},
+            {0, 9, 7, 0, 7, 6, 0, 6, 10, 0, 10, 1, -1, -1, -1, -1},
+            {4, 8, 9, 4, 9, 7, 4, 7, 6, 4, 6, 10, 4, 10, 1, -1},
+            {5, 7, 6, 5, 6, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {5, 7, 6, 5, 6, 8, 5, 8, 0, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 7, 0, 7, 6, 0, 6, 4, -1, -1, -1, -1, -1, -1, -1},
+            {6, 8, 9, 6, 9, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {2, 8, 10, 2, 10, 11, 2, 11, 7, -1, -1, -1, -1, -1, -1, -1},
+            {4, 10, 11, 4, 11, 7, 4, 7, 2, 4, 2, 0, -1, -1, -1, -1},
+            {0, 9, 5, 2, 8, 10, 2, 10, 11, 2, 11, 7, -1, -1, -1, -1},
+            {2, 9, 5, 2, 5, 4, 2, 4, 10, 2, 10, 11, 2, 11, 7, -1},
+            {1, 11, 7, 1, 7, 2, 1, 2, 8, 1, 8, 4, -1, -1, -1, -1},
+            {1, 11, 7, 1, 7, 2, 1, 2, 0, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 5, 1, 11, 7, 1, 7, 2, 1, 2, 8, 1, 8, 4, -1},
+            {1, 11, 7, 1, 7, 2, 1, 2, 9, 1, 9, 5, -1, -1, -1, -1},
+            {5, 7, 2, 5, 2, 8, 5, 8, 10, 5, 10, 1, -1, -1, -1, -1},
+            {4, 10, 1, 4, 1, 5, 4, 5, 7, 4, 7, 2, 4, 2, 0, -1},
+            {0, 9, 7, 0, 7, 2, 0, 2, 8, 0, 8, 10, 0, 10, 1, -1},
+            {4, 10, 1, 2, 9, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {2, 8, 4, 2, 4, 5, 2, 5, 7, -1, -1, -1, -1, -1, -1, -1},
+            {5, 7, 2, 5, 2, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 9, 7, 0, 7, 2, 0, 2, 8, 0, 8, 4, -1, -1, -1, -1},
+            {2, 9, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {6, 10, 11, 6, 11, 9, 6, 9, 2, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 0, 6, 10, 11, 6, 11, 9, 6, 9, 2, -1, -1, -1, -1},
+            {0, 2, 6, 0, 6, 10, 0, 10, 11, 0, 11, 5, -1, -1, -1, -1},
+            {6, 10, 11, 6, 11, 5, 6, 5, 4, 6, 4, 8, 6, 8, 2, -1},
+            {1, 11, 9, 1, 9, 2, 1, 2, 6, 1, 6, 4, -1, -1, -1, -1},
+            {1, 11, 9, 1, 9, 2, 1, 2, 6, 1, 6, 8, 1, 8, 0, -1},
+            {0, 2, 6, 0, 6, 4, 0, 4, 1, 0, 1, 11, 0, 11, 5, -1},
+            {1, 11, 5, 6, 8, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {5, 9, 2, 5, 2, 6, 5, 6, 10, 5, 10, 1, -1, -1, -1, -1},
+            {4, 8, 0, 5, 9, 2, 5, 2, 6, 5, 6, 10, 5, 10, 1, -1},
+            {0, 2, 6, 0, 6, 10, 0, 10, 1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 8, 2, 4, 2, 6, 4, 6, 10, 4, 10, 1, -1, -1, -1, -1},
+            {6, 4, 5, 6, 5, 9, 6, 9, 2, -1, -1, -1, -1, -1, -1, -1},
+            {5, 9, 2, 5, 2, 6, 5, 6, 8, 5, 8, 0, -1, -1, -1, -1},
+            {0, 2, 6, 0, 6, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {6, 8, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {8, 10, 11, 8, 11, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 10, 11, 4, 11, 9, 4, 9, 0, -1, -1, -1, -1, -1, -1, -1},
+            {0, 8, 10, 0, 10, 11, 0, 11, 5, -1, -1, -1, -1, -1, -1, -1},
+            {4, 10, 11, 4, 11, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {1, 11, 9, 1, 9, 8, 1, 8, 4, -1, -1, -1, -1, -1, -1, -1},
+            {1, 11, 9, 1, 9, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 8, 4, 0, 4, 1, 0, 1, 11, 0, 11, 5, -1, -1, -1, -1},
+            {1, 11, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {5, 9, 8, 5, 8, 10, 5, 10, 1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 10, 1, 4, 1, 5, 4, 5, 9, 4, 9, 0, -1, -1, -1, -1},
+            {0, 8, 10, 0, 10, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {4, 10, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {5, 9, 8, 5, 8, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {5, 9, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {0, 8, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+            {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},
+        };
+
+        MarchingCubes::MarchingCubes()
+            : _lower(Vector::Constant(S(-1))),
+              _upper(Vector::Constant(S(1))),
+              _resolution(Vector::Constant(S(0.01))),
+              _iso(S(0)),
+              _blockSize(16),
+              _skipEmptyBlocks(true)
+        {}
+
+        void MarchingCubes::setLowerBounds(const Vector &lower)
+        {
+            _lower = lower;
+        }
+
+        void MarchingCubes::setUpperBounds(const Vector &upper)
+        {
+            _upper = upper;
+        }
+
+        void MarchingCubes::setResolution(const Vector &resolution)
+        {
+            _resolution = resolution;
+        }
+
+        void MarchingCubes::setIsoLevel(Scalar s)
+        {
+            _iso = s;
+        }
+
+        void MarchingCubes::setBlockSize(int voxels)
+        {
+            _blockSize = voxels;
+        }
+
+        void MarchingCubes::setSkipEmptyBlocks(bool enable)
+        {
+            _skipEmptyBlocks = enable;
+        }
+
+        /** Extract vertices on owned edges and triangles of owned voxels of a single block. */
+        static void marchBlock(const SDFNode &scene, const AffineTransform &toWorld, Scalar iso, const BlockGrid &grid, int b, BlockMesh &mesh)
+        {
+            const Index bl = grid.blockLower(b);
+            const Index bu = grid.blockUpper(b);
+            const Index ou = grid.ownedUpper(b);
+
+            BlockSamples samples;
+            samples.sample(scene, toWorld, bl, bu, iso);
+            mesh.reset(bl, bu, 3);
+
+            // Vertices are generated by linear interpolation on crossing edges whose minimum corner is owned.
+            for (int z = bl.z(); z <= ou.z(); ++z) {
+                for (int y = bl.y(); y <= ou.y(); ++y) {
+                    for (int x = bl.x(); x <= ou.x(); ++x) {
+                        const Index c(x, y, z);
+                        const Scalar s0 = samples(c);
+                        for (int a = 0; a < 3; ++a) {
+                            Index c1 = c;
+                            c1(a) += 1;
+                            if (c1(a) > bu(a))
+                                continue;
+
+                            const Scalar s1 = samples(c1);
+                            if ((s0 < 0) == (s1 < 0))
+                                continue;
+
+                            Vector p = c.cast<Scalar>();
+                            p(a) += s0 / (s0 - s1);
+                            mesh.addVertex(c, a, toWorld * p);
+                        }
+                    }
+                }
+            }
+
+            // Triangles of voxels in block.
+            for (int z = bl.z(); z < bu.z(); ++z) {
+                for (int y = bl.y(); y < bu.y(); ++y) {
+                    for (int x = bl.x(); x < bu.x(); ++x) {
+                        const Index v(x, y, z);
+
+                        int config = 0;
+                        for (int i = 0; i < 8; ++i) {
+                            if (samples(v + Index(i & 1, (i >> 1) & 1, (i >> 2) & 1)) < 0)
+                                config |= 1 << i;
+                        }
+
+                        const int *tri = mcTriangleTable[config];
+                        for (int i = 0; tri[i] != -1; i += 3) {
+                            BlockVertexRef r[3];
+                            for (int j = 0; j < 3; ++j) {
+                                const int *e = mcEdges[tri[i + j]];
+                                r[j] = BlockVertexRef(v + Index(e[0], e[1], e[2]), e[3]);
+                            }
+                            mesh.addTriangle(r[0], r[1], r[2]);
+                        }
+                    }
+                }
+            }
+        }
+
+        IndexedSurface
+        MarchingCubes::compute(SDFNodePtr scene)
+        {
+            namespace vg = util::voxelgrid;
+
+            const AffineTransform toGrid = vg::buildWorldToLocal(_lower, _resolution);
+            const AffineTransform toWorld = toGrid.inverse();
+
+            BlockGrid grid(vg::worldToVoxel(toGrid, _lower), vg::worldToVoxel(toGrid, _upper), _blockSize);
+            std::vector<BlockMesh> blocks(grid.size());
+
+            util::parallelFor(0, grid.size(), [&](int b) {
+                if (!_skipEmptyBlocks || !grid.isEmpty(b, *scene, toWorld, _iso))
+                    marchBlock(*scene, toWorld, _iso, grid, b, blocks[b]);
+            });
+
+            IndexedSurface surface;
+            assembleBlocks(grid, blocks, surface);
+            return surface;
+        }
+
+    }
+}
@@ -0,0 +1,206 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/surface/mesh_chunk.h>
+#include <volplay/surface/block_grid.h>
+#include <stdio.h>
+#include <algorithm>
+#include <map>
+
+namespace volplay {
+
+    namespace surface {
+
+        static const char chunkMagic[4] = {'V', 'P', 'C', 'K'};
+
+        int MeshChunk::find(const Index &voxel) const
+        {
+            std::vector<Index>::const_iterator i = std::lower_bound(voxels.begin(), voxels.end(), voxel, VoxelOrder());
+            return (i != voxels.end() && *i == voxel) ? int(i - voxels.begin()) : -1;
+        }
+
+        bool MeshChunk::write(const char *filename) const
+        {
+            FILE *f = fopen(filename, "wb");
+            if (f == 0)
+                return false;
+
+            const int counts[2] = {int(voxels.size()), int(quads.size() / 4)};
+
+            bool ok = fwrite(chunkMagic, 1, 4, f) == 4 && fwrite(counts, sizeof(int), 2, f) == 2;
+            for (size_t i = 0; ok && i < voxels.size(); ++i)
+                ok = fwrite(voxels[i].data(), sizeof(Index::Scalar), 3, f) == 3;
+            for (size_t i = 0; ok && i < vertices.size(); ++i)
+                ok = fwrite(vertices[i].data(), sizeof(Scalar), 3, f) == 3;
+            for (size_t i = 0; ok && i < quads.size(); ++i)
+                ok = fwrite(quads[i].data(), sizeof(Index::Scalar), 3, f) == 3;
+
+            fclose(f);
+            return ok;
+        }
+
+        bool MeshChunk::read(const char *filename, bool voxelsOnly)
+        {
+            FILE *f = fopen(filename, "rb");
+            if (f == 0)
+                return false;
+
+            char magic[4];
+            int counts[2];
+            bool ok = fread(magic, 1, 4, f) == 4 && std::equal(magic, magic + 4, chunkMagic) && fread(counts, sizeof(int), 2, f) == 2;
+
+            voxels.clear();
+            vertices.clear();
+            quads.clear();
+
+            if (ok) {
+                voxels.resize(counts[0]);
+                for (size_t i = 0; ok && i < voxels.size(); ++i)
+                    ok = fread(voxels[i].data(), sizeof(Index::Scalar), 3, f) == 3;
+            }
+
+            if (ok && !voxelsOnly) {
+                vertices.resize(counts[0]);
+                for (size_t i = 0; ok && i < vertices.size(); ++i)
+                    ok = fread(vertices[i].data(), sizeof(Scalar), 3, f) == 3;
+
+                quads.resize(counts[1] * 4);
+                for (size_t i = 0; ok && i < quads.size(); ++i)
+                    ok = fread(quads[i].data(), sizeof(Index::Scalar), 3, f) == 3;
+            }
+
+            fclose(f);
+            return ok;
+        }
+
+        bool ChunkManifest::write(const std::string &prefix) const
+        {
+            FILE *f = fopen((prefix + ".chunks").c_str(), "w");
+            if (f == 0)
+                return false;
+
+            fprintf(f, "VPCHUNKS 1\n");
+            fprintf(f, "%d %d %d %d %d %d\n", lower.x(), lower.y(), lower.z(), upper.x(), upper.y(), upper.z());
+            fprintf(f, "%d %d %d\n", blockSize, quads ? 4 : 3, int(vertexCounts.size()));
+            for (size_t i = 0; i < vertexCounts.size(); ++i)
+                fprintf(f, "%d %d\n", vertexCounts[i], quadCounts[i]);
+
+            fclose(f);
+            return true;
+        }
+
+        bool ChunkManifest::read(const std::string &prefix)
+        {
+            FILE *f = fopen((prefix + ".chunks").c_str(), "r");
+            if (f == 0)
+                return false;
+
+            int version, faceSize, n;
+            bool ok =
+                fscanf(f, "VPCHUNKS %d", &version) == 1 && version == 1 &&
+                fscanf(f, "%d %d %d %d %d %d", &lower.x(), &lower.y(), &lower.z(), &upper.x(), &upper.y(), &upper.z()) == 6 &&
+                fscanf(f, "%d %d %d", &blockSize, &faceSize, &n) == 3 && n >= 0;
+
+            if (ok) {
+                quads = (faceSize == 4);
+                vertexCounts.resize(n);
+                quadCounts.resize(n);
+                for (int i = 0; ok && i < n; ++i)
+                    ok = fscanf(f, "%d %d", &vertexCounts[i], &quadCounts[i]) == 2;
+            }
+
+            fclose(f);
+            return ok;
+        }
+
+        std::string ChunkManifest::chunkFilename(const std::string &prefix, int b)
+        {
+            char buf[32];
+            sprintf(buf, ".%d.chunk", b);
+            return prefix + buf;
+        }
+
+        bool mergeChunks(const std::string &prefix, const char *filename)
+        {
+            ChunkManifest m;
+            if (!m.read(prefix))
+                return false;
+
+            const BlockGrid grid(m.lower, m.upper, m.blockSize);
+            const int n = int(m.vertexCounts.size());
+            if (n != grid.size())
+                return false;
+
+            std::vector<int> vertexOffsets(n + 1, 0);
+            int faceCount = 0;
+            for (int b = 0; b < n; ++b) {
+                vertexOffsets[b + 1] = vertexOffsets[b] + m.vertexCounts[b];
+                faceCount += m.quadCounts[b] * (m.quads ? 1 : 2);
+            }
+
+            FILE *f = fopen(filename, "w");
+            if (f == 0)
+                return false;
+
+            fprintf(f, "OFF %d %d %d\n", vertexOffsets[n], faceCount, 0);
+
+            // Vertices
+            MeshChunk chunk;
+            bool ok = true;
+            for (int b = 0; ok && b < n; ++b) {
+                ok = chunk.read(ChunkManifest::chunkFilename(prefix, b).c_str());
+                for (size_t i = 0; ok && i < chunk.vertices.size(); ++i) {
+                    const Vector &v = chunk.vertices[i];
+                    fprintf(f, "%f %f %f\n", v.x(), v.y(), v.z());
+                }
+            }
+
+            // Faces. References are resolved through the voxel lists of the owning chunks. Owners
+            // of referenced voxels are the chunk itself or its neighbors, so only those are kept.
+            std::map<int, MeshChunk> owners;
+            for (int b = 0; ok && b < n; ++b) {
+                ok = chunk.read(ChunkManifest::chunkFilename(prefix, b).c_str());
+
+                std::map<int, MeshChunk> needed;
+                std::vector<int> ids(chunk.quads.size());
+                for (size_t i = 0; ok && i < chunk.quads.size(); ++i) {
+                    const Index c = chunk.quads[i].cwiseMax(m.lower).cwiseMin(m.upper);
+                    const int o = grid.owner(c);
+
+                    if (needed.find(o) == needed.end()) {
+                        std::map<int, MeshChunk>::iterator cached = owners.find(o);
+                        if (cached != owners.end()) {
+                            needed[o].voxels.swap(cached->second.voxels);
+                        } else {
+                            ok = needed[o].read(ChunkManifest::chunkFilename(prefix, o).c_str(), true);
+                        }
+                    }
+
+                    const int local = ok ? needed[o].find(chunk.quads[i]) : -1;
+                    ok = local >= 0;
+                    ids[i] = ok ? vertexOffsets[o] + local : 0;
+                }
+                owners.swap(needed);
+
+                for (size_t i = 0; ok && i < ids.size(); i += 4) {
+                    if (m.quads) {
+                        fprintf(f, "4 %d %d %d %d\n", ids[i], ids[i + 1], ids[i + 2], ids[i + 3]);
+                    } else {
+                        fprintf(f, "3 %d %d %d\n", ids[i], ids[i + 1], ids[i + 2]);
+                        fprintf(f, "3 %d %d %d\n", ids[i], ids[i + 2], ids[i + 3]);
+                    }
+                }
+            }
+
+            fclose(f);
+            return ok;
+        }
+
+    }
+}
@@ -39,11 +39,11 @@ namespace volplay {
             // Faces. Either quads or triangles are supported.
             if (s.faces.rows() == 4) {
                 for (IndexedSurface::FaceMatrix::Index i = 0; i < s.faces.cols(); ++i) {
-                    fprintf(f, "4 %ld %ld %ld %ld\n", s.faces(0, i), s.faces(1, i), s.faces(2, i), s.faces(3, i));
+                    fprintf(f, "4 %d %d %d %d\n", s.faces(0, i), s.faces(1, i), s.faces(2, i), s.faces(3, i));
                 }
             } else if (s.faces.rows() == 3) {
                 for (IndexedSurface::FaceMatrix::Index i = 0; i < s.faces.cols(); ++i) {
-                    fprintf(f, "3 %ld %ld %ld\n", s.faces(0, i), s.faces(1, i), s.faces(2, i));
+                    fprintf(f, "3 %d %d %d\n", s.faces(0, i), s.faces(1, i), s.faces(2, i));
                 }
             }
 
@@ -0,0 +1,72 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/surface/off_import.h>
+#include <volplay/surface/indexed_surface.h>
+#include <stdio.h>
+#include <vector>
+
+namespace volplay {
+    
+    namespace surface {
+
+        OFFImport::OFFImport()
+        {}
+
+        bool OFFImport::importSurface(const char *filename, IndexedSurface &s) const
+        {
+            FILE *f = fopen(filename, "r");
+            if (f == 0)
+                return false;
+
+            // Header
+            int nv, nf, ne;
+            bool ok = fscanf(f, " OFF %d %d %d", &nv, &nf, &ne) == 3 && nv >= 0 && nf >= 0;
+
+            // Vertices
+            IndexedSurface::VertexMatrix vertices(3, ok ? nv : 0);
+            for (int i = 0; ok && i < nv; ++i)
+                ok = fscanf(f, "%f %f %f", &vertices(0, i), &vertices(1, i), &vertices(2, i)) == 3;
+
+            // Faces. Remainders of a line, such as colors, are skipped.
+            std::vector<Index::Scalar> triangles;
+            std::vector<Index::Scalar> polygon;
+            for (int i = 0; ok && i < nf; ++i) {
+                int n;
+                ok = fscanf(f, "%d", &n) == 1 && n >= 3;
+
+                polygon.resize(ok ? n : 0);
+                for (int j = 0; ok && j < n; ++j)
+                    ok = fscanf(f, "%d", &polygon[j]) == 1 && polygon[j] >= 0 && polygon[j] < nv;
+
+                for (int j = 1; ok && j + 1 < n; ++j) {
+                    triangles.push_back(polygon[0]);
+                    triangles.push_back(polygon[j]);
+                    triangles.push_back(polygon[j + 1]);
+                }
+
+                int c;
+                while (ok && (c = fgetc(f)) != EOF && c != '\n')
+                    ;
+            }
+
+            fclose(f);
+
+            if (ok) {
+                s.vertices.swap(vertices);
+                s.faces.resize(3, triangles.size() / 3);
+                if (!triangles.empty())
+                    s.faces = Eigen::Map<IndexedSurface::TriangleMatrix>(&triangles[0], 3, triangles.size() / 3);
+            }
+
+            return ok;
+        }
+
+    }
+}
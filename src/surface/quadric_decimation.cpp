@@ -0,0 +1,314 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/surface/quadric_decimation.h>
+#include <volplay/surface/indexed_surface.h>
+#include <volplay/math/qef.h>
+#include <volplay/util/parallel.h>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+namespace volplay {
+
+    namespace surface {
+
+        QuadricDecimation::QuadricDecimation()
+            : _targetFaces(0), _maxError(std::numeric_limits<Scalar>::infinity()), _svdThreshold(Scalar(0.1))
+        {}
+
+        void QuadricDecimation::setTargetFaceCount(size_t count)
+        {
+            _targetFaces = count;
+        }
+
+        void QuadricDecimation::setMaxError(Scalar err)
+        {
+            _maxError = err;
+        }
+
+        void QuadricDecimation::setSingularValueThreshold(Scalar threshold)
+        {
+            _svdThreshold = threshold;
+        }
+
+        /** Working state of the decimation. */
+        struct DecimationMesh {
+            std::vector<Vector> positions;
+            std::vector<math::QEF> quadrics;
+            std::vector<char> fixed;
+            std::vector< std::vector<int> > vertexFaces;
+
+            std::vector<Index> faces;
+            std::vector<char> faceAlive;
+            size_t aliveFaces;
+
+            /** Normal of face scaled by twice its area. Vertex v is optionally moved to x. */
+            Vector faceNormal(int f, int v = -1, const Vector &x = Vector::Zero()) const
+            {
+                const Index &t = faces[f];
+                const Vector p0 = t(0) == v ? x : positions[t(0)];
+                const Vector p1 = t(1) == v ? x : positions[t(1)];
+                const Vector p2 = t(2) == v ? x : positions[t(2)];
+                return (p1 - p0).cross(p2 - p0);
+            }
+
+            /** Test if face references vertex. */
+            bool hasVertex(int f, int v) const
+            {
+                const Index &t = faces[f];
+                return t(0) == v || t(1) == v || t(2) == v;
+            }
+
+            /** Collect vertices adjacent to v. */
+            void neighbors(int v, std::vector<int> &n) const
+            {
+                n.clear();
+                for (size_t i = 0; i < vertexFaces[v].size(); ++i) {
+                    const Index &t = faces[vertexFaces[v][i]];
+                    for (int j = 0; j < 3; ++j) {
+                        if (t(j) != v)
+                            n.push_back(t(j));
+                    }
+                }
+                std::sort(n.begin(), n.end());
+                n.erase(std::unique(n.begin(), n.end()), n.end());
+            }
+
+            /** Remove face from list of faces incident to v. */
+            void detach(int v, int f)
+            {
+                std::vector<int> &vf = vertexFaces[v];
+                vf.erase(std::remove(vf.begin(), vf.end(), f), vf.end());
+            }
+        };
+
+        /** Candidate edge collapse. */
+        struct CollapseCandidate {
+            int a, b;
+            Vector x;
+            Scalar cost;
+        };
+
+        /** Test if collapsing b into a placed at x keeps the mesh manifold and does not flip faces. */
+        static bool canCollapse(const DecimationMesh &m, int a, int b, const Vector &x)
+        {
+            // Link condition: vertices adjacent to both a and b must be exactly those opposite to the collapsed edge.
+            std::vector<int> na, nb, common;
+            m.neighbors(a, na);
+            m.neighbors(b, nb);
+            std::set_intersection(na.begin(), na.end(), nb.begin(), nb.end(), std::back_inserter(common));
+
+            int shared = 0;
+            for (size_t i = 0; i < m.vertexFaces[a].size(); ++i) {
+                if (m.hasVertex(m.vertexFaces[a][i], b))
+                    ++shared;
+            }
+
+            if (shared != 2 || common.size() != 2)
+                return false;
+
+            // Normal flips
+            const int ends[2] = {a, b};
+            for (int e = 0; e < 2; ++e) {
+                const std::vector<int> &vf = m.vertexFaces[ends[e]];
+                for (size_t i = 0; i < vf.size(); ++i) {
+                    if (m.hasVertex(vf[i], a) && m.hasVertex(vf[i], b))
+                        continue;
+
+                    const Vector before = m.faceNormal(vf[i]);
+                    const Vector after = m.faceNormal(vf[i], ends[e], x);
+                    if (before.squaredNorm() > Scalar(0) && before.dot(after) <= Scalar(0))
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        /** Collapse b into a, placing a at x. */
+        static void collapse(DecimationMesh &m, int a, int b, const Vector &x)
+        {
+            m.positions[a] = x;
+            m.quadrics[a].merge(m.quadrics[b]);
+
+            const std::vector<int> bf = m.vertexFaces[b];
+            for (size_t i = 0; i < bf.size(); ++i) {
+                const int f = bf[i];
+                Index &t = m.faces[f];
+
+                if (m.hasVertex(f, a)) {
+                    m.faceAlive[f] = 0;
+                    m.aliveFaces -= 1;
+                    for (int j = 0; j < 3; ++j) {
+                        if (t(j) != b)
+                            m.detach(t(j), f);
+                    }
+                } else {
+                    for (int j = 0; j < 3; ++j) {
+                        if (t(j) == b)
+                            t(j) = a;
+                    }
+                    m.vertexFaces[a].push_back(f);
+                }
+            }
+            m.vertexFaces[b].clear();
+        }
+
+        IndexedSurface
+        QuadricDecimation::compute(const IndexedSurface &surface) const
+        {
+            const IndexedSurface::TriangleMatrix tris = surface.triangles();
+            const int nv = int(surface.vertices.cols());
+            const int nf = int(tris.cols());
+
+            DecimationMesh m;
+            m.positions.resize(nv);
+            m.quadrics.resize(nv);
+            m.fixed.assign(nv, 0);
+            m.vertexFaces.resize(nv);
+            m.faces.resize(nf);
+            m.faceAlive.assign(nf, 1);
+            m.aliveFaces = nf;
+
+            for (int v = 0; v < nv; ++v)
+                m.positions[v] = surface.vertices.col(v);
+
+            // Initial quadrics from planes of incident faces.
+            std::vector< std::pair<int, int> > edges;
+            for (int f = 0; f < nf; ++f) {
+                m.faces[f] = tris.col(f);
+
+                const Vector n = m.faceNormal(f);
+                const Scalar len = n.norm();
+                for (int j = 0; j < 3; ++j) {
+                    const int v = m.faces[f](j);
+                    m.vertexFaces[v].push_back(f);
+                    if (len > Scalar(0))
+                        m.quadrics[v].add(m.positions[v], n / len);
+
+                    const int w = m.faces[f]((j + 1) % 3);
+                    edges.push_back(std::make_pair(std::min(v, w), std::max(v, w)));
+                }
+            }
+
+            // Vertices of boundary and non-manifold edges are fixed.
+            std::sort(edges.begin(), edges.end());
+            for (size_t i = 0; i < edges.size();) {
+                size_t j = i;
+                while (j < edges.size() && edges[j] == edges[i])
+                    ++j;
+                if (j - i != 2) {
+                    m.fixed[edges[i].first] = 1;
+                    m.fixed[edges[i].second] = 1;
+                }
+                i = j;
+            }
+
+            std::vector<CollapseCandidate> candidates;
+            std::vector<int> order, ring;
+            std::vector<char> locked;
+
+            while (_targetFaces == 0 || m.aliveFaces > _targetFaces) {
+
+                // Gather candidate edges
+                edges.clear();
+                for (int f = 0; f < nf; ++f) {
+                    if (!m.faceAlive[f])
+                        continue;
+                    for (int j = 0; j < 3; ++j) {
+                        const int v = m.faces[f](j);
+                        const int w = m.faces[f]((j + 1) % 3);
+                        if (!m.fixed[v] && !m.fixed[w])
+                            edges.push_back(std::make_pair(std::min(v, w), std::max(v, w)));
+                    }
+                }
+                std::sort(edges.begin(), edges.end());
+                edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+                // Evaluate collapse costs in parallel
+                candidates.resize(edges.size());
+                util::parallelFor(0, int(edges.size()), [&](int i) {
+                    CollapseCandidate &c = candidates[i];
+                    c.a = edges[i].first;
+                    c.b = edges[i].second;
+
+                    math::QEF q = m.quadrics[c.a];
+                    q.merge(m.quadrics[c.b]);
+
+                    Scalar err;
+                    c.x = q.solve(_svdThreshold, &err);
+                    c.cost = std::max<Scalar>(err, 0);
+                });
+
+                order.resize(candidates.size());
+                for (size_t i = 0; i < order.size(); ++i)
+                    order[i] = int(i);
+                std::stable_sort(order.begin(), order.end(), [&candidates](int i, int j) {
+                    return candidates[i].cost < candidates[j].cost;
+                });
+
+                // Collapse cheapest edges whose neighborhoods do not overlap.
+                locked.assign(nv, 0);
+                size_t collapsed = 0;
+                for (size_t i = 0; i < order.size(); ++i) {
+                    const CollapseCandidate &c = candidates[order[i]];
+                    if (c.cost > _maxError)
+                        break;
+                    if (_targetFaces > 0 && m.aliveFaces <= _targetFaces)
+                        break;
+                    if (locked[c.a] || locked[c.b])
+                        continue;
+                    if (!canCollapse(m, c.a, c.b, c.x))
+                        continue;
+
+                    collapse(m, c.a, c.b, c.x);
+                    ++collapsed;
+
+                    locked[c.a] = 1;
+                    m.neighbors(c.a, ring);
+                    for (size_t j = 0; j < ring.size(); ++j)
+                        locked[ring[j]] = 1;
+                }
+
+                if (collapsed == 0)
+                    break;
+            }
+
+            // Compact vertices and faces
+            std::vector<int> remap(nv, -1);
+            int count = 0;
+            for (int v = 0; v < nv; ++v) {
+                if (!m.vertexFaces[v].empty())
+                    remap[v] = count++;
+            }
+
+            IndexedSurface result;
+            result.vertices.resize(3, count);
+            for (int v = 0; v < nv; ++v) {
+                if (remap[v] >= 0)
+                    result.vertices.col(remap[v]) = m.positions[v];
+            }
+
+            result.faces.resize(3, m.aliveFaces);
+            count = 0;
+            for (int f = 0; f < nf; ++f) {
+                if (!m.faceAlive[f])
+                    continue;
+                for (int j = 0; j < 3; ++j)
+                    result.faces(j, count) = remap[m.faces[f](j)];
+                ++count;
+            }
+
+            return result;
+        }
+
+    }
+}
@@ -0,0 +1,177 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/surface/surface_nets.h>
+#include <volplay/surface/indexed_surface.h>
+#include <volplay/surface/block_grid.h>
+#include <volplay/sdf_node.h>
+#include <volplay/util/voxel_grid.h>
+#include <volplay/util/parallel.h>
+
+namespace volplay {
+
+    namespace surface {
+
+        /** Edges of a cube given by the offset of their minimum corner and their axis. */
+        static const int snEdges[12][4] = {
+            {0, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 1, 1, 0},
+            {0, 0, 0, 1}, {1, 0, 0, 1}, {0, 0, 1, 1}, {1, 0, 1, 1},
+            {0, 0, 0, 2}, {1, 0, 0, 2}, {0, 1, 0, 2}, {1, 1, 0, 2}
+        };
+
+        SurfaceNets::SurfaceNets()
+            : _lower(Vector::Constant(S(-1))),
+              _upper(Vector::Constant(S(1))),
+              _resolution(Vector::Constant(S(0.01))),
+              _iso(S(0)),
+              _blockSize(16),
+              _skipEmptyBlocks(true)
+        {}
+
+        void SurfaceNets::setLowerBounds(const Vector &lower)
+        {
+            _lower = lower;
+        }
+
+        void SurfaceNets::setUpperBounds(const Vector &upper)
+        {
+            _upper = upper;
+        }
+
+        void SurfaceNets::setResolution(const Vector &resolution)
+        {
+            _resolution = resolution;
+        }
+
+        void SurfaceNets::setIsoLevel(Scalar s)
+        {
+            _iso = s;
+        }
+
+        void SurfaceNets::setBlockSize(int voxels)
+        {
+            _blockSize = voxels;
+        }
+
+        void SurfaceNets::setSkipEmptyBlocks(bool enable)
+        {
+            _skipEmptyBlocks = enable;
+        }
+
+        /** Extract vertices of voxels and quads of owned edges of a single block. */
+        static void netBlock(const SDFNode &scene, const AffineTransform &toWorld, Scalar iso, const BlockGrid &grid, int b, BlockMesh &mesh)
+        {
+            namespace vg = util::voxelgrid;
+
+            const Index bl = grid.blockLower(b);
+            const Index bu = grid.blockUpper(b);
+            const Index ou = grid.ownedUpper(b);
+            const Index &lower = grid.lower();
+            const Index &upper = grid.upper();
+
+            BlockSamples samples;
+            samples.sample(scene, toWorld, bl, bu, iso);
+            mesh.reset(bl, bu, 1);
+
+            // One vertex per voxel crossed by the surface, placed at the mean of its edge crossings.
+            for (int z = bl.z(); z < bu.z(); ++z) {
+                for (int y = bl.y(); y < bu.y(); ++y) {
+                    for (int x = bl.x(); x < bu.x(); ++x) {
+                        const Index v(x, y, z);
+
+                        int inside = 0;
+                        for (int i = 0; i < 8; ++i) {
+                            if (samples(v + Index(i & 1, (i >> 1) & 1, (i >> 2) & 1)) < 0)
+                                ++inside;
+                        }
+
+                        if (inside == 0 || inside == 8)
+                            continue;
+
+                        Vector sum = Vector::Zero();
+                        int count = 0;
+                        for (int i = 0; i < 12; ++i) {
+                            const Index c = v + Index(snEdges[i][0], snEdges[i][1], snEdges[i][2]);
+                            const int a = snEdges[i][3];
+                            Index c1 = c;
+                            c1(a) += 1;
+
+                            const Scalar s0 = samples(c);
+                            const Scalar s1 = samples(c1);
+                            if ((s0 < 0) == (s1 < 0))
+                                continue;
+
+                            Vector p = c.cast<Scalar>();
+                            p(a) += s0 / (s0 - s1);
+                            sum += p;
+                            ++count;
+                        }
+
+                        mesh.addVertex(v, 0, toWorld * Vector(sum / Scalar(count)));
+                    }
+                }
+            }
+
+            // One quad per owned crossing edge that is surrounded by four voxels of the grid.
+            for (int z = bl.z(); z <= ou.z(); ++z) {
+                for (int y = bl.y(); y <= ou.y(); ++y) {
+                    for (int x = bl.x(); x <= ou.x(); ++x) {
+                        const Index c(x, y, z);
+                        const Scalar s0 = samples(c);
+                        for (int a = 0; a < 3; ++a) {
+                            const int a1 = (a + 1) % 3;
+                            const int a2 = (a + 2) % 3;
+                            if (c(a) >= upper(a) || 
+                                c(a1) <= lower(a1) || c(a1) >= upper(a1) || 
+                                c(a2) <= lower(a2) || c(a2) >= upper(a2))
+                                continue;
+
+                            Index c1 = c;
+                            c1(a) += 1;
+
+                            const Scalar s1 = samples(c1);
+                            if ((s0 < 0) == (s1 < 0))
+                                continue;
+
+                            // Orient quad such that it faces outside.
+                            vg::VoxelEdge e(c, c1);
+                            vg::Voxel q[4];
+                            vg::voxels(s0 < 0 ? e : vg::flipEdge(e), q);
+
+                            mesh.addTriangle(BlockVertexRef(q[0], 0), BlockVertexRef(q[1], 0), BlockVertexRef(q[2], 0));
+                            mesh.addTriangle(BlockVertexRef(q[0], 0), BlockVertexRef(q[2], 0), BlockVertexRef(q[3], 0));
+                        }
+                    }
+                }
+            }
+        }
+
+        IndexedSurface
+        SurfaceNets::compute(SDFNodePtr scene)
+        {
+            namespace vg = util::voxelgrid;
+
+            const AffineTransform toGrid = vg::buildWorldToLocal(_lower, _resolution);
+            const AffineTransform toWorld = toGrid.inverse();
+
+            BlockGrid grid(vg::worldToVoxel(toGrid, _lower), vg::worldToVoxel(toGrid, _upper), _blockSize);
+            std::vector<BlockMesh> blocks(grid.size());
+
+            util::parallelFor(0, grid.size(), [&](int b) {
+                if (!_skipEmptyBlocks || !grid.isEmpty(b, *scene, toWorld, _iso))
+                    netBlock(*scene, toWorld, _iso, grid, b, blocks[b]);
+            });
+
+            IndexedSurface surface;
+            assembleBlocks(grid, blocks, surface);
+            return surface;
+        }
+
+    }
+}
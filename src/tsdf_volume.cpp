@@ -0,0 +1,283 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/tsdf_volume.h>
+#include <volplay/sdf_node_visitor.h>
+#include <volplay/rendering/camera.h>
+#include <volplay/rendering/image.h>
+#include <volplay/util/parallel.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace volplay {
+
+    namespace vg = util::voxelgrid;
+
+    /** Block containing voxel. */
+    inline Index blockOf(const Index &v, int blockSize)
+    {
+        return Index(
+            v.x() >= 0 ? v.x() / blockSize : -((-v.x() + blockSize - 1) / blockSize),
+            v.y() >= 0 ? v.y() / blockSize : -((-v.y() + blockSize - 1) / blockSize),
+            v.z() >= 0 ? v.z() / blockSize : -((-v.z() + blockSize - 1) / blockSize));
+    }
+
+    TSDFVolume::TSDFVolume(Scalar voxelSize, Scalar truncation)
+        : _voxelSize(voxelSize), _truncation(truncation), _maxWeight(Scalar(64)), _blockIndex(-1)
+    {}
+
+    void TSDFVolume::setMaxWeight(Scalar w)
+    {
+        _maxWeight = w;
+    }
+
+    Scalar TSDFVolume::voxelSize() const
+    {
+        return _voxelSize;
+    }
+
+    Scalar TSDFVolume::truncation() const
+    {
+        return _truncation;
+    }
+
+    int TSDFVolume::blockCount() const
+    {
+        return int(_blocks.size());
+    }
+
+    bool TSDFVolume::bounds(Vector &lower, Vector &upper) const
+    {
+        if (_blocks.empty())
+            return false;
+
+        Index l = _blocks[0].coords;
+        Index u = _blocks[0].coords;
+        for (size_t i = 1; i < _blocks.size(); ++i) {
+            l = l.cwiseMin(_blocks[i].coords);
+            u = u.cwiseMax(_blocks[i].coords);
+        }
+
+        lower = (l * int(BlockSize)).cast<Scalar>() * _voxelSize;
+        upper = ((u + Index::Ones()) * int(BlockSize) - Index::Ones()).cast<Scalar>() * _voxelSize;
+        return true;
+    }
+
+    const TSDFVolume::Block *TSDFVolume::findBlock(const Index &blockCoords) const
+    {
+        const int *i = _blockIndex.find(blockCoords);
+        return (i && *i >= 0) ? &_blocks[*i] : 0;
+    }
+
+    void TSDFVolume::integrate(const rendering::ScalarImage &depth, const rendering::Camera &cam, Scalar invalidDepth)
+    {
+        const int rows = depth.rows();
+        const int cols = depth.cols();
+        const rendering::Camera::Matrix33 k = cam.cameraToImage();
+        const rendering::Camera::Matrix33 kinv = cam.imageToCamera();
+        const AffineTransform cameraToWorld = cam.cameraToWorldTransform();
+        const AffineTransform worldToCamera = cam.worldToCameraTransform();
+
+        // Blocks along the truncation band of each pixel. Samples are spaced by half a block.
+        const Scalar step = Scalar(BlockSize) * _voxelSize * Scalar(0.5);
+        std::vector< std::vector<vg::VoxelKey> > rowBlocks(rows);
+
+        util::parallelFor(0, rows, [&](int r) {
+            const Scalar *d = depth.row(r);
+            std::vector<vg::VoxelKey> &keys = rowBlocks[r];
+
+            for (int c = 0; c < cols; ++c) {
+                if (d[c] == invalidDepth || !(d[c] > Scalar(0)))
+                    continue;
+
+                // Points on the pixel ray parameterized by their depth.
+                const Vector ray = kinv * Vector(Scalar(c), Scalar(r), Scalar(1));
+                const Scalar near = std::max<Scalar>(d[c] - _truncation, Scalar(0));
+                const Scalar far = d[c] + _truncation;
+                const Scalar dz = step / ray.norm();
+
+                for (Scalar z = near; ; z += dz) {
+                    const Vector x = cameraToWorld * (ray * std::min(z, far));
+                    const Index v = (x / _voxelSize).array().round().cast<Index::Scalar>();
+                    const vg::VoxelKey key = vg::packVoxel(blockOf(v, BlockSize));
+                    if (keys.empty() || keys.back() != key)
+                        keys.push_back(key);
+                    if (z >= far)
+                        break;
+                }
+            }
+
+            std::sort(keys.begin(), keys.end());
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        });
+
+        // Allocate missing blocks.
+        for (int r = 0; r < rows; ++r) {
+            for (size_t i = 0; i < rowBlocks[r].size(); ++i) {
+                int &b = _blockIndex.at(rowBlocks[r][i]);
+                if (b < 0) {
+                    b = int(_blocks.size());
+                    _blocks.emplace_back(vg::unpackVoxel(rowBlocks[r][i]));
+                }
+            }
+        }
+
+        // Blocks in view. Voxels observed may lie in blocks allocated by other frames, so all
+        // blocks whose bounding sphere projects into the image are updated.
+        const Scalar radius = Scalar(BlockSize) * _voxelSize * Scalar(0.5) * std::sqrt(Scalar(3));
+        const Scalar focal = std::max(k(0, 0), k(1, 1));
+        std::vector<int> touched;
+        for (int b = 0; b < int(_blocks.size()); ++b) {
+            const Vector center = ((_blocks[b].coords * int(BlockSize)).cast<Scalar>() + Vector::Constant(Scalar(BlockSize - 1) * Scalar(0.5))) * _voxelSize;
+            const Vector pc = worldToCamera * center;
+            if (pc.z() + radius <= Scalar(0))
+                continue;
+
+            const Vector pi = k * pc;
+            const Scalar margin = pc.z() > radius ? focal * radius / (pc.z() - radius) : std::numeric_limits<Scalar>::max();
+            const Vector2 uv = pc.z() > Scalar(0) ? Vector2(pi.x() / pi.z(), pi.y() / pi.z()) : Vector2::Zero();
+            if (margin < std::numeric_limits<Scalar>::max() &&
+                (uv.x() < -margin || uv.x() > cols - 1 + margin || uv.y() < -margin || uv.y() > rows - 1 + margin))
+                continue;
+
+            touched.push_back(b);
+        }
+
+        // Fuse projective distances into voxels of touched blocks.
+        util::parallelFor(0, int(touched.size()), [&](int i) {
+            Block &block = _blocks[touched[i]];
+            const Index first = block.coords * int(BlockSize);
+
+            int n = 0;
+            for (int z = 0; z < BlockSize; ++z) {
+                for (int y = 0; y < BlockSize; ++y) {
+                    for (int x = 0; x < BlockSize; ++x, ++n) {
+                        const Vector p = (first + Index(x, y, z)).cast<Scalar>() * _voxelSize;
+                        const Vector pc = worldToCamera * p;
+                        if (pc.z() <= Scalar(0))
+                            continue;
+
+                        const Vector pi = k * pc;
+                        const int c = int(std::floor(pi.x() / pi.z() + Scalar(0.5)));
+                        const int r = int(std::floor(pi.y() / pi.z() + Scalar(0.5)));
+                        if (c < 0 || c >= cols || r < 0 || r >= rows)
+                            continue;
+
+                        const Scalar d = depth.row(r)[c];
+                        if (d == invalidDepth || !(d > Scalar(0)))
+                            continue;
+
+                        const Scalar sdf = d - pc.z();
+                        if (sdf < -_truncation)
+                            continue;
+
+                        const float tsdf = float(std::min<Scalar>(Scalar(1), sdf / _truncation));
+                        const float w = block.weight[n];
+                        block.tsdf[n] = (block.tsdf[n] * w + tsdf) / (w + 1.f);
+                        block.weight[n] = std::min<float>(w + 1.f, float(_maxWeight));
+                    }
+                }
+            }
+        });
+    }
+
+    SDFResult
+    TSDFVolume::fullEval(const Vector &x) const
+    {
+        SDFResult r = {this, _truncation};
+
+        const Vector p = x / _voxelSize;
+        const Vector fp = p.array().floor();
+        const Index i = fp.cast<Index::Scalar>();
+        const Vector t = p - fp;
+
+        // Trilinear interpolation over observed corners only. Voxels behind surfaces seen at
+        // grazing angles often remain unobserved, as their projective distance exceeds the
+        // truncation. Corners may span up to eight blocks.
+        Scalar sum = 0;
+        Scalar weights = 0;
+        for (int j = 0; j < 8; ++j) {
+            const Index v = i + Index(j & 1, (j >> 1) & 1, (j >> 2) & 1);
+            const Block *b = findBlock(blockOf(v, BlockSize));
+            if (!b)
+                continue;
+
+            const Index l = v - b->coords * int(BlockSize);
+            const int n = (l.z() * BlockSize + l.y()) * BlockSize + l.x();
+            if (b->weight[n] <= 0.f)
+                continue;
+
+            const Scalar w =
+                ((j & 1) ? t.x() : Scalar(1) - t.x()) *
+                (((j >> 1) & 1) ? t.y() : Scalar(1) - t.y()) *
+                (((j >> 2) & 1) ? t.z() : Scalar(1) - t.z());
+            sum += w * b->tsdf[n];
+            weights += w;
+        }
+
+        if (weights > Scalar(1e-4))
+            r.sdf = sum / weights * _truncation;
+        return r;
+    }
+
+    Scalar
+    TSDFVolume::trace(const Vector &o, const Vector &d, const TraceOptions &opts, TraceResult *tr) const
+    {
+        Scalar t = opts.minT;
+        SDFResult r = fullEval(o + t * d);
+
+        Scalar prevT = t;
+        Scalar prevSdf = r.sdf;
+        bool hit = std::abs(r.sdf) < opts.sdfThreshold;
+
+        int nIter = 0;
+        while (!hit && nIter < opts.maxIter && t < opts.maxT) {
+            if (r.sdf < Scalar(0)) {
+                // Zero crossing between the previous and the current position.
+                if (prevSdf > Scalar(0)) {
+                    t = prevT + (t - prevT) * prevSdf / (prevSdf - r.sdf);
+                    r = fullEval(o + t * d);
+                    hit = true;
+                }
+                break;
+            }
+
+            prevT = t;
+            prevSdf = r.sdf;
+            t += std::max(r.sdf * opts.stepFact, opts.sdfThreshold);
+            r = fullEval(o + t * d);
+            hit = std::abs(r.sdf) < opts.sdfThreshold;
+            ++nIter;
+        }
+
+        if (tr) {
+            tr->t = t;
+            tr->sdf = r.sdf;
+            tr->node = r.node;
+            tr->element = r.element;
+            tr->iter = nIter;
+            tr->hit = hit;
+        }
+
+        return t;
+    }
+
+    math::Interval
+    TSDFVolume::evalInterval(const AlignedBox &) const
+    {
+        return math::Interval(-_truncation, _truncation);
+    }
+
+	void TSDFVolume::accept(SDFNodeVisitor &nv)
+	{
+		nv.visit(this);
+	}
+
+}
@@ -0,0 +1,63 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/util/bounding_volume_hierarchy.h>
+#include <algorithm>
+
+namespace volplay {
+    namespace util {
+
+        void BoundingVolumeHierarchy::build(const std::vector<AlignedBox> &bounds, std::vector<int> &primitives, int leafSize)
+        {
+            const int n = int(primitives.size());
+            _nodes.clear();
+            _nodes.reserve(2 * n);
+            if (n > 0)
+                build(0, n, bounds, primitives, std::max<int>(1, leafSize));
+        }
+
+        const std::vector<BoundingVolumeHierarchy::Node> &BoundingVolumeHierarchy::nodes() const
+        {
+            return _nodes;
+        }
+
+        int BoundingVolumeHierarchy::build(int begin, int end, const std::vector<AlignedBox> &bounds, std::vector<int> &primitives, int leafSize)
+        {
+            AlignedBox box;
+            AlignedBox centers;
+            for (int i = begin; i < end; ++i) {
+                box.extend(bounds[primitives[i]]);
+                centers.extend(bounds[primitives[i]].center());
+            }
+
+            const int id = int(_nodes.size());
+            _nodes.push_back(Node(box));
+
+            if (end - begin <= leafSize) {
+                _nodes[id].first = begin;
+                _nodes[id].count = end - begin;
+                return id;
+            }
+
+            // Median split along the longest axis of center bounds.
+            int axis;
+            centers.sizes().maxCoeff(&axis);
+            const int mid = begin + (end - begin) / 2;
+            std::nth_element(primitives.begin() + begin, primitives.begin() + mid, primitives.begin() + end, [&bounds, axis](int a, int b) {
+                return bounds[a].center()(axis) < bounds[b].center()(axis);
+            });
+
+            build(begin, mid, bounds, primitives, leafSize);
+            const int right = build(mid, end, bounds, primitives, leafSize);
+            _nodes[id].first = right;
+            return id;
+        }
+
+    }
+}
@@ -0,0 +1,116 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include <volplay/util/mapped_file.h>
+#include <stdio.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define VOLPLAY_HAVE_MMAP
+#endif
+
+namespace volplay {
+    namespace util {
+
+        MappedFile::MappedFile()
+            : _data(0), _size(0), _open(false), _mapped(false)
+        {}
+
+        MappedFile::~MappedFile()
+        {
+            close();
+        }
+
+        bool MappedFile::open(const std::string &filename)
+        {
+            close();
+
+#ifdef VOLPLAY_HAVE_MMAP
+            const int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+
+            struct stat st;
+            if (fstat(fd, &st) != 0) {
+                ::close(fd);
+                return false;
+            }
+
+            if (st.st_size > 0) {
+                void *p = mmap(0, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+                if (p != MAP_FAILED) {
+                    _data = static_cast<const char *>(p);
+                    _size = size_t(st.st_size);
+                    _mapped = true;
+                }
+            }
+
+            ::close(fd);
+            if (st.st_size > 0 && !_mapped)
+                return false;
+#else
+            FILE *f = fopen(filename.c_str(), "rb");
+            if (f == 0)
+                return false;
+
+            bool ok = fseek(f, 0, SEEK_END) == 0;
+            const long n = ok ? ftell(f) : -1;
+            ok = n >= 0 && fseek(f, 0, SEEK_SET) == 0;
+            if (ok) {
+                _buffer.resize(size_t(n));
+                ok = n == 0 || fread(&_buffer[0], 1, size_t(n), f) == size_t(n);
+            }
+            fclose(f);
+
+            if (!ok) {
+                _buffer.clear();
+                return false;
+            }
+
+            _data = _buffer.empty() ? 0 : &_buffer[0];
+            _size = _buffer.size();
+#endif
+
+            _open = true;
+            return true;
+        }
+
+        void MappedFile::close()
+        {
+#ifdef VOLPLAY_HAVE_MMAP
+            if (_mapped)
+                munmap(const_cast<char *>(_data), _size);
+#endif
+            std::vector<char>().swap(_buffer);
+            _data = 0;
+            _size = 0;
+            _open = false;
+            _mapped = false;
+        }
+
+        bool MappedFile::isOpen() const
+        {
+            return _open;
+        }
+
+        const char *MappedFile::data() const
+        {
+            return _data;
+        }
+
+        size_t MappedFile::size() const
+        {
+            return _size;
+        }
+
+    }
+}
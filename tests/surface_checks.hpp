@@ -0,0 +1,38 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#ifndef VOLPLAY_TESTS_SURFACE_CHECKS
+#define VOLPLAY_TESTS_SURFACE_CHECKS
+
+#include <volplay/surface/indexed_surface.h>
+#include <map>
+#include <utility>
+
+/** Test if faces reference existing vertices and each directed edge is used exactly once and its opposite exists. */
+inline bool isClosedAndConsistent(const volplay::surface::IndexedSurface &s)
+{
+    std::map< std::pair<int, int>, int > directed;
+    for (int i = 0; i < int(s.faces.cols()); ++i) {
+        for (int j = 0; j < 3; ++j) {
+            if (s.faces(j, i) < 0 || s.faces(j, i) >= s.vertices.cols())
+                return false;
+            directed[std::make_pair(int(s.faces(j, i)), int(s.faces((j + 1) % 3, i)))] += 1;
+        }
+    }
+
+    for (auto iter = directed.begin(); iter != directed.end(); ++iter) {
+        if (iter->second != 1)
+            return false;
+        if (directed.find(std::make_pair(iter->first.second, iter->first.first)) == directed.end())
+            return false;
+    }
+    return true;
+}
+
+#endif
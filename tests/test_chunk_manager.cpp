@@ -0,0 +1,150 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+#include "surface_checks.hpp"
+
+#include <volplay/volplay.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+TEST_CASE("ChunkManager Streaming")
+{
+    // Ground plane slightly offset from chunk boundaries.
+    vp::SDFNodePtr scene = vp::make()
+        .transform().translate(vp::Vector(0, vp::S(0.3), 0))
+            .plane().normal(vp::Vector(0, 1, 0))
+        .end();
+
+    vps::ChunkManager cm(scene, vp::S(1), 8);
+    vps::DualContouring dc;
+    cm.setExtractor(dc, vps::DualContouring::COMPUTE_LINEAR_DC);
+    cm.setViewRadius(vp::S(2.5));
+    
+    cm.update(vp::Vector(0, vp::S(0.3), 0));
+    cm.waitIdle();
+
+    std::vector<vps::ChunkManager::Chunk> chunks = cm.visibleChunks();
+    REQUIRE(chunks.size() > 0);
+
+    size_t withFaces = 0;
+    size_t bytes = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        bytes += chunks[i].bytes;
+        REQUIRE(chunks[i].bytes > chunks[i].surface->bytes());
+        REQUIRE(chunks[i].key.level == 0);
+        if (chunks[i].surface->faces.cols() > 0) {
+            // Each chunk emits the two triangles of the edges it owns only.
+            REQUIRE(chunks[i].key.coords.y() == 0);
+            REQUIRE(chunks[i].surface->faces.cols() == 2 * 8 * 8);
+            ++withFaces;
+        }
+    }
+    REQUIRE(withFaces > 0);
+    REQUIRE(cm.memoryUsage() == bytes);
+
+    const size_t cached = cm.cachedChunks();
+    REQUIRE(cached == chunks.size());
+
+    // Moving far away with a tiny budget evicts all chunks of the old view.
+    cm.setMemoryBudget(1);
+    cm.update(vp::Vector(100, vp::S(0.3), 0));
+    cm.waitIdle();
+
+    std::vector<vps::ChunkManager::Chunk> moved = cm.visibleChunks();
+    REQUIRE(moved.size() == chunks.size());
+    REQUIRE(cm.cachedChunks() == moved.size());
+    for (size_t i = 0; i < moved.size(); ++i) {
+        REQUIRE(moved[i].key.coords.x() >= 97);
+    }
+}
+
+TEST_CASE("ChunkManager Seams")
+{
+    vp::SDFNodePtr scene = vp::make()
+        .transform().translate(vp::Vector(vp::S(0.05), vp::S(0.1), vp::S(-0.05)))
+            .sphere().radius(vp::S(0.7))
+        .end();
+
+    vps::ChunkManager cm(scene, vp::S(0.5), 8);
+    vps::DualContouring dc;
+    cm.setExtractor(dc, vps::DualContouring::COMPUTE_LINEAR_DC);
+    cm.setViewRadius(vp::S(2));
+
+    cm.update(vp::Vector::Zero());
+    cm.waitIdle();
+
+    // Weld vertices of all chunks by position. Chunks share the vertices along their seams, so
+    // the union is closed and no face is emitted twice.
+    std::map< std::vector<vp::S>, int > ids;
+    std::vector<int> faces;
+    std::set< std::vector<int> > unique;
+    std::vector<vps::ChunkManager::Chunk> chunks = cm.visibleChunks();
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const vps::IndexedSurface &s = *chunks[i].surface;
+        for (int f = 0; f < int(s.faces.cols()); ++f) {
+            std::vector<int> face;
+            for (int j = 0; j < 3; ++j) {
+                const vp::Vector x = s.vertices.col(s.faces(j, f));
+                const std::vector<vp::S> key(x.data(), x.data() + 3);
+                const int id = int(ids.insert(std::make_pair(key, int(ids.size()))).first->second);
+                face.push_back(id);
+                faces.push_back(id);
+            }
+            std::sort(face.begin(), face.end());
+            REQUIRE(unique.insert(face).second);
+        }
+    }
+    REQUIRE(faces.size() > 0);
+
+    vps::IndexedSurface welded;
+    welded.vertices.resize(3, ids.size());
+    welded.faces.resize(3, faces.size() / 3);
+    for (size_t i = 0; i < faces.size(); ++i)
+        welded.faces(i % 3, i / 3) = faces[i];
+    REQUIRE(isClosedAndConsistent(welded));
+}
+
+TEST_CASE("ChunkManager Level of Detail")
+{
+    vp::SDFNodePtr scene = vp::make()
+        .transform().translate(vp::Vector(0, vp::S(0.3), 0))
+            .plane().normal(vp::Vector(0, 1, 0))
+        .end();
+
+    vps::ChunkManager cm(scene, vp::S(1), 8);
+    cm.setViewRadius(vp::S(6));
+    cm.setLevelOfDetail(vp::S(2), 2);
+
+    REQUIRE(cm.levelFor(vp::Index(0, 0, 0), vp::Vector::Zero()) == 0);
+    REQUIRE(cm.levelFor(vp::Index(2, 0, 0), vp::Vector::Zero()) == 1);
+    REQUIRE(cm.levelFor(vp::Index(5, 0, 0), vp::Vector::Zero()) == 2);
+
+    cm.update(vp::Vector::Zero());
+    cm.waitIdle();
+
+    std::vector<vps::ChunkManager::Chunk> chunks = cm.visibleChunks();
+
+    vp::Index::Scalar facesNear = 0, facesFar = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (chunks[i].key.coords == vp::Index(0, 0, 0))
+            facesNear = chunks[i].surface->faces.cols();
+        if (chunks[i].key.coords == vp::Index(5, 0, 0))
+            facesFar = chunks[i].surface->faces.cols();
+    }
+
+    REQUIRE(facesFar > 0);
+    REQUIRE(facesFar < facesNear);
+}
@@ -0,0 +1,106 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+#include <stdio.h>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+/** Largest absolute deviation of grid from the scene. */
+static vp::Scalar maxError(const vp::DistanceGrid &g, const vp::SDFNodePtr &scene)
+{
+    vp::Scalar e = 0;
+    for (int z = 0; z < g.dims.z(); ++z)
+        for (int y = 0; y < g.dims.y(); ++y)
+            for (int x = 0; x < g.dims.x(); ++x)
+                e = std::max<vp::Scalar>(e, std::abs(g.values[g.index(x, y, z)] - scene->eval(g.position(x, y, z))));
+    return e;
+}
+
+static int countKnown(const vp::DistanceGrid &g)
+{
+    int n = 0;
+    for (size_t i = 0; i < g.known.size(); ++i)
+        n += g.known[i];
+    return n;
+}
+
+TEST_CASE("DistanceTransform")
+{
+    vp::SDFNodePtr sphere = vp::make().sphere().radius(vp::S(1.2));
+    const vp::Index dims(41, 37, 40);
+    const vp::Vector spacing = vp::Vector::Constant(vp::S(0.1));
+    const vp::Vector origin(-2, -1.8f, -2.1f);
+    const vp::Scalar h = spacing.maxCoeff();
+
+    vp::DistanceTransform dt;
+    vp::DistanceGrid band(dims, origin, spacing);
+    REQUIRE(band.size() == int(band.values.size()));
+    REQUIRE(band.index(1, 2, 3) == (3 * dims.y() + 2) * dims.x() + 1);
+
+    // Only blocks near the surface are evaluated.
+    const int evaluations = dt.sampleNarrowBand(sphere, band);
+    REQUIRE(evaluations < band.size() / 2);
+    REQUIRE(countKnown(band) > 0);
+    for (int i = 0; i < band.size(); ++i) {
+        if (band.known[i])
+            REQUIRE(std::abs(band.values[i]) <= 2 * h);
+    }
+    REQUIRE(band.values[band.index(20, 18, 21)] < 0);
+    REQUIRE(band.values[band.index(0, 0, 0)] > 0);
+
+    SECTION("JumpFlooding")
+    {
+        vp::DistanceGrid g = band;
+        dt.jumpFlood(g);
+        REQUIRE(countKnown(g) == g.size());
+        REQUIRE(maxError(g, sphere) < h * vp::S(0.5));
+    }
+
+    SECTION("FastSweeping")
+    {
+        vp::DistanceGrid g = band;
+        REQUIRE(dt.fastSweep(g) > 0);
+        REQUIRE(countKnown(g) == g.size());
+        REQUIRE(maxError(g, sphere) < h * vp::S(1.5));
+    }
+
+    SECTION("Occupancy")
+    {
+        vp::DistanceGrid g(dims, origin, spacing);
+        std::vector<char> inside(g.size());
+        for (int z = 0; z < dims.z(); ++z)
+            for (int y = 0; y < dims.y(); ++y)
+                for (int x = 0; x < dims.x(); ++x)
+                    inside[g.index(x, y, z)] = sphere->eval(g.position(x, y, z)) < 0;
+
+        dt.sampleOccupancy(inside, g);
+        dt.fastSweep(g);
+        REQUIRE(countKnown(g) == g.size());
+        REQUIRE(maxError(g, sphere) < h * 2);
+    }
+
+    SECTION("Volume")
+    {
+        vp::DistanceGrid g = band;
+        dt.jumpFlood(g);
+        REQUIRE(vp::SDFVolume::write("volplay_test_dt.vol", g.dims, g.origin, g.spacing, g.values, 8));
+
+        vp::SDFVolumePtr v = std::make_shared<vp::SDFVolume>();
+        REQUIRE(v->open("volplay_test_dt.vol"));
+        REQUIRE_CLOSE_PREC(v->eval(vp::Vector(0.3f, 1.9f, -0.2f)), sphere->eval(vp::Vector(0.3f, 1.9f, -0.2f)), h);
+
+        v.reset();
+        remove("volplay_test_dt.vol");
+    }
+}
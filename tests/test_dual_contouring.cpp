@@ -11,6 +11,9 @@
 #include "float_comparison.hpp"
 
 #include <volplay/volplay.h>
+#include <atomic>
+#include <algorithm>
+#include <set>
 
 namespace vp = volplay;
 namespace vps = volplay::surface;
@@ -92,4 +95,286 @@ TEST_CASE("DualContouring Sphere with Offset")
             REQUIRE_CLOSE_PREC(cosangle, vp::S(1), 0.01);
         }
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("DualContouring Evaluation Count")
+{
+    // Count scene evaluations through a displacement without effect.
+    std::atomic<int> evals(0);
+    vp::SDFNodePtr scene = vp::make()
+        .displacement().fnc([&evals](const vp::Vector &) -> vp::S { ++evals; return 0; })
+            .sphere().radius(1)
+        .end();
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector(-2,-2,-2));
+    dc.setUpperBounds(vp::Vector(2,2,2));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.1)));
+    vps::IndexedSurface surface = dc.compute(scene, vps::DualContouring::COMPUTE_LINEAR_DC);
+
+    REQUIRE(surface.faces.cols() > 0);
+
+    // Sampling both ends of every edge would require two evaluations per edge.
+    const int corners = 41 * 41 * 41;
+    const int edges = 3 * 41 * 41 * 40;
+    const int n = evals;
+    const int reduced = n * 3;
+    REQUIRE(n > corners);
+    REQUIRE(reduced < edges * 2);
+}
+
+TEST_CASE("DualContouring Root Finders")
+{
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .sphere().radius(vp::S(0.8))
+            .transform().translate(vp::Vector(vp::S(0.6), 0, 0))
+                .box().halfLengths(vp::Vector::Constant(vp::S(0.4)))
+            .end()
+        .end();
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector(-2,-2,-2));
+    dc.setUpperBounds(vp::Vector(2,2,2));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.1)));
+
+    const vps::DualContouring::ERootFinder finders[] = {
+        vps::DualContouring::ROOT_BRENT,
+        vps::DualContouring::ROOT_ILLINOIS,
+        vps::DualContouring::ROOT_NEWTON,
+        vps::DualContouring::ROOT_ILLINOIS_BATCHED
+    };
+
+    vps::IndexedSurface surfaces[4];
+    vps::DualContouring::Statistics stats[4];
+    for (int i = 0; i < 4; ++i) {
+        dc.setRootFinder(finders[i]);
+        surfaces[i] = dc.compute(scene);
+        stats[i] = dc.statistics();
+    }
+
+    for (int i = 1; i < 4; ++i) {
+        REQUIRE(stats[i].crossingEdges == stats[0].crossingEdges);
+        REQUIRE(stats[i].cornerEvaluations == stats[0].cornerEvaluations);
+        REQUIRE(surfaces[i].vertices.cols() == surfaces[0].vertices.cols());
+        REQUIRE(surfaces[i].faces.cols() == surfaces[0].faces.cols());
+    }
+
+    // Lockstep iteration performs the same steps as the sequential Illinois method.
+    REQUIRE(stats[3].rootEvaluations == stats[1].rootEvaluations);
+    REQUIRE(stats[1].rootEvaluations < stats[0].rootEvaluations);
+
+    const size_t brent = stats[0].rootEvaluations + stats[0].normalEvaluations;
+    const size_t newton = stats[2].rootEvaluations + stats[2].normalEvaluations;
+    REQUIRE(newton < brent);
+}
+
+TEST_CASE("DualContouring Quads")
+{
+    vp::SDFNodePtr scene = vp::make().sphere().radius(1);
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector(-2,-2,-2));
+    dc.setUpperBounds(vp::Vector(2,2,2));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.2)));
+    vps::IndexedSurface tris = dc.compute(scene);
+
+    dc.setFaceType(vps::DualContouring::FACE_QUADS);
+    vps::IndexedSurface quads = dc.compute(scene);
+
+    REQUIRE(quads.faces.rows() == 4);
+    const int quadsAsTris = int(quads.faces.cols()) * 2;
+    REQUIRE(quadsAsTris == tris.faces.cols());
+    REQUIRE(quads.vertices.cols() == tris.vertices.cols());
+
+    vps::IndexedSurface::TriangleMatrix t = quads.triangles();
+    REQUIRE(t.cols() == tris.faces.cols());
+    const bool same = (t == tris.faces);
+    REQUIRE(same);
+}
+
+TEST_CASE("DualContouring Adaptive Simplification")
+{
+    vp::SDFNodePtr scene = vp::make().box().halfLengths(vp::Vector(vp::S(0.55), vp::S(0.55), vp::S(0.55)));
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector(-1,-1,-1));
+    dc.setUpperBounds(vp::Vector(1,1,1));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.05)));
+    vps::IndexedSurface uniform = dc.compute(scene);
+
+    dc.setSimplificationError(vp::S(1e-4));
+    vps::IndexedSurface adaptive = dc.compute(scene);
+
+    const int fewer = int(uniform.faces.cols()) / 4;
+    REQUIRE(adaptive.faces.cols() > 0);
+    REQUIRE(adaptive.faces.cols() < fewer);
+
+    // Vertices of collapsed cells stay on the planar faces of the box.
+    for (int i = 0; i < adaptive.faces.cols(); ++i) {
+        for (int j = 0; j < 3; ++j) {
+            const vp::Scalar d = std::abs(scene->eval(adaptive.vertices.col(adaptive.faces(j, i))));
+            REQUIRE(d < vp::S(0.01));
+        }
+    }
+
+    dc.setFaceType(vps::DualContouring::FACE_QUADS);
+    vps::IndexedSurface quads = dc.compute(scene);
+    REQUIRE(quads.faces.rows() == 4);
+    REQUIRE(quads.vertices.cols() == adaptive.vertices.cols());
+
+    // Faces with three distinct vertices repeat the third one.
+    int degenerate = 0;
+    for (int i = 0; i < quads.faces.cols(); ++i) {
+        const vps::IndexedSurface::FaceMatrix::ColXpr f = quads.faces.col(i);
+        const bool distinct = f(0) != f(1) && f(0) != f(2) && f(1) != f(2);
+        REQUIRE(distinct);
+        if (f(3) == f(2)) {
+            ++degenerate;
+        } else {
+            const bool distinctLast = f(3) != f(0) && f(3) != f(1);
+            REQUIRE(distinctLast);
+        }
+    }
+    REQUIRE(degenerate > 0);
+}
+
+TEST_CASE("DualContouring Periodicity")
+{
+    // Asymmetric content reveals the mirroring of SDFRepetition at the origin. It does not
+    // cross the mirror planes, where normals are distorted.
+    vp::SDFNodePtr scene = vp::make()
+        .repetition().cellSizes(vp::Vector::Constant(1))
+            .transform().translate(vp::Vector(vp::S(0.21), vp::S(0.26), 0))
+                .sphere().radius(vp::S(0.17))
+            .end()
+        .end();
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector::Constant(vp::S(-2.5)));
+    dc.setUpperBounds(vp::Vector::Constant(vp::S(2.5)));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.1)));
+
+    vps::IndexedSurface periodic = dc.compute(scene);
+    const vps::DualContouring::Statistics sp = dc.statistics();
+
+    dc.setPeriodicityEnabled(false);
+    vps::IndexedSurface uniform = dc.compute(scene);
+    const vps::DualContouring::Statistics su = dc.statistics();
+
+    // Only a single cell is sampled.
+    REQUIRE(sp.cornerEvaluations == 11 * 11 * 11);
+    REQUIRE(su.cornerEvaluations == 51 * 51 * 51);
+
+    REQUIRE(periodic.vertices.cols() == uniform.vertices.cols());
+    REQUIRE(periodic.faces.cols() == uniform.faces.cols());
+
+    // Same face centroids up to order.
+    auto centroid = [](const vps::IndexedSurface &s, int i) {
+        const vp::Vector x = (s.vertices.col(s.faces(0, i)) + s.vertices.col(s.faces(1, i)) + s.vertices.col(s.faces(2, i))) / vp::S(3);
+        return vp::Index((x * vp::S(1000)).array().round().cast<int>());
+    };
+
+    std::set< std::vector<int> > keys;
+    for (int i = 0; i < int(uniform.faces.cols()); ++i) {
+        const vp::Index k = centroid(uniform, i);
+        keys.insert(std::vector<int>(k.data(), k.data() + 3));
+    }
+
+    int unmatched = 0;
+    for (int i = 0; i < int(periodic.faces.cols()); ++i) {
+        const vp::Index k = centroid(periodic, i);
+        bool found = false;
+        for (int n = 0; n < 27 && !found; ++n) {
+            const vp::Index o = k + vp::Index(n % 3 - 1, (n / 3) % 3 - 1, n / 9 - 1);
+            found = keys.count(std::vector<int>(o.data(), o.data() + 3)) > 0;
+        }
+        if (!found)
+            ++unmatched;
+    }
+    REQUIRE(unmatched == 0);
+
+    // Cost does not grow with the number of cells.
+    dc.setPeriodicityEnabled(true);
+    dc.setLowerBounds(vp::Vector(vp::S(-50.5), vp::S(-50.5), vp::S(-0.5)));
+    dc.setUpperBounds(vp::Vector(vp::S(49.5), vp::S(49.5), vp::S(0.5)));
+    vps::IndexedSurface lattice = dc.compute(scene);
+    const vps::DualContouring::Statistics sl = dc.statistics();
+
+    REQUIRE(sl.cornerEvaluations == 11 * 11 * 11);
+    const size_t rootBudget = 2 * sp.rootEvaluations;
+    REQUIRE(sl.rootEvaluations < rootBudget);
+    const int faces = int(lattice.faces.cols());
+    // The mirrored content yields 6 x 6 x 5 spheres in the first case and 100 x 100 x 1 in the lattice. 
+    // Far from the origin, rounding of grid coordinates changes the tessellation of some spheres.
+    const int expectedFaces = int(periodic.faces.cols() / 180) * 10000;
+    const int deviation = std::abs(faces - expectedFaces);
+    REQUIRE(deviation < expectedFaces / 20);
+}
+
+TEST_CASE("DualContouring Multiple Iso Levels")
+{
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .sphere().radius(1)
+            .transform().translate(vp::Vector(vp::S(0.8), 0, 0))
+                .box().halfLengths(vp::Vector::Constant(vp::S(0.5)))
+            .end()
+        .end();
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector::Constant(-2));
+    dc.setUpperBounds(vp::Vector::Constant(2));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.1)));
+
+    std::vector<vp::Scalar> levels;
+    levels.push_back(vp::S(-0.25));
+    levels.push_back(vp::S(0));
+    levels.push_back(vp::S(0.5));
+
+    const std::vector<vps::IndexedSurface> shells = dc.computeIsoLevels(scene, levels);
+    const vps::DualContouring::Statistics sm = dc.statistics();
+    REQUIRE(shells.size() == 3);
+
+    size_t cornerEvaluations = 0;
+    for (size_t l = 0; l < levels.size(); ++l) {
+        dc.setIsoLevel(levels[l]);
+        const vps::IndexedSurface s = dc.compute(scene);
+        cornerEvaluations += dc.statistics().cornerEvaluations;
+
+        REQUIRE(shells[l].vertices.cols() == s.vertices.cols());
+        REQUIRE(shells[l].faces.cols() == s.faces.cols());
+        REQUIRE(shells[l].vertices.isApprox(s.vertices));
+    }
+
+    // Corners are sampled once for all levels.
+    const size_t sharedEvaluations = sm.cornerEvaluations * 3;
+    REQUIRE(sharedEvaluations == cornerEvaluations);
+
+    // Outer shells are larger.
+    REQUIRE(shells[0].faces.cols() < shells[1].faces.cols());
+    REQUIRE(shells[1].faces.cols() < shells[2].faces.cols());
+}
+
+TEST_CASE("DualContouring Grid Too Large")
+{
+    vp::SDFNodePtr scene = vp::make().sphere().radius(1);
+
+    // Two million voxels along x cannot be addressed.
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector(-2, -2, -2));
+    dc.setUpperBounds(vp::Vector(2, 2, 2));
+    dc.setResolution(vp::Vector(vp::S(2e-6), 1, 1));
+
+    const vps::IndexedSurface s = dc.compute(scene);
+    REQUIRE(s.vertices.cols() == 0);
+    REQUIRE(s.faces.cols() == 0);
+    REQUIRE(dc.statistics().cornerEvaluations == 0);
+    REQUIRE(!dc.saveHermiteData(scene, "dc_too_large.hermite"));
+    REQUIRE(!dc.computeChunked(scene, "dc_too_large"));
+
+    std::vector<vp::Scalar> levels(2, vp::S(0));
+    const std::vector<vps::IndexedSurface> shells = dc.computeIsoLevels(scene, levels);
+    REQUIRE(shells.size() == 2);
+    REQUIRE(shells[0].faces.cols() == 0);
+}
@@ -0,0 +1,86 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+/** Faces with vertex indices rotated to start at the smallest index, sorted. */
+static std::vector< std::vector<int> > sortedFaces(const vps::IndexedSurface &s)
+{
+    std::vector< std::vector<int> > f;
+    for (int i = 0; i < int(s.faces.cols()); ++i) {
+        std::vector<int> face(s.faces.col(i).data(), s.faces.col(i).data() + s.faces.rows());
+        std::rotate(face.begin(), std::min_element(face.begin(), face.end()), face.end());
+        f.push_back(face);
+    }
+    std::sort(f.begin(), f.end());
+    return f;
+}
+
+TEST_CASE("HermiteCache Rebuild Surface")
+{
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .sphere().radius(1)
+            .transform().translate(vp::Vector(vp::S(0.8), 0, 0))
+                .box().halfLengths(vp::Vector::Constant(vp::S(0.5)))
+            .end()
+        .end();
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector(-2,-2,-2));
+    dc.setUpperBounds(vp::Vector(2,2,2));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.1)));
+    
+    const vps::IndexedSurface reference = dc.compute(scene);
+    const vps::IndexedSurface referenceMidpoint = dc.compute(scene, vps::DualContouring::COMPUTE_MIDPOINT);
+
+    REQUIRE(dc.saveHermiteData(scene, "volplay_test_hermite.cache"));
+    const size_t cornerEvaluations = dc.statistics().cornerEvaluations;
+    REQUIRE(cornerEvaluations > 0);
+
+    vps::HermiteCache cache;
+    REQUIRE(!cache.open("volplay_test_hermite_missing.cache"));
+    REQUIRE(cache.open("volplay_test_hermite.cache"));
+    REQUIRE(cache.lowerBounds().isApprox(dc.lowerBounds()));
+    REQUIRE(cache.resolution().isApprox(dc.resolution()));
+    const int faceCount = cache.edgeCount() * 2;
+    REQUIRE(faceCount == reference.faces.cols());
+    REQUIRE(cache.voxelCount() == reference.vertices.cols());
+
+    // Rebuild using a fresh instance, so nothing but the cache is shared.
+    vps::DualContouring dc2;
+    vps::IndexedSurface s = dc2.computeFromHermiteData(cache);
+    REQUIRE(dc2.statistics().cornerEvaluations == 0);
+    REQUIRE(s.vertices.cols() == reference.vertices.cols());
+    REQUIRE(s.vertices.isApprox(reference.vertices));
+    REQUIRE(sortedFaces(s) == sortedFaces(reference));
+
+    s = dc2.computeFromHermiteData(cache, vps::DualContouring::COMPUTE_MIDPOINT);
+    REQUIRE(s.vertices.cols() == referenceMidpoint.vertices.cols());
+    REQUIRE(s.faces.cols() == referenceMidpoint.faces.cols());
+
+    // Truncating more singular values pulls vertices towards mass points, topology is kept.
+    dc2.setSingularValueThreshold(vp::S(10));
+    dc2.setFaceType(vps::DualContouring::FACE_QUADS);
+    s = dc2.computeFromHermiteData(cache);
+    REQUIRE(s.faces.rows() == 4);
+    REQUIRE(s.faces.cols() == cache.edgeCount());
+    REQUIRE(!s.vertices.isApprox(reference.vertices));
+
+    remove("volplay_test_hermite.cache");
+}
@@ -0,0 +1,115 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+#include <volplay/sdf_rigid_transform.h>
+#include <set>
+#include <vector>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+/** Count faces of a without a face of b having a centroid within about 0.001. */
+static int unmatchedFaces(const vps::IndexedSurface &a, const vps::IndexedSurface &b)
+{
+    auto centroid = [](const vps::IndexedSurface &s, int i) {
+        const vp::Vector x = (s.vertices.col(s.faces(0, i)) + s.vertices.col(s.faces(1, i)) + s.vertices.col(s.faces(2, i))) / vp::S(3);
+        return vp::Index((x * vp::S(1000)).array().round().cast<int>());
+    };
+
+    std::set< std::vector<int> > keys;
+    for (int i = 0; i < int(b.faces.cols()); ++i) {
+        const vp::Index k = centroid(b, i);
+        keys.insert(std::vector<int>(k.data(), k.data() + 3));
+    }
+
+    int unmatched = 0;
+    for (int i = 0; i < int(a.faces.cols()); ++i) {
+        const vp::Index k = centroid(a, i);
+        bool found = false;
+        for (int n = 0; n < 27 && !found; ++n) {
+            const vp::Index o = k + vp::Index(n % 3 - 1, (n / 3) % 3 - 1, n / 9 - 1);
+            found = keys.count(std::vector<int>(o.data(), o.data() + 3)) > 0;
+        }
+        if (!found)
+            ++unmatched;
+    }
+    return unmatched;
+}
+
+TEST_CASE("IncrementalMesher Update")
+{
+    vp::SDFNodePtr moving;
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .transform().translate(vp::Vector(-1, 0, 0))
+                .sphere().radius(vp::S(0.5))
+            .end()
+            .transform().translate(vp::Vector(1, 0, 0)).storeNodePtr(&moving)
+                .sphere().radius(vp::S(0.5))
+            .end()
+        .end();
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector::Constant(-2));
+    dc.setUpperBounds(vp::Vector::Constant(2));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.05)));
+    dc.setRootFinder(vps::DualContouring::ROOT_ILLINOIS);
+
+    vps::IncrementalMesher im(dc, 16);
+    REQUIRE(im.blockCount() == 125);
+
+    REQUIRE(im.compute(scene).size() == 125);
+    REQUIRE(im.extractedBlocks() == 125);
+    {
+        vps::IndexedSurface reference = dc.compute(scene);
+        REQUIRE(im.surface().vertices.cols() == reference.vertices.cols());
+        REQUIRE(im.surface().faces.cols() == reference.faces.cols());
+        REQUIRE(unmatchedFaces(im.surface(), reference) == 0);
+    }
+
+    // Nothing changed
+    REQUIRE(im.update(scene).empty());
+    REQUIRE(im.extractedBlocks() == 0);
+
+    // Move one sphere, marking its old and new bounds.
+    vp::AffineTransform t = vp::AffineTransform::Identity();
+    t.translate(vp::Vector(1, vp::S(0.3), 0));
+    std::static_pointer_cast<vp::SDFRigidTransform>(moving)->setLocalToWorld(t);
+
+    im.markDirty(vp::Vector(vp::S(0.5), vp::S(-0.5), vp::S(-0.5)), vp::Vector(vp::S(1.5), vp::S(0.5), vp::S(0.5)));
+    im.markDirty(vp::Vector(vp::S(0.5), vp::S(-0.2), vp::S(-0.5)), vp::Vector(vp::S(1.5), vp::S(0.8), vp::S(0.5)));
+    const std::vector<int> changed = im.update(scene);
+
+    REQUIRE(im.extractedBlocks() > 0);
+    REQUIRE(im.extractedBlocks() < 40);
+    REQUIRE(int(changed.size()) >= im.extractedBlocks());
+    REQUIRE(int(changed.size()) < 60);
+
+    vps::IndexedSurface reference = dc.compute(scene);
+    REQUIRE(im.surface().vertices.cols() == reference.vertices.cols());
+    REQUIRE(im.surface().faces.cols() == reference.faces.cols());
+    REQUIRE(unmatchedFaces(im.surface(), reference) == 0);
+
+    // Block surfaces are self-contained and partition the faces.
+    int faces = 0;
+    for (int b = 0; b < im.blockCount(); ++b) {
+        const vps::IndexedSurface &s = im.blockSurface(b);
+        faces += int(s.faces.cols());
+        if (s.faces.cols() > 0) {
+            REQUIRE(s.faces.minCoeff() >= 0);
+            REQUIRE(s.faces.maxCoeff() < s.vertices.cols());
+            REQUIRE(unmatchedFaces(s, reference) == 0);
+        }
+    }
+    REQUIRE(faces == int(reference.faces.cols()));
+}
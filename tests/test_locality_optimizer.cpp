@@ -0,0 +1,84 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+#include <algorithm>
+#include <vector>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+/** Faces given by the positions of their vertices, sorted. Independent of vertex and face order. */
+static std::vector< std::vector<vp::Scalar> > facePositions(const vps::IndexedSurface &s)
+{
+    std::vector< std::vector<vp::Scalar> > f;
+    for (int i = 0; i < int(s.faces.cols()); ++i) {
+        std::vector<vp::Scalar> face;
+        for (int j = 0; j < int(s.faces.rows()); ++j) {
+            const vp::Vector x = s.vertices.col(s.faces(j, i));
+            face.insert(face.end(), x.data(), x.data() + 3);
+        }
+        f.push_back(face);
+    }
+    std::sort(f.begin(), f.end());
+    return f;
+}
+
+TEST_CASE("LocalityOptimizer Reorder")
+{
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .sphere().radius(1)
+            .transform().translate(vp::Vector(vp::S(0.8), 0, 0))
+                .box().halfLengths(vp::Vector::Constant(vp::S(0.5)))
+            .end()
+        .end();
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector::Constant(-2));
+    dc.setUpperBounds(vp::Vector::Constant(2));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.05)));
+    const vps::IndexedSurface s = dc.compute(scene);
+
+    vps::IndexedSurface o = s;
+    vps::LocalityOptimizer lo;
+    lo.apply(o);
+
+    // Only the order of vertices and faces changes.
+    REQUIRE(o.vertices.cols() == s.vertices.cols());
+    REQUIRE(o.faces.cols() == s.faces.cols());
+    REQUIRE(facePositions(o) == facePositions(s));
+
+    const vps::LocalityOptimizer::Statistics &st = lo.statistics();
+    REQUIRE(st.acmrBefore == vps::LocalityOptimizer::averageCacheMissRatio(s, 16));
+    REQUIRE(st.acmrAfter == vps::LocalityOptimizer::averageCacheMissRatio(o, 16));
+    REQUIRE(st.acmrAfter < st.acmrBefore);
+    REQUIRE(st.acmrAfter < vp::S(0.8));
+
+    // Same through dual contouring, for quads as well.
+    dc.setLocalityOptimizationEnabled(true);
+    dc.setFaceType(vps::DualContouring::FACE_QUADS);
+    const vps::IndexedSurface q = dc.compute(scene);
+    const vps::DualContouring::Statistics &sq = dc.statistics();
+    REQUIRE(q.faces.rows() == 4);
+    REQUIRE(sq.acmrAfter > vp::S(0));
+    REQUIRE(sq.acmrAfter < sq.acmrBefore);
+    // And for each iso level.
+    std::vector<vp::Scalar> levels;
+    levels.push_back(vp::S(0));
+    levels.push_back(vp::S(0.2));
+    const std::vector<vps::IndexedSurface> shells = dc.computeIsoLevels(scene, levels);
+    const vps::DualContouring::Statistics &sl = dc.statistics();
+    REQUIRE(sl.acmrAfter > vp::S(0));
+    REQUIRE(sl.acmrAfter < sl.acmrBefore);
+    REQUIRE(shells[0].faces.cols() == q.faces.cols());
+}
@@ -0,0 +1,127 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+#include "surface_checks.hpp"
+
+#include <volplay/volplay.h>
+#include <volplay/surface/block_grid.h>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+TEST_CASE("MarchingCubes Sphere")
+{
+    vp::SDFNodePtr scene = vp::make().sphere().radius(1);
+
+    vps::MarchingCubes mc;
+    mc.setLowerBounds(vp::Vector(-2,-2,-2));
+    mc.setUpperBounds(vp::Vector(2,2,2));
+    mc.setResolution(vp::Vector::Constant(vp::S(0.1)));
+    mc.setBlockSize(7);
+    vps::IndexedSurface surface = mc.compute(scene);
+
+    REQUIRE(surface.faces.cols() > 0);
+
+    for (int i = 0; i < int(surface.vertices.cols()); ++i) {
+        REQUIRE_CLOSE_PREC(surface.vertices.col(i).norm(), vp::S(1), vp::S(0.01));
+    }
+
+    // Faces point outwards
+    for (int i = 0; i < int(surface.faces.cols()); ++i) {
+        auto t = surface.faces.col(i);
+        vp::Vector a = surface.vertices.col(t(1)) - surface.vertices.col(t(0));
+        vp::Vector b = surface.vertices.col(t(2)) - surface.vertices.col(t(0));
+        vp::Vector c = (surface.vertices.col(t(0)) + surface.vertices.col(t(1)) + surface.vertices.col(t(2))) / vp::S(3);
+        
+        const bool outwards = a.cross(b).dot(c) >= 0; // Degenerate where crossings coincide with corners
+        REQUIRE(outwards);
+    }
+
+    // Blocks share vertices on their boundaries.
+    REQUIRE(isClosedAndConsistent(surface));
+
+    mc.setBlockSize(64);
+    vps::IndexedSurface single = mc.compute(scene);
+    REQUIRE(single.vertices.cols() == surface.vertices.cols());
+    REQUIRE(single.faces.cols() == surface.faces.cols());
+
+    mc.setSkipEmptyBlocks(false);
+    vps::IndexedSurface full = mc.compute(scene);
+    REQUIRE(full.vertices.cols() == surface.vertices.cols());
+    REQUIRE(full.faces.cols() == surface.faces.cols());
+}
+
+TEST_CASE("MarchingCubes Ambiguous Faces")
+{
+    // Two spheres touching along a thin neck produce ambiguous cube faces.
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .transform().translate(vp::Vector(vp::S(-0.52), 0, 0))
+                .sphere().radius(vp::S(0.5))
+            .end()
+            .transform().translate(vp::Vector(vp::S(0.52), 0, 0))
+                .sphere().radius(vp::S(0.5))
+            .end()
+        .end();
+
+    vps::MarchingCubes mc;
+    mc.setLowerBounds(vp::Vector(-2,-2,-2));
+    mc.setUpperBounds(vp::Vector(2,2,2));
+    mc.setResolution(vp::Vector(vp::S(0.13), vp::S(0.07), vp::S(0.11)));
+    mc.setBlockSize(5);
+    vps::IndexedSurface surface = mc.compute(scene);
+    
+    REQUIRE(surface.faces.cols() > 0);
+    REQUIRE(isClosedAndConsistent(surface));
+}
+
+TEST_CASE("MarchingCubes Iso Level")
+{
+    vp::SDFNodePtr scene = vp::make().sphere().radius(1);
+
+    vps::MarchingCubes mc;
+    mc.setLowerBounds(vp::Vector(-2,-2,-2));
+    mc.setUpperBounds(vp::Vector(2,2,2));
+    mc.setResolution(vp::Vector::Constant(vp::S(0.1)));
+    mc.setIsoLevel(vp::S(0.5));
+    vps::IndexedSurface surface = mc.compute(scene);
+
+    REQUIRE(surface.vertices.cols() > 0);
+    for (int i = 0; i < int(surface.vertices.cols()); ++i) {
+        REQUIRE_CLOSE_PREC(surface.vertices.col(i).norm(), vp::S(1.5), vp::S(0.01));
+    }
+}
+
+TEST_CASE("BlockGrid Unresolved References")
+{
+    vps::BlockGrid grid(vp::Index::Zero(), vp::Index::Constant(8), 4);
+
+    std::vector<vps::BlockMesh> blocks(grid.size());
+    for (int b = 0; b < grid.size(); ++b)
+        blocks[b].reset(grid.blockLower(b), grid.blockUpper(b), 3);
+
+    const vps::BlockVertexRef a(vp::Index(1, 1, 1), 0);
+    const vps::BlockVertexRef b(vp::Index(5, 1, 1), 0);
+    const vps::BlockVertexRef c(vp::Index(1, 5, 1), 0);
+    blocks[grid.owner(a.corner)].addVertex(a.corner, a.sub, vp::Vector(1, 1, 1));
+    blocks[grid.owner(b.corner)].addVertex(b.corner, b.sub, vp::Vector(5, 1, 1));
+    blocks[grid.owner(c.corner)].addVertex(c.corner, c.sub, vp::Vector(1, 5, 1));
+
+    // The second triangle references a vertex no block generated.
+    blocks[0].addTriangle(a, b, c);
+    blocks[0].addTriangle(a, c, vps::BlockVertexRef(vp::Index(1, 1, 5), 0));
+
+    vps::IndexedSurface s;
+    vps::assembleBlocks(grid, blocks, s);
+    REQUIRE(s.vertices.cols() == 3);
+    REQUIRE(s.faces.cols() == 1);
+    REQUIRE(s.vertices.col(s.faces(1, 0)).isApprox(vp::Vector(5, 1, 1)));
+}
@@ -10,6 +10,7 @@
 #include "catch.hpp"
 #include "float_comparison.hpp"
 #include <volplay/math/root.h>
+#include <volplay/math/qef.h>
 
 namespace vp = volplay;
 
@@ -28,4 +29,92 @@ TEST_CASE("Roots")
     
     REQUIRE(!vp::math::findRootBrent(f, vp::S(10), vp::S(12), vp::S(0.0001), 20, r));
     
-}
\ No newline at end of file
+}
+
+TEST_CASE("Roots-Illinois")
+{
+    auto f = [](vp::S x) { return std::pow(x, 3) - 6 * std::pow(x, 2) + 4 * x + 12; };
+    
+    vp::S r;
+    REQUIRE( vp::math::findRootIllinois(f, vp::S(-1.1), vp::S(-1.0), f(vp::S(-1.1)), f(vp::S(-1.0)), vp::S(0.00001), 20, r));
+    REQUIRE_CLOSE_PREC(vp::S(-1.0514), r, vp::S(0.0001));
+    REQUIRE( vp::math::findRootIllinois(f, vp::S(4), vp::S(10), f(vp::S(4)), f(vp::S(10)), vp::S(0.00001), 50, r));
+    REQUIRE_CLOSE_PREC(vp::S(4.5341), r, vp::S(0.0001));
+    
+    REQUIRE(!vp::math::findRootIllinois(f, vp::S(10), vp::S(12), f(vp::S(10)), f(vp::S(12)), vp::S(0.00001), 20, r));
+}
+
+TEST_CASE("Roots-Newton")
+{
+    auto fdf = [](vp::S x, vp::S &fx, vp::S &dfx) {
+        fx = std::pow(x, 3) - 6 * std::pow(x, 2) + 4 * x + 12;
+        dfx = 3 * std::pow(x, 2) - 12 * x + 4;
+    };
+    auto f = [&fdf](vp::S x) { vp::S fx, dfx; fdf(x, fx, dfx); return fx; };
+    
+    vp::S r;
+    REQUIRE( vp::math::findRootNewton(fdf, vp::S(2.4), vp::S(2.6), f(vp::S(2.4)), f(vp::S(2.6)), vp::S(0.00001), 20, r));
+    REQUIRE_CLOSE_PREC(vp::S(2.5173), r, vp::S(0.0001));
+    // Derivative vanishes at 0.37 and 3.63 within the bracket, Newton steps are safeguarded by bisection.
+    REQUIRE( vp::math::findRootNewton(fdf, vp::S(0), vp::S(4), f(vp::S(0)), f(vp::S(4)), vp::S(0.00001), 50, r));
+    REQUIRE_CLOSE_PREC(vp::S(2.5173), r, vp::S(0.0001));
+    
+    REQUIRE(!vp::math::findRootNewton(fdf, vp::S(10), vp::S(12), f(vp::S(10)), f(vp::S(12)), vp::S(0.00001), 20, r));
+}
+
+TEST_CASE("QEF-Corner")
+{
+    // Three orthogonal planes meeting at (1,2,3)
+    vp::math::QEF q;
+    q.add(vp::Vector(1, 0, 0), vp::Vector::UnitX());
+    q.add(vp::Vector(0, 2, 0), vp::Vector::UnitY());
+    q.add(vp::Vector(0, 0, 3), vp::Vector::UnitZ());
+
+    vp::S err;
+    vp::Vector x = q.solve(vp::S(0.1), &err);
+    REQUIRE_CLOSE_VECTOR(x, vp::Vector(1, 2, 3));
+    REQUIRE_CLOSE(err, vp::S(0));
+    REQUIRE_CLOSE(q.error(vp::Vector(2, 2, 3)), vp::S(1));
+}
+
+TEST_CASE("QEF-Degenerate")
+{
+    // Two parallel planes with identical normal. Solution in plane nearest to mass point.
+    vp::math::QEF q;
+    q.add(vp::Vector(1, 0, 0), vp::Vector::UnitX());
+    q.add(vp::Vector(1, 2, 4), vp::Vector::UnitX());
+
+    vp::Vector x = q.solve();
+    REQUIRE_CLOSE_VECTOR(x, vp::Vector(1, 1, 2));
+}
+
+TEST_CASE("QEF-Merge-Batch")
+{
+    vp::math::QEF a, b;
+    a.add(vp::Vector(1, 0, 0), vp::Vector::UnitX());
+    a.add(vp::Vector(0, 2, 0), vp::Vector::UnitY());
+    b.add(vp::Vector(0, 0, 3), vp::Vector::UnitZ());
+    a.merge(b);
+
+    REQUIRE(a.count() == 3);
+    REQUIRE_CLOSE_VECTOR(a.solve(), vp::Vector(1, 2, 3));
+
+    vp::math::QEFBatch batch;
+    batch.resize(2);
+    batch.add(0, vp::Vector(1, 0, 0), vp::Vector::UnitX());
+    batch.add(0, vp::Vector(0, 2, 0), vp::Vector::UnitY());
+    batch.add(0, vp::Vector(0, 0, 3), vp::Vector::UnitZ());
+    batch.add(1, vp::Vector(1, 0, 0), vp::Vector::UnitX());
+    batch.add(1, vp::Vector(1, 2, 4), vp::Vector::UnitX());
+
+    Eigen::Matrix<vp::Scalar, 3, Eigen::Dynamic> x;
+    batch.solve(vp::S(0.1), x);
+    REQUIRE(x.cols() == 2);
+    REQUIRE_CLOSE_VECTOR(x.col(0), vp::Vector(1, 2, 3));
+    REQUIRE_CLOSE_VECTOR(x.col(1), vp::Vector(1, 1, 2));
+
+    vp::math::QEF q = batch.at(0);
+    REQUIRE(q.count() == 3);
+    REQUIRE_CLOSE(q.btb(), a.btb());
+    REQUIRE_CLOSE_VECTOR(q.solve(), vp::Vector(1, 2, 3));
+}
@@ -0,0 +1,131 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+#include "surface_checks.hpp"
+
+#include <volplay/volplay.h>
+#include <stdio.h>
+#include <algorithm>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+/** Read triangle surface from .OFF file. */
+static bool readOFF(const char *filename, vps::IndexedSurface &s)
+{
+    FILE *f = fopen(filename, "r");
+    if (f == 0)
+        return false;
+
+    int nv, nf, ne;
+    bool ok = fscanf(f, "OFF %d %d %d", &nv, &nf, &ne) == 3;
+    s.vertices.resize(3, nv);
+    s.faces.resize(3, nf);
+    for (int i = 0; ok && i < nv; ++i)
+        ok = fscanf(f, "%f %f %f", &s.vertices(0, i), &s.vertices(1, i), &s.vertices(2, i)) == 3;
+
+    for (int i = 0; ok && i < nf; ++i) {
+        int n;
+        ok = fscanf(f, "%d %d %d %d", &n, &s.faces(0, i), &s.faces(1, i), &s.faces(2, i)) == 4 && n == 3;
+    }
+
+    fclose(f);
+    return ok;
+}
+
+/** Sorted face centroids rounded to 0.001, independent of vertex and face order. */
+static std::vector<vp::Vector> centroids(const vps::IndexedSurface &s)
+{
+    std::vector<vp::Vector> c;
+    for (int i = 0; i < int(s.faces.cols()); ++i) {
+        const vp::Vector x = (s.vertices.col(s.faces(0, i)) + s.vertices.col(s.faces(1, i)) + s.vertices.col(s.faces(2, i))) / vp::S(3);
+        c.push_back((x * vp::S(1000)).array().round() / vp::S(1000));
+    }
+    std::sort(c.begin(), c.end(), [](const vp::Vector &a, const vp::Vector &b) {
+        return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+    });
+    return c;
+}
+
+TEST_CASE("MeshChunk IO")
+{
+    vps::MeshChunk c;
+    c.voxels.push_back(vp::Index(0, 0, 1));
+    c.voxels.push_back(vp::Index(1, 0, 1));
+    c.vertices.push_back(vp::Vector(0.5f, 0.5f, 1.5f));
+    c.vertices.push_back(vp::Vector(1.5f, 0.5f, 1.5f));
+    for (int i = 0; i < 4; ++i)
+        c.quads.push_back(vp::Index(i, 0, 1));
+
+    REQUIRE(c.write("volplay_test_chunk_io.chunk"));
+
+    vps::MeshChunk r;
+    REQUIRE(r.read("volplay_test_chunk_io.chunk"));
+    REQUIRE(r.voxels.size() == 2);
+    REQUIRE(r.vertices.size() == 2);
+    REQUIRE(r.quads.size() == 4);
+    REQUIRE(r.voxels[1] == c.voxels[1]);
+    REQUIRE(r.vertices[1].isApprox(c.vertices[1]));
+    REQUIRE(r.quads[3] == c.quads[3]);
+    REQUIRE(r.find(vp::Index(1, 0, 1)) == 1);
+    REQUIRE(r.find(vp::Index(2, 0, 1)) == -1);
+
+    REQUIRE(r.read("volplay_test_chunk_io.chunk", true));
+    REQUIRE(r.voxels.size() == 2);
+    REQUIRE(r.vertices.empty());
+
+    remove("volplay_test_chunk_io.chunk");
+}
+
+TEST_CASE("MeshChunk Chunked Dual Contouring")
+{
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .sphere().radius(1)
+            .transform().translate(vp::Vector(vp::S(0.8), 0, 0))
+                .box().halfLengths(vp::Vector::Constant(vp::S(0.5)))
+            .end()
+        .end();
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector(-2,-2,-2));
+    dc.setUpperBounds(vp::Vector(2,2,2));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.2)));
+    dc.setChunkSize(7);
+    vps::IndexedSurface reference = dc.compute(scene);
+
+    REQUIRE(dc.computeChunked(scene, "volplay_test_chunks"));
+
+    vps::ChunkManifest m;
+    REQUIRE(m.read("volplay_test_chunks"));
+    REQUIRE(m.vertexCounts.size() == 27);
+
+    REQUIRE(vps::mergeChunks("volplay_test_chunks", "volplay_test_chunks.off"));
+
+    vps::IndexedSurface merged;
+    REQUIRE(readOFF("volplay_test_chunks.off", merged));
+    REQUIRE(merged.vertices.cols() == reference.vertices.cols());
+    REQUIRE(merged.faces.cols() == reference.faces.cols());
+    REQUIRE(isClosedAndConsistent(merged));
+
+    const std::vector<vp::Vector> a = centroids(merged);
+    const std::vector<vp::Vector> b = centroids(reference);
+    for (size_t i = 0; i < a.size(); ++i) {
+        REQUIRE_CLOSE_PREC(a[i].x(), b[i].x(), vp::S(0.002));
+        REQUIRE_CLOSE_PREC(a[i].y(), b[i].y(), vp::S(0.002));
+        REQUIRE_CLOSE_PREC(a[i].z(), b[i].z(), vp::S(0.002));
+    }
+
+    for (size_t i = 0; i < m.vertexCounts.size(); ++i)
+        remove(vps::ChunkManifest::chunkFilename("volplay_test_chunks", int(i)).c_str());
+    remove("volplay_test_chunks.chunks");
+    remove("volplay_test_chunks.off");
+}
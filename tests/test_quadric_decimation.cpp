@@ -0,0 +1,67 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+#include "surface_checks.hpp"
+
+#include <volplay/volplay.h>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+TEST_CASE("QuadricDecimation Target Count")
+{
+    vp::SDFNodePtr scene = vp::make().sphere().radius(1);
+
+    vps::MarchingCubes mc;
+    mc.setLowerBounds(vp::Vector(-2,-2,-2));
+    mc.setUpperBounds(vp::Vector(2,2,2));
+    mc.setResolution(vp::Vector::Constant(vp::S(0.1)));
+    vps::IndexedSurface surface = mc.compute(scene);
+
+    vps::QuadricDecimation qd;
+    qd.setTargetFaceCount(500);
+    vps::IndexedSurface simplified = qd.compute(surface);
+
+    REQUIRE(simplified.faces.rows() == 3);
+    REQUIRE(simplified.faces.cols() <= 500);
+    REQUIRE(simplified.faces.cols() > 400);
+    REQUIRE(simplified.vertices.cols() < surface.vertices.cols());
+    REQUIRE(isClosedAndConsistent(simplified));
+
+    for (int i = 0; i < int(simplified.vertices.cols()); ++i) {
+        REQUIRE_CLOSE_PREC(simplified.vertices.col(i).norm(), vp::S(1), vp::S(0.05));
+    }
+}
+
+TEST_CASE("QuadricDecimation Max Error")
+{
+    vp::SDFNodePtr scene = vp::make().box().halfLengths(vp::Vector(vp::S(0.55), vp::S(0.55), vp::S(0.55)));
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector(-1,-1,-1));
+    dc.setUpperBounds(vp::Vector(1,1,1));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.1)));
+    vps::IndexedSurface surface = dc.compute(scene);
+
+    // Planar regions collapse without error, sharp features are kept.
+    vps::QuadricDecimation qd;
+    qd.setMaxError(vp::S(1e-6));
+    vps::IndexedSurface simplified = qd.compute(surface);
+
+    const int before = int(surface.faces.cols());
+    const int after = int(simplified.faces.cols()) * 4;
+    REQUIRE(after < before);
+
+    for (int i = 0; i < int(simplified.vertices.cols()); ++i) {
+        const vp::S d = std::abs(scene->eval(simplified.vertices.col(i)));
+        REQUIRE(d < vp::S(0.01));
+    }
+}
@@ -0,0 +1,135 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+#include <cmath>
+#include <limits>
+
+namespace vp = volplay;
+
+/** Sphere counting its evaluations. */
+class CountingSphere : public vp::SDFSphere {
+public:
+    CountingSphere(vp::Scalar radius)
+        : vp::SDFSphere(radius), evaluations(0)
+    {}
+
+    virtual vp::SDFResult fullEval(const vp::Vector &x) const
+    {
+        ++evaluations;
+        return vp::SDFSphere::fullEval(x);
+    }
+
+    virtual vp::Scalar boundedEval(const vp::Vector &x, vp::Scalar lower, vp::Scalar upper) const
+    {
+        ++evaluations;
+        return vp::SDFSphere::boundedEval(x, lower, upper);
+    }
+
+    mutable int evaluations;
+};
+
+/** Test that bounded evaluations are exact within bounds and between the SDF and the violated bound otherwise. */
+static bool respectsBounds(const vp::SDFNode &n, vp::Scalar lower, vp::Scalar upper)
+{
+    const vp::Scalar eps = vp::S(1e-4);
+    for (int i = 0; i < 7 * 7 * 7; ++i) {
+        const vp::Vector x = vp::Vector(vp::Scalar(i % 7), vp::Scalar((i / 7) % 7), vp::Scalar(i / 49)) * vp::S(0.4) - vp::Vector::Constant(vp::S(1.2));
+        const vp::Scalar d = n.eval(x);
+        const vp::Scalar b = n.boundedEval(x, lower, upper);
+
+        if (d <= lower) {
+            if (b < d - eps || b > lower + eps)
+                return false;
+        } else if (d >= upper) {
+            if (b > d + eps || b < upper - eps)
+                return false;
+        } else if (std::abs(b - d) > eps) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("SDFNode::boundedEval")
+{
+    vp::SDFNodePtr sphere = vp::make().sphere().radius(vp::S(0.5));
+    vp::SDFNodePtr box = vp::make().box().halfLengths(vp::Vector(vp::S(0.2), vp::S(0.4), vp::S(0.3)));
+    vp::SDFNodePtr plane = vp::make().plane().normal(vp::Vector(1, 2, -1).normalized());
+
+    vp::SDFNodePtr nodes[] = {
+        sphere,
+        vp::make().join().wrap().node(sphere).wrap().node(box).wrap().node(plane).end(),
+        vp::make().intersection().wrap().node(sphere).wrap().node(plane).wrap().node(box).end(),
+        vp::make().difference().wrap().node(box).wrap().node(sphere).wrap().node(plane).end(),
+        vp::make()
+            .join()
+                .intersection()
+                    .transform().translate(vp::Vector(vp::S(0.3), 0, 0)).wrap().node(sphere).end()
+                    .wrap().node(plane)
+                .end()
+                .difference()
+                    .transform().translate(vp::Vector(0, vp::S(-0.4), 0)).wrap().node(box).end()
+                    .wrap().node(sphere)
+                .end()
+            .end(),
+        vp::make().repetition().cellSizes(vp::Vector(vp::S(0.5), vp::S(0.7), std::numeric_limits<vp::Scalar>::infinity())).sphere().radius(vp::S(0.1)).end(),
+        vp::make()
+            .displacement().fnc([](const vp::Vector &x) { return vp::S(0.1) * std::sin(vp::S(4) * x.x()); }).offset(vp::S(0.1))
+                .wrap().node(box)
+            .end()
+    };
+
+    for (size_t i = 0; i < sizeof(nodes) / sizeof(nodes[0]); ++i) {
+        REQUIRE(respectsBounds(*nodes[i], vp::S(0.0001), std::numeric_limits<vp::Scalar>::infinity()));
+        REQUIRE(respectsBounds(*nodes[i], vp::S(-0.1), vp::S(0.2)));
+        REQUIRE(respectsBounds(*nodes[i], vp::S(0.3), vp::S(0.4)));
+    }
+}
+
+TEST_CASE("SDFNode::boundedEval Early Out")
+{
+    std::shared_ptr<CountingSphere> near = std::make_shared<CountingSphere>(vp::S(1));
+    std::shared_ptr<CountingSphere> far = std::make_shared<CountingSphere>(vp::S(1));
+    std::shared_ptr<CountingSphere> cut = std::make_shared<CountingSphere>(vp::S(1));
+
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .wrap().node(near)
+            .intersection()
+                .transform().translate(vp::Vector(5, 0, 0)).wrap().node(far).end()
+                .transform().translate(vp::Vector(5, 1, 0)).wrap().node(cut).end()
+            .end()
+        .end();
+
+    // Intersection stops once a child exceeds the closest distance so far.
+    vp::Scalar d = scene->boundedEval(vp::Vector(-2, 0, 0), vp::S(0.0001), std::numeric_limits<vp::Scalar>::infinity());
+    REQUIRE_CLOSE(d, vp::S(1));
+    REQUIRE(near->evaluations == 1);
+    REQUIRE(far->evaluations == 1);
+    REQUIRE(cut->evaluations == 0);
+
+    // Union stops once a child is below the lower bound.
+    d = scene->boundedEval(vp::Vector(0, 0, 0), vp::S(0.0001), std::numeric_limits<vp::Scalar>::infinity());
+    REQUIRE(d <= vp::S(0.0001));
+    REQUIRE(near->evaluations == 2);
+    REQUIRE(far->evaluations == 1);
+    REQUIRE(cut->evaluations == 0);
+
+    // Tracing reports the same results as before.
+    vp::SDFNode::TraceResult tr;
+    scene->trace(vp::Vector(-5, vp::S(0.5), 0), vp::Vector::UnitX(), vp::SDFNode::TraceOptions(), &tr);
+    REQUIRE(tr.hit);
+    REQUIRE(tr.node == near.get());
+    REQUIRE_CLOSE(tr.t, vp::S(5) - std::sqrt(vp::S(0.75)));
+    REQUIRE(cut->evaluations < far->evaluations);
+}
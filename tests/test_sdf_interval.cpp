@@ -0,0 +1,155 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+#include <cmath>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+/** Test that the interval over boxes of a lattice contains samples of the SDF in the box. */
+static bool boundsSamples(const vp::SDFNode &n, vp::Scalar boxSize)
+{
+    const vp::Scalar eps = vp::S(1e-4);
+    for (int i = 0; i < 5 * 5 * 5; ++i) {
+        const vp::Vector c = vp::Vector(vp::Scalar(i % 5), vp::Scalar((i / 5) % 5), vp::Scalar(i / 25)) * vp::S(0.37) - vp::Vector::Constant(vp::S(0.8));
+        const vp::AlignedBox box(c, c + vp::Vector::Constant(boxSize));
+        const vp::math::Interval r = n.evalInterval(box);
+
+        for (int j = 0; j < 4 * 4 * 4; ++j) {
+            const vp::Vector t = vp::Vector(vp::Scalar(j % 4), vp::Scalar((j / 4) % 4), vp::Scalar(j / 16)) / vp::S(3);
+            const vp::Scalar d = n.eval(c + t * boxSize);
+            if (d < r.lower - eps || d > r.upper + eps)
+                return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("SDFNode::evalInterval")
+{
+    vp::SDFNodePtr sphere = vp::make().sphere().radius(vp::S(0.5));
+    vp::SDFNodePtr box = vp::make().box().halfLengths(vp::Vector(vp::S(0.2), vp::S(0.4), vp::S(0.3)));
+    vp::SDFNodePtr plane = vp::make().plane().normal(vp::Vector(1, 2, -1).normalized());
+
+    vp::SDFNodePtr nodes[] = {
+        sphere, box, plane,
+        vp::make().join().wrap().node(sphere).wrap().node(box).end(),
+        vp::make().intersection().wrap().node(sphere).wrap().node(plane).end(),
+        vp::make().difference().wrap().node(box).wrap().node(sphere).end(),
+        vp::make()
+            .transform()
+                .translate(vp::Vector(vp::S(0.1), vp::S(-0.2), vp::S(0.3)))
+                .rotate(Eigen::AngleAxis<vp::Scalar>(vp::S(0.7), vp::Vector(1, 1, 0).normalized()))
+                .wrap().node(box)
+            .end(),
+        vp::make().repetition().cellSizes(vp::Vector(vp::S(0.5), vp::S(0.7), std::numeric_limits<vp::Scalar>::infinity())).sphere().radius(vp::S(0.1)).end(),
+        vp::make().displacement().offset(vp::S(0.1)).wrap().node(box).end()
+    };
+
+    for (size_t i = 0; i < sizeof(nodes) / sizeof(nodes[0]); ++i) {
+        REQUIRE(boundsSamples(*nodes[i], vp::S(0.05)));
+        REQUIRE(boundsSamples(*nodes[i], vp::S(0.3)));
+        REQUIRE(boundsSamples(*nodes[i], vp::S(1.2)));
+    }
+
+    // Primitives are exact.
+    vp::math::Interval r = sphere->evalInterval(vp::AlignedBox(vp::Vector(1, 0, 0), vp::Vector(2, 1, 1)));
+    REQUIRE_CLOSE(r.lower, vp::S(0.5));
+    REQUIRE_CLOSE(r.upper, std::sqrt(vp::S(6)) - vp::S(0.5));
+
+    r = box->evalInterval(vp::AlignedBox(vp::Vector(-0.1f, -0.1f, -0.1f), vp::Vector(0.1f, 0.1f, 0.1f)));
+    REQUIRE_CLOSE(r.lower, vp::S(-0.2));
+    REQUIRE_CLOSE(r.upper, vp::S(-0.1));
+
+    // Displacement functions cannot be bounded.
+    vp::SDFNodePtr displaced = vp::make().displacement().fnc([](const vp::Vector &x) { return std::sin(x.x()); }).wrap().node(sphere).end();
+    r = displaced->evalInterval(vp::AlignedBox(vp::Vector(2, 2, 2), vp::Vector(3, 3, 3)));
+    REQUIRE(r.contains(-1000));
+    REQUIRE(r.contains(1000));
+}
+
+TEST_CASE("DualContouring Interval Pruning")
+{
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .sphere().radius(vp::S(0.6))
+            .transform().translate(vp::Vector(vp::S(0.7), 0, 0))
+                .box().halfLengths(vp::Vector::Constant(vp::S(0.3)))
+            .end()
+        .end();
+
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector::Constant(-2));
+    dc.setUpperBounds(vp::Vector::Constant(2));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.05)));
+
+    const vps::IndexedSurface full = dc.compute(scene);
+    const vps::DualContouring::Statistics sf = dc.statistics();
+
+    dc.setIntervalPruningEnabled(true);
+    const vps::IndexedSurface pruned = dc.compute(scene);
+    const vps::DualContouring::Statistics sp = dc.statistics();
+
+    // Same surface from a fraction of samples.
+    REQUIRE(pruned.vertices.cols() == full.vertices.cols());
+    REQUIRE(pruned.faces.cols() == full.faces.cols());
+    REQUIRE(pruned.vertices.isApprox(full.vertices));
+    REQUIRE(pruned.faces == full.faces);
+    REQUIRE(sp.intervalEvaluations > 0);
+    REQUIRE(sp.crossingEdges == sf.crossingEdges);
+    REQUIRE(sp.cornerEvaluations < sf.cornerEvaluations / 2);
+
+    // Levels other than zero.
+    std::vector<vp::Scalar> levels;
+    levels.push_back(vp::S(-0.2));
+    levels.push_back(vp::S(0.3));
+
+    dc.setIntervalPruningEnabled(false);
+    const std::vector<vps::IndexedSurface> fullShells = dc.computeIsoLevels(scene, levels);
+    dc.setIntervalPruningEnabled(true);
+    const std::vector<vps::IndexedSurface> prunedShells = dc.computeIsoLevels(scene, levels);
+    for (size_t l = 0; l < levels.size(); ++l) {
+        REQUIRE(prunedShells[l].faces.cols() == fullShells[l].faces.cols());
+        REQUIRE(prunedShells[l].vertices.isApprox(fullShells[l].vertices));
+    }
+}
+
+TEST_CASE("SDFNode Interval Tracing")
+{
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .plane().normal(vp::Vector::UnitY())
+            .transform().translate(vp::Vector(5, vp::S(0.5), 0))
+                .sphere().radius(vp::S(0.5))
+            .end()
+        .end();
+
+    // Ray grazing the plane until it hits the sphere.
+    const vp::Vector o(0, vp::S(0.05), 0);
+    const vp::Vector d = vp::Vector(1, vp::S(0.005), 0).normalized();
+
+    vp::SDFNode::TraceOptions opts;
+    opts.maxT = 20;
+
+    vp::SDFNode::TraceResult plain;
+    scene->trace(o, d, opts, &plain);
+
+    opts.intervalLength = vp::S(0.5);
+    vp::SDFNode::TraceResult skipped;
+    scene->trace(o, d, opts, &skipped);
+
+    REQUIRE(plain.hit);
+    REQUIRE(skipped.hit);
+    REQUIRE_CLOSE_PREC(skipped.t, plain.t, vp::S(1e-3));
+    REQUIRE(skipped.iter < plain.iter / 2);
+}
@@ -0,0 +1,281 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+#include <algorithm>
+#include <cmath>
+
+namespace vp = volplay;
+
+static int evaluations = 0;
+
+template<class Base>
+class Counting : public Base {
+public:
+    template<class Arg>
+    Counting(const Arg &arg)
+        : Base(arg)
+    {}
+
+    virtual vp::SDFResult fullEval(const vp::Vector &x) const
+    {
+        ++evaluations;
+        return Base::fullEval(x);
+    }
+
+    virtual vp::Scalar boundedEval(const vp::Vector &x, vp::Scalar lower, vp::Scalar upper) const
+    {
+        ++evaluations;
+        return Base::boundedEval(x, lower, upper);
+    }
+};
+
+TEST_CASE("SDFNode::lipschitz")
+{
+    vp::SDFNodePtr sphere = vp::make().sphere().radius(vp::S(0.5));
+    REQUIRE(sphere->lipschitz() == vp::S(1));
+
+    vp::SDFNodePtr rigid = vp::make()
+        .join()
+            .transform()
+                .translate(vp::Vector(1, 2, 3))
+                .rotate(Eigen::AngleAxis<vp::Scalar>(vp::S(0.7), vp::Vector(1, 1, 0).normalized()))
+                .wrap().node(sphere)
+            .end()
+            .box()
+        .end();
+    REQUIRE(rigid->lipschitz() == vp::S(1));
+
+    // Shrinking by a factor of two doubles the rate of change.
+    vp::SDFNodePtr scaled = vp::make().transform().transform(vp::AffineTransform(Eigen::Scaling(vp::S(0.5)))).wrap().node(sphere).end();
+    REQUIRE_CLOSE(scaled->lipschitz(), vp::S(2));
+    REQUIRE_CLOSE(scaled->safeEval(vp::Vector(1, 0, 0)), vp::S(0.75));
+
+    vp::SDFNodePtr displaced = vp::make()
+        .displacement().fnc([](const vp::Vector &x) { return vp::S(0.3) * std::sin(vp::S(8) * x.x()); }, vp::S(2.4))
+            .wrap().node(sphere)
+        .end();
+    REQUIRE_CLOSE(displaced->lipschitz(), vp::S(3.4));
+
+    vp::SDFNodePtr offset = vp::make().displacement().offset(vp::S(0.1)).wrap().node(sphere).end();
+    REQUIRE(offset->lipschitz() == vp::S(1));
+
+    // Functions without a declared bound do not scale steps.
+    vp::SDFNodePtr undeclared = vp::make()
+        .displacement().fnc([](const vp::Vector &x) { return vp::S(0.05) * std::sin(x.x()); })
+            .wrap().node(sphere)
+        .end();
+    REQUIRE(undeclared->lipschitz() == vp::S(1));
+
+    // Groups scale each subtree by its own bound.
+    vp::SDFNodePtr scene = std::make_shared<vp::SDFUnion>(displaced, scaled);
+    REQUIRE_CLOSE(scene->lipschitz(), vp::S(3.4));
+    for (int i = 0; i < 10; ++i) {
+        const vp::Vector x = vp::Vector::Random() * vp::S(2);
+        const vp::Scalar expected = std::min(displaced->eval(x) / vp::S(3.4), scaled->eval(x) / vp::S(2));
+        REQUIRE_CLOSE(scene->safeEval(x), expected);
+    }
+}
+
+TEST_CASE("SDFNode Lipschitz Tracing")
+{
+    // A strongly displaced sphere overestimates distances by up to a factor of 3.4.
+    vp::SDFNodePtr displaced = vp::make()
+        .displacement().fnc([](const vp::Vector &x) { return vp::S(0.3) * std::sin(vp::S(8) * x.x()); }, vp::S(2.4))
+            .sphere().radius(1)
+        .end();
+
+    vp::SDFNode::TraceOptions opts;
+    opts.maxIter = 1000;
+
+    int hits = 0;
+    for (int i = 0; i < 50; ++i) {
+        const vp::Vector o(-4, vp::S(-0.9) + vp::S(0.036) * vp::Scalar(i), 0);
+        const vp::Vector d = vp::Vector(1, 0, vp::S(0.01)).normalized();
+
+        vp::SDFNode::TraceResult tr;
+        displaced->trace(o, d, opts, &tr);
+        if (!tr.hit)
+            continue;
+        ++hits;
+
+        // No surface is skipped along the ray.
+        const vp::Scalar abssdf = std::abs(displaced->safeEval(o + tr.t * d));
+        REQUIRE(abssdf < opts.sdfThreshold);
+        REQUIRE(tr.node != 0);
+        bool crossed = false;
+        for (vp::Scalar t = 0; t < tr.t - opts.sdfThreshold; t += vp::S(0.001))
+            crossed |= displaced->eval(o + t * d) < 0;
+        REQUIRE(!crossed);
+    }
+    REQUIRE(hits > 40);
+
+    // 1-Lipschitz scenes trace as before.
+    vp::SDFNodePtr scene = vp::make().join().sphere().radius(1).transform().translate(vp::Vector(3, 0, 0)).box().end().end();
+    vp::SDFNode::TraceResult tr;
+    scene->trace(vp::Vector(-5, vp::S(0.2), 0), vp::Vector::UnitX(), opts, &tr);
+    REQUIRE(tr.hit);
+    REQUIRE(tr.node != 0);
+    REQUIRE_CLOSE(tr.t, vp::S(5) - std::sqrt(vp::S(1) - vp::S(0.04)));
+    REQUIRE(tr.iter < 10);
+}
+
+TEST_CASE("SDFNode::segmentLipschitz")
+{
+    vp::SDFNodePtr plane = vp::make().plane().normal(vp::Vector::UnitY());
+    const vp::Scalar lp = plane->segmentLipschitz(vp::Vector(0, 1, 0), vp::Vector(10, 0, 0));
+    REQUIRE_CLOSE(lp, vp::S(1) / std::sqrt(vp::S(101)));
+
+    // Passing the sphere sideways changes the distance slowest at the closest point.
+    vp::SDFNodePtr sphere = vp::make().sphere().radius(1);
+    vp::Scalar ls = sphere->segmentLipschitz(vp::Vector(-1, 2, 0), vp::Vector(1, 2, 0));
+    REQUIRE_CLOSE(ls, vp::S(1) / std::sqrt(vp::S(5)));
+    ls = sphere->segmentLipschitz(vp::Vector(-3, 2, 0), vp::Vector(1, 2, 0));
+    REQUIRE_CLOSE(ls, vp::S(3) / std::sqrt(vp::S(13)));
+
+    vp::SDFNodePtr scaled = vp::make().transform().transform(vp::AffineTransform(Eigen::Scaling(vp::S(0.5)))).wrap().node(plane).end();
+    const vp::Scalar lt = scaled->segmentLipschitz(vp::Vector(0, 1, 0), vp::Vector(10, 0, 0));
+    REQUIRE_CLOSE(lt, vp::S(2) / std::sqrt(vp::S(101)));
+
+    vp::SDFNodePtr scene = std::make_shared<vp::SDFUnion>(plane, sphere);
+    const vp::Scalar lu = scene->segmentLipschitz(vp::Vector(-1, 2, 0), vp::Vector(1, 2, 0));
+    REQUIRE_CLOSE(lu, vp::S(1) / std::sqrt(vp::S(5)));
+
+    // Bounds hold for samples along random segments.
+    vp::SDFNodePtr displaced = vp::make()
+        .join()
+            .displacement().fnc([](const vp::Vector &x) { return vp::S(0.3) * std::sin(vp::S(8) * x.x()); }, vp::S(2.4))
+                .sphere().radius(1)
+            .end()
+            .transform().translate(vp::Vector(1, 2, 3)).rotate(Eigen::AngleAxis<vp::Scalar>(vp::S(0.7), vp::Vector::UnitZ()))
+                .box().halfLengths(vp::Vector(1, vp::S(0.5), vp::S(0.2)))
+            .end()
+            .plane().normal(vp::Vector(1, 1, 0).normalized())
+        .end();
+    for (int i = 0; i < 100; ++i) {
+        const vp::Vector a = vp::Vector::Random() * vp::S(3);
+        const vp::Vector b = a + vp::Vector::Random();
+        const vp::Scalar l = displaced->segmentLipschitz(a, b);
+        for (int j = 0; j < 10; ++j) {
+            const vp::Vector x = a + (b - a) * (vp::Scalar(j) / 10);
+            const vp::Vector y = a + (b - a) * (vp::Scalar(j + 1) / 10);
+            const vp::Scalar change = std::abs(displaced->eval(y) - displaced->eval(x));
+            REQUIRE(change <= l * (y - x).norm() + vp::S(1e-4));
+        }
+    }
+}
+
+TEST_CASE("SDFNode Segment Tracing")
+{
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .plane().normal(vp::Vector::UnitY())
+            .transform().translate(vp::Vector(5, vp::S(0.5), 0))
+                .sphere().radius(vp::S(0.5))
+            .end()
+        .end();
+
+    vp::SDFNode::TraceOptions opts;
+    opts.maxT = 200;
+    opts.maxIter = 5000;
+
+    vp::SDFNode::TraceOptions segmentOpts = opts;
+    segmentOpts.method = vp::SDFNode::SEGMENT_TRACING;
+
+    int sphereIter = 0;
+    int segmentIter = 0;
+    for (int i = 0; i < 20; ++i) {
+        // Rays grazing the plane, some of which hit the sphere.
+        const vp::Vector o(0, vp::S(0.2), 0);
+        const vp::Vector d = vp::Vector(1, vp::S(-0.002) - vp::S(0.001) * vp::Scalar(i), vp::S(0.01) * vp::Scalar(i - 10)).normalized();
+
+        vp::SDFNode::TraceResult plain, segments;
+        scene->trace(o, d, opts, &plain);
+        scene->trace(o, d, segmentOpts, &segments);
+
+        REQUIRE(plain.hit);
+        REQUIRE(segments.hit);
+        REQUIRE(segments.node == plain.node);
+        // Hits are located up to the threshold, which grazing rays travel a long way through.
+        REQUIRE_CLOSE_PREC(segments.t, plain.t, opts.sdfThreshold / std::abs(d.y()));
+        sphereIter += plain.iter;
+        segmentIter += segments.iter;
+    }
+    REQUIRE(segmentIter < sphereIter / 2);
+
+    // Strongly displaced surfaces are not skipped.
+    vp::SDFNodePtr displaced = vp::make()
+        .displacement().fnc([](const vp::Vector &x) { return vp::S(0.3) * std::sin(vp::S(8) * x.x()); }, vp::S(2.4))
+            .sphere().radius(1)
+        .end();
+    for (int i = 0; i < 50; ++i) {
+        const vp::Vector o(-4, vp::S(-0.9) + vp::S(0.036) * vp::Scalar(i), 0);
+        const vp::Vector d = vp::Vector(1, 0, vp::S(0.01)).normalized();
+
+        vp::SDFNode::TraceResult tr;
+        displaced->trace(o, d, segmentOpts, &tr);
+        if (!tr.hit)
+            continue;
+
+        bool crossed = false;
+        for (vp::Scalar t = 0; t < tr.t - segmentOpts.sdfThreshold; t += vp::S(0.001))
+            crossed |= displaced->eval(o + t * d) < 0;
+        REQUIRE(!crossed);
+    }
+}
+
+TEST_CASE("SDFNode Segment Tracing Evaluations")
+{
+    // Rows of spheres in nested unions above a plane.
+    vp::SDFUnionPtr spheres = std::make_shared<vp::SDFUnion>();
+    for (int i = 0; i < 4; ++i) {
+        vp::SDFUnionPtr row = std::make_shared<vp::SDFUnion>();
+        for (int j = 0; j < 4; ++j) {
+            row->add(vp::make()
+                .transform().translate(vp::Vector(vp::S(5 + 3 * i), vp::S(0.5), vp::S(-4.5 + 3 * j)))
+                    .wrap().node(std::make_shared< Counting<vp::SDFSphere> >(vp::S(0.5)))
+                .end());
+        }
+        spheres->add(row);
+    }
+    vp::SDFNodePtr scene = std::make_shared<vp::SDFUnion>(std::make_shared< Counting<vp::SDFPlane> >(vp::Vector::UnitY()), spheres);
+
+    vp::SDFNode::TraceOptions opts;
+    opts.maxT = 200;
+    opts.maxIter = 5000;
+
+    vp::SDFNode::TraceOptions segmentOpts = opts;
+    segmentOpts.method = vp::SDFNode::SEGMENT_TRACING;
+
+    int sphereEvals = 0;
+    int segmentEvals = 0;
+    for (int i = 0; i < 20; ++i) {
+        const vp::Vector o(0, vp::S(0.2), 0);
+        const vp::Vector d = vp::Vector(1, vp::S(-0.002) - vp::S(0.001) * vp::Scalar(i), vp::S(0.01) * vp::Scalar(i - 10)).normalized();
+
+        vp::SDFNode::TraceResult plain, segments;
+        evaluations = 0;
+        scene->trace(o, d, opts, &plain);
+        sphereEvals += evaluations;
+
+        evaluations = 0;
+        scene->trace(o, d, segmentOpts, &segments);
+        segmentEvals += evaluations;
+
+        REQUIRE(segments.hit == plain.hit);
+        REQUIRE(segments.node == plain.node);
+    }
+
+    // Bounding the rate of change along segments evaluates children, which must not cost more 
+    // than the steps saved.
+    REQUIRE(segmentEvals < sphereEvals / 2);
+}
@@ -0,0 +1,96 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+#include <stdio.h>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+/** Unit cube centered at origin with outward facing quads. */
+static vps::IndexedSurface unitCube()
+{
+    vps::IndexedSurface s;
+    s.vertices.resize(3, 8);
+    for (int i = 0; i < 8; ++i)
+        s.vertices.col(i) = vp::Vector(vp::S(i & 1), vp::S((i >> 1) & 1), vp::S((i >> 2) & 1)) - vp::Vector::Constant(vp::S(0.5));
+
+    s.faces.resize(4, 6);
+    s.faces.col(0) << 0, 2, 3, 1; // -z
+    s.faces.col(1) << 4, 5, 7, 6; // +z
+    s.faces.col(2) << 0, 1, 5, 4; // -y
+    s.faces.col(3) << 2, 6, 7, 3; // +y
+    s.faces.col(4) << 0, 4, 6, 2; // -x
+    s.faces.col(5) << 1, 3, 7, 5; // +x
+    return s;
+}
+
+TEST_CASE("SDFMesh")
+{
+    // Round trip through OFF, quads are imported as triangles.
+    vps::OFFExport().exportSurface("volplay_test_cube.off", unitCube());
+    vps::IndexedSurface s;
+    REQUIRE(vps::OFFImport().importSurface("volplay_test_cube.off", s));
+    REQUIRE(s.vertices.cols() == 8);
+    REQUIRE(s.faces.rows() == 3);
+    REQUIRE(s.faces.cols() == 12);
+    remove("volplay_test_cube.off");
+    REQUIRE(!vps::OFFImport().importSurface("volplay_test_cube.off", s));
+    REQUIRE(s.faces.cols() == 12);
+
+    vp::SDFMeshPtr mesh = std::make_shared<vp::SDFMesh>(s, 1);
+    vp::SDFBox box;
+
+    REQUIRE(mesh->lowerBounds().isApprox(vp::Vector::Constant(vp::S(-0.5))));
+    REQUIRE(mesh->upperBounds().isApprox(vp::Vector::Constant(vp::S(0.5))));
+
+    // Distances match the analytic box inside and outside, including closest points
+    // on vertices and edges.
+    std::vector<vp::Vector> points;
+    for (int z = -4; z <= 4; ++z)
+        for (int y = -4; y <= 4; ++y)
+            for (int x = -4; x <= 4; ++x)
+                points.push_back(vp::Vector(vp::S(x), vp::S(y), vp::S(z)) * vp::S(0.23) + vp::Vector(vp::S(0.011), vp::S(-0.007), vp::S(0.003)));
+
+    for (size_t i = 0; i < points.size(); ++i)
+        REQUIRE_CLOSE_PREC(mesh->eval(points[i]), box.eval(points[i]), vp::S(0.0001));
+
+    int t;
+    REQUIRE(mesh->closestPoint(vp::Vector(2, 0.1f, 0.2f), &t).isApprox(vp::Vector(0.5f, 0.1f, 0.2f)));
+    REQUIRE(t >= 0);
+    REQUIRE(t < 12);
+
+    // Batched and baked queries agree with single queries.
+    std::vector<vp::Scalar> sdf;
+    mesh->evalBatch(points, sdf);
+    REQUIRE(sdf.size() == points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+        REQUIRE(sdf[i] == mesh->eval(points[i]));
+
+    const vp::Index dims(5, 4, 3);
+    const vp::Vector origin(-1, -0.8f, -0.6f);
+    const vp::Vector spacing(0.5f, 0.4f, 0.3f);
+    std::vector<float> samples = mesh->bake(origin, dims, spacing);
+    REQUIRE(samples.size() == 60);
+    REQUIRE(samples[(2 * dims.y() + 3) * dims.x() + 1] == mesh->eval(origin + vp::Vector(1, 3, 2).cwiseProduct(spacing)));
+    REQUIRE(samples[0] == mesh->eval(origin));
+
+    // Meshes participate in CSG.
+    vp::SDFNodePtr scene = vp::make()
+        .difference()
+            .wrap().node(mesh)
+            .sphere().radius(vp::S(0.4))
+        .end();
+
+    REQUIRE_CLOSE(scene->eval(vp::Vector(0, 0, 0)), vp::S(0.4));
+    REQUIRE_CLOSE(scene->eval(vp::Vector(0.45f, 0.45f, 0.45f)), vp::S(-0.05));
+}
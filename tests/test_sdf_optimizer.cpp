@@ -0,0 +1,173 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+#include <volplay/volplay.h>
+
+namespace vp = volplay;
+
+void requireSameSDF(const vp::SDFNodePtr &a, const vp::SDFNodePtr &b)
+{
+    for (vp::S z = -3; z <= 3; z += vp::S(0.5)) {
+        for (vp::S y = -3; y <= 3; y += vp::S(0.5)) {
+            for (vp::S x = -3; x <= 3; x += vp::S(0.5)) {
+                REQUIRE_CLOSE(a->eval(vp::Vector(x, y, z)), b->eval(vp::Vector(x, y, z)));
+            }
+        }
+    }
+}
+
+TEST_CASE("SDFOptimizer-Transforms")
+{
+    auto build = []() -> vp::SDFNodePtr {
+        vp::AffineTransform t1 = vp::AffineTransform::Identity();
+        t1.translate(vp::Vector(1, 0, 0));
+        vp::AffineTransform t2 = vp::AffineTransform::Identity();
+        t2.rotate(Eigen::AngleAxisf(vp::S(0.5), vp::Vector::UnitZ()));
+        vp::AffineTransform t3 = vp::AffineTransform::Identity();
+        t3.translate(vp::Vector(0, 1, 0));
+
+        return std::make_shared<vp::SDFRigidTransform>(t1,
+            std::make_shared<vp::SDFRigidTransform>(t2,
+                std::make_shared<vp::SDFRigidTransform>(vp::AffineTransform::Identity(),
+                    std::make_shared<vp::SDFRigidTransform>(t3, std::make_shared<vp::SDFBox>()))));
+    };
+
+    vp::SDFNodePtr ref = build();
+    vp::SDFNodePtr opt = vp::SDFOptimizer().optimize(build());
+
+    vp::SDFRigidTransformPtr t = std::dynamic_pointer_cast<vp::SDFRigidTransform>(opt);
+    REQUIRE(t);
+    REQUIRE(t->size() == 1);
+    REQUIRE(std::dynamic_pointer_cast<vp::SDFBox>(*t->begin()));
+
+    requireSameSDF(ref, opt);
+}
+
+TEST_CASE("SDFOptimizer-Flatten")
+{
+    vp::SDFNodePtr sphere;
+    auto build = [&sphere]() -> vp::SDFNodePtr {
+        return vp::make()
+            .join()
+                .join()
+                    .sphere().radius(vp::S(0.8)).storeNodePtr(&sphere)
+                    .join()
+                        .box()
+                    .end()
+                .end()
+                .transform()
+                    .plane()
+                    .transform().translate(vp::Vector(2, 0, 0))
+                        .sphere()
+                    .end()
+                .end()
+                .difference()
+                    .difference()
+                        .box().lengths(vp::Vector(3, 3, 3))
+                        .sphere().radius(2)
+                    .end()
+                    .join()
+                        .plane()
+                        .sphere()
+                    .end()
+                .end()
+            .end();
+    };
+
+    vp::SDFNodePtr ref = build();
+    vp::SDFNodePtr opt = vp::SDFOptimizer().optimize(build());
+
+    vp::SDFUnionPtr u = std::dynamic_pointer_cast<vp::SDFUnion>(opt);
+    REQUIRE(u);
+    REQUIRE(u->size() == 5);
+
+    vp::SDFDifferencePtr d;
+    for (auto iter = u->begin(); iter != u->end(); ++iter) {
+        if (!d)
+            d = std::dynamic_pointer_cast<vp::SDFDifference>(*iter);
+    }
+    REQUIRE(d);
+    REQUIRE(d->size() == 4);
+    REQUIRE(std::dynamic_pointer_cast<vp::SDFBox>(*d->begin()));
+
+    requireSameSDF(ref, opt);
+
+    // Leaves are kept, so node identity is preserved.
+    REQUIRE(opt->fullEval(vp::Vector(0, 0, 0)).node == sphere.get());
+}
+
+TEST_CASE("SDFOptimizer-Displacements")
+{
+    auto build = []() -> vp::SDFNodePtr {
+        return vp::make()
+            .displacement().offset(vp::S(0.25))
+                .displacement().offset(vp::S(0.5))
+                    .displacement()
+                        .displacement().fnc([](const vp::Vector &x) { return x.x() * vp::S(0.1); })
+                            .sphere()
+                        .end()
+                    .end()
+                .end()
+            .end();
+    };
+
+    vp::SDFNodePtr ref = build();
+    vp::SDFNodePtr opt = vp::SDFOptimizer().optimize(build());
+
+    vp::SDFDisplacementPtr d = std::dynamic_pointer_cast<vp::SDFDisplacement>(opt);
+    REQUIRE(d);
+    REQUIRE(d->size() == 1);
+    REQUIRE(d->displacementFunction());
+    REQUIRE_CLOSE(d->offset(), vp::S(0.75));
+    REQUIRE(std::dynamic_pointer_cast<vp::SDFSphere>(*d->begin()));
+
+    requireSameSDF(ref, opt);
+}
+
+TEST_CASE("SDFOptimizer-Attachments")
+{
+    vp::SDFNodeAttachmentPtr a(new vp::SDFNodeAttachment());
+
+    vp::SDFNodePtr opt = vp::SDFOptimizer().optimize(vp::make()
+        .join()
+            .join().attach("Material", a)
+                .sphere()
+                .box()
+            .end()
+            .transform().attach("Material", a)
+                .sphere()
+            .end()
+        .end());
+
+    vp::SDFUnionPtr u = std::dynamic_pointer_cast<vp::SDFUnion>(opt);
+    REQUIRE(u);
+    REQUIRE(u->size() == 2);
+    for (auto iter = u->begin(); iter != u->end(); ++iter) {
+        REQUIRE((*iter)->attachment<vp::SDFNodeAttachment>("Material") == a);
+    }
+}
+
+TEST_CASE("SDFOptimizer-ReorderByCost")
+{
+    vp::SDFNodePtr opt = vp::SDFOptimizer().optimize(vp::make()
+        .join()
+            .intersection()
+                .sphere()
+                .box()
+            .end()
+            .sphere()
+        .end());
+
+    vp::SDFUnionPtr u = std::dynamic_pointer_cast<vp::SDFUnion>(opt);
+    REQUIRE(u);
+    REQUIRE(std::dynamic_pointer_cast<vp::SDFSphere>(*u->begin()));
+    REQUIRE(vp::SDFOptimizer::estimateCost(u.get()) == vp::S(5));
+}
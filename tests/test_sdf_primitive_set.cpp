@@ -0,0 +1,153 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace vp = volplay;
+
+/** Test that the set agrees with a union of individual nodes, including the closest element. */
+static bool agreesWithUnion(const vp::SDFPrimitiveSet &set, const std::vector<vp::SDFNodePtr> &nodes)
+{
+    for (int i = 0; i < 500; ++i) {
+        const vp::Vector x = vp::Vector::Random() * vp::S(3);
+
+        vp::SDFResult expected = {0, std::numeric_limits<vp::Scalar>::max()};
+        for (size_t k = 0; k < nodes.size(); ++k) {
+            const vp::Scalar d = nodes[k]->eval(x);
+            if (d < expected.sdf) {
+                expected.sdf = d;
+                expected.element = int(k);
+            }
+        }
+
+        const vp::SDFResult r = set.fullEval(x);
+        if (r.node != &set || std::abs(r.sdf - expected.sdf) > vp::S(1e-4))
+            return false;
+        // Ties may report either element.
+        if (r.element != expected.element && std::abs(nodes[r.element]->eval(x) - expected.sdf) > vp::S(1e-4))
+            return false;
+
+        const vp::Scalar b = set.boundedEval(x, vp::S(0.0001), vp::S(0.5));
+        if (expected.sdf <= vp::S(0.0001)) {
+            if (b < expected.sdf - vp::S(1e-4) || b > vp::S(0.0001) + vp::S(1e-4))
+                return false;
+        } else if (expected.sdf >= vp::S(0.5)) {
+            if (b < vp::S(0.5) - vp::S(1e-4))
+                return false;
+        } else if (std::abs(b - expected.sdf) > vp::S(1e-4)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("SDFSphereSet")
+{
+    std::vector<vp::Vector> centers;
+    std::vector<vp::Scalar> radii;
+    std::vector<vp::SDFNodePtr> nodes;
+    for (int i = 0; i < 200; ++i) {
+        centers.push_back(vp::Vector::Random() * vp::S(2));
+        radii.push_back(vp::S(0.05) + vp::S(0.1) * std::abs(vp::Vector::Random().x()));
+        nodes.push_back(vp::make().transform().translate(centers.back()).sphere().radius(radii.back()).end());
+    }
+
+    vp::SDFSphereSet set(centers, radii);
+    REQUIRE(set.size() == 200);
+    REQUIRE(agreesWithUnion(set, nodes));
+
+    // Parameters are reported in order of construction.
+    for (int i = 0; i < set.size(); ++i) {
+        REQUIRE(set.center(i).isApprox(centers[i]));
+        REQUIRE(set.radius(i) == radii[i]);
+    }
+
+    // Leaf sizes do not change results.
+    vp::SDFSphereSet single(centers, radii, 1);
+    REQUIRE(agreesWithUnion(single, nodes));
+    vp::SDFSphereSet large(centers, radii, 1000);
+    REQUIRE(agreesWithUnion(large, nodes));
+
+    // Traced hits report the element hit.
+    vp::SDFNode::TraceResult tr;
+    set.trace(centers[7] + vp::Vector(-10, 0, 0), vp::Vector::UnitX(), vp::SDFNode::TraceOptions(), &tr);
+    REQUIRE(tr.hit);
+    REQUIRE(tr.node == &set);
+    const vp::Scalar hitSdf = nodes[tr.element]->eval(centers[7] + vp::Vector(-10 + tr.t, 0, 0));
+    REQUIRE(std::abs(hitSdf) < vp::S(0.001));
+}
+
+TEST_CASE("SDFBoxSet")
+{
+    std::vector<vp::Vector> centers;
+    std::vector<vp::Vector> halfLengths;
+    std::vector<vp::SDFNodePtr> nodes;
+    for (int i = 0; i < 200; ++i) {
+        centers.push_back(vp::Vector::Random() * vp::S(2));
+        halfLengths.push_back(vp::Vector::Constant(vp::S(0.05)) + vp::Vector::Random().cwiseAbs() * vp::S(0.1));
+        nodes.push_back(vp::make().transform().translate(centers.back()).box().halfLengths(halfLengths.back()).end());
+    }
+
+    vp::SDFBoxSet set(centers, halfLengths);
+    REQUIRE(set.size() == 200);
+    REQUIRE(agreesWithUnion(set, nodes));
+    REQUIRE(set.halfLengths(3).isApprox(halfLengths[3]));
+}
+
+TEST_CASE("SDFCapsuleSet")
+{
+    std::vector<vp::Vector> a, b;
+    std::vector<vp::Scalar> radii;
+    for (int i = 0; i < 200; ++i) {
+        a.push_back(vp::Vector::Random() * vp::S(2));
+        b.push_back(a.back() + vp::Vector::Random() * vp::S(0.3));
+        radii.push_back(vp::S(0.05));
+    }
+    // Degenerate capsule.
+    b[0] = a[0];
+    // Isolated capsule.
+    a.push_back(vp::Vector(10, 0, 0));
+    b.push_back(vp::Vector(10, 1, 0));
+    radii.push_back(vp::S(0.1));
+
+    vp::SDFCapsuleSet set(a, b, radii);
+    REQUIRE(set.b(5).isApprox(b[5]));
+
+    // Compare against brute force distances to the segments.
+    for (int i = 0; i < 500; ++i) {
+        const vp::Vector x = vp::Vector::Random() * vp::S(3);
+        vp::Scalar expected = std::numeric_limits<vp::Scalar>::max();
+        for (size_t k = 0; k < a.size(); ++k) {
+            const vp::Vector ab = b[k] - a[k];
+            const vp::Scalar l2 = ab.squaredNorm();
+            const vp::Scalar h = l2 > 0 ? std::min<vp::Scalar>(std::max<vp::Scalar>((x - a[k]).dot(ab) / l2, 0), 1) : vp::S(0);
+            expected = std::min(expected, (x - a[k] - h * ab).norm() - radii[k]);
+        }
+        const vp::SDFResult r = set.fullEval(x);
+        REQUIRE_CLOSE_PREC(r.sdf, expected, vp::S(1e-4));
+    }
+
+    // Elements are identified by their index of construction.
+    const vp::SDFResult r = set.fullEval(vp::Vector(10, vp::S(0.5), vp::S(0.3)));
+    REQUIRE(r.element == 200);
+    REQUIRE_CLOSE(r.sdf, vp::S(0.2));
+}
+
+TEST_CASE("SDFPrimitiveSet Empty")
+{
+    vp::SDFSphereSet set((std::vector<vp::Vector>()), std::vector<vp::Scalar>());
+    REQUIRE(set.size() == 0);
+    REQUIRE(set.eval(vp::Vector::Zero()) == std::numeric_limits<vp::Scalar>::max());
+}
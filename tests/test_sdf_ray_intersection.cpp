@@ -0,0 +1,174 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+#include <cmath>
+
+namespace vp = volplay;
+
+/** Test that exact intersections agree with sphere tracing for rays towards the origin. Returns number of hits. */
+static int agreesWithTracing(const vp::SDFNode &n)
+{
+    vp::SDFNode::TraceOptions opts;
+    opts.maxT = 20;
+    opts.maxIter = 2000;
+
+    int hits = 0;
+    for (int i = 0; i < 200; ++i) {
+        const vp::Vector o = vp::Vector::Random().normalized() * vp::S(4);
+        const vp::Vector d = (vp::Vector::Random() * vp::S(0.8) - o).normalized();
+
+        vp::SDFNode::TraceResult traced, exact;
+        n.trace(o, d, opts, &traced);
+        if (!n.intersectRay(o, d, opts.minT, opts.maxT, exact))
+            return -1;
+
+        // Marching may stop short of grazed surfaces.
+        if (traced.hit && !exact.hit)
+            return -1;
+        if (traced.hit) {
+            if (std::abs(traced.t - exact.t) > vp::S(1e-2) || traced.node != exact.node)
+                return -1;
+            ++hits;
+        }
+        if (exact.hit && std::abs(n.eval(o + exact.t * d)) > vp::S(1e-4))
+            return -1;
+    }
+    return hits;
+}
+
+TEST_CASE("SDFNode::intersectRay")
+{
+    vp::SDFNodePtr sphere = vp::make().sphere().radius(vp::S(0.7));
+    vp::SDFNodePtr box = vp::make().box().halfLengths(vp::Vector(vp::S(0.2), vp::S(0.6), vp::S(0.4)));
+    vp::SDFNodePtr plane = vp::make().plane().normal(vp::Vector(1, 2, -1).normalized());
+
+    vp::SDFNodePtr nodes[] = {
+        sphere, box, plane,
+        vp::make()
+            .transform()
+                .translate(vp::Vector(vp::S(0.1), vp::S(-0.2), vp::S(0.3)))
+                .rotate(Eigen::AngleAxis<vp::Scalar>(vp::S(0.7), vp::Vector(1, 1, 0).normalized()))
+                .wrap().node(box)
+            .end(),
+        vp::make().transform().transform(vp::AffineTransform(Eigen::Scaling(vp::S(0.5)))).wrap().node(sphere).end(),
+        vp::make()
+            .join()
+                .wrap().node(sphere)
+                .transform().translate(vp::Vector(vp::S(0.5), vp::S(0.5), 0)).wrap().node(box).end()
+            .end()
+    };
+
+    for (size_t i = 0; i < sizeof(nodes) / sizeof(nodes[0]); ++i) {
+        const int hits = agreesWithTracing(*nodes[i]);
+        REQUIRE(hits > 20);
+    }
+
+    // Rays starting inside.
+    vp::SDFNode::TraceResult r;
+    REQUIRE(sphere->intersectRay(vp::Vector::Zero(), vp::Vector::UnitX(), 0, 10, r));
+    REQUIRE(!r.hit);
+    REQUIRE(r.t == 0);
+    REQUIRE(r.sdf < 0);
+
+    // Rays missing and rays hitting beyond maxT.
+    REQUIRE(box->intersectRay(vp::Vector(-2, 2, 0), vp::Vector::UnitX(), 0, 10, r));
+    REQUIRE(!r.hit);
+    REQUIRE(r.t == 10);
+    REQUIRE(sphere->intersectRay(vp::Vector(-2, 0, 0), vp::Vector::UnitX(), 0, 1, r));
+    REQUIRE(!r.hit);
+    REQUIRE(r.t == 1);
+
+    // Unions report the closest child.
+    REQUIRE(nodes[5]->intersectRay(vp::Vector(-2, 0, 0), vp::Vector::UnitX(), 0, 10, r));
+    REQUIRE(r.hit);
+    REQUIRE_CLOSE(r.t, vp::S(1.3));
+    REQUIRE(r.node == sphere.get());
+
+    // Nodes without closed form intersections.
+    vp::SDFNodePtr displaced = vp::make().displacement().offset(vp::S(0.1)).wrap().node(sphere).end();
+    REQUIRE(!displaced->intersectRay(vp::Vector(-2, 0, 0), vp::Vector::UnitX(), 0, 10, r));
+    vp::SDFNodePtr mixed = std::make_shared<vp::SDFUnion>(box, displaced);
+    REQUIRE(!mixed->intersectRay(vp::Vector(-2, 0, 0), vp::Vector::UnitX(), 0, 10, r));
+}
+
+TEST_CASE("SDFNode Exact Intersection Tracing")
+{
+    vp::SDFNodePtr displaced = vp::make()
+        .displacement().fnc([](const vp::Vector &x) { return vp::S(0.05) * std::sin(vp::S(8) * x.y()); }, vp::S(0.4))
+            .sphere().radius(vp::S(0.5))
+        .end();
+
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .plane().normal(vp::Vector::UnitY())
+            .transform().translate(vp::Vector(0, 1, 0))
+                .sphere().radius(1)
+            .end()
+            .transform().translate(vp::Vector(3, 1, 0))
+                .wrap().node(displaced)
+            .end()
+        .end();
+
+    vp::SDFNode::TraceOptions opts;
+    opts.maxT = 100;
+    opts.maxIter = 2000;
+
+    vp::SDFNode::TraceOptions exactOpts = opts;
+    exactOpts.exactIntersections = true;
+
+    int plainIter = 0;
+    int exactIter = 0;
+    for (int i = 0; i < 100; ++i) {
+        const vp::Vector o(-5, 1, 10);
+        const vp::Vector d = (vp::Vector(vp::S(-2) + vp::S(0.07) * vp::Scalar(i), vp::S(0.5) + vp::S(0.3) * std::sin(vp::Scalar(i)), 0) - o).normalized();
+
+        vp::SDFNode::TraceResult plain, exact;
+        scene->trace(o, d, opts, &plain);
+        scene->trace(o, d, exactOpts, &exact);
+
+        REQUIRE(exact.hit == plain.hit);
+        if (plain.hit) {
+            REQUIRE(exact.node == plain.node);
+            REQUIRE_CLOSE_PREC(exact.t, plain.t, vp::S(1e-2));
+        }
+        plainIter += plain.iter;
+        exactIter += exact.iter;
+    }
+    REQUIRE(exactIter < plainIter / 2);
+}
+
+TEST_CASE("SDFNode Exact Intersection Tracing Early Out")
+{
+    vp::SDFNodePtr sphere = vp::make().sphere().radius(1);
+    vp::SDFNodePtr scene = vp::make()
+        .join()
+            .wrap().node(sphere)
+            .transform().translate(vp::Vector(-2, vp::S(0.6), 0))
+                .displacement().offset(vp::S(0.1))
+                    .sphere().radius(vp::S(0.4))
+                .end()
+            .end()
+        .end();
+
+    // Marching the displaced sphere runs out of iterations before the exact intersection.
+    vp::SDFNode::TraceOptions opts;
+    opts.maxIter = 2;
+    opts.maxT = 100;
+    opts.exactIntersections = true;
+
+    vp::SDFNode::TraceResult tr;
+    scene->trace(vp::Vector(-5, 0, 0), vp::Vector::UnitX(), opts, &tr);
+    REQUIRE(tr.hit);
+    REQUIRE(tr.node == sphere.get());
+    REQUIRE_CLOSE(tr.t, vp::S(4));
+}
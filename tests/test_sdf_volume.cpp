@@ -0,0 +1,83 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+#include <stdio.h>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+TEST_CASE("SDFVolume")
+{
+    // Unit sphere sampled on a grid not aligned with brick boundaries.
+    const vp::Index dims(27, 25, 26);
+    const vp::Vector origin(-1.5f, -1.5f, -1.5f);
+    const vp::Vector spacing = vp::Vector::Constant(vp::S(0.12));
+
+    vp::SDFSphere sphere(1);
+    std::vector<float> samples;
+    for (int z = 0; z < dims.z(); ++z)
+        for (int y = 0; y < dims.y(); ++y)
+            for (int x = 0; x < dims.x(); ++x)
+                samples.push_back(sphere.eval(origin + vp::Vector(vp::S(x), vp::S(y), vp::S(z)).cwiseProduct(spacing)));
+
+    REQUIRE(vp::SDFVolume::write("volplay_test_raw.vol", dims, origin, spacing, samples));
+    REQUIRE(vp::SDFVolume::write("volplay_test_bricked.vol", dims, origin, spacing, samples, 8));
+    REQUIRE(!vp::SDFVolume::write("volplay_test_invalid.vol", dims, origin, spacing, samples, 6));
+
+    vp::SDFVolumePtr raw = std::make_shared<vp::SDFVolume>();
+    vp::SDFVolumePtr bricked = std::make_shared<vp::SDFVolume>();
+    REQUIRE(!raw->isOpen());
+    REQUIRE(raw->open("volplay_test_raw.vol"));
+    REQUIRE(bricked->open("volplay_test_bricked.vol"));
+    REQUIRE(raw->brickSize() == 0);
+    REQUIRE(bricked->brickSize() == 8);
+    REQUIRE(bricked->dimensions() == dims);
+    REQUIRE(bricked->spacing().isApprox(spacing));
+
+    // Grid points are reproduced exactly by both layouts.
+    REQUIRE(raw->sample(vp::Index(3, 7, 11)) == samples[(11 * dims.y() + 7) * dims.x() + 3]);
+    REQUIRE(bricked->sample(vp::Index(26, 24, 25)) == samples.back());
+    REQUIRE(bricked->sample(vp::Index(9, 17, 12)) == samples[(12 * dims.y() + 17) * dims.x() + 9]);
+
+    // Interpolated values are close to the analytic distance.
+    const vp::Vector points[] = {
+        vp::Vector(0.5f, 0.5f, 0.2f), vp::Vector(0.31f, -0.2f, 0.77f), vp::Vector(1, 0.05f, 0), vp::Vector(-0.6f, 0.6f, -0.3f)
+    };
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE_CLOSE_PREC(raw->eval(points[i]), sphere.eval(points[i]), vp::S(0.02));
+        REQUIRE_CLOSE(bricked->eval(points[i]), raw->eval(points[i]));
+    }
+
+    // Outside of the grid distance to the grid is added.
+    REQUIRE_CLOSE_PREC(raw->eval(vp::Vector(4, 0, 0)), vp::S(3), vp::S(0.02));
+    REQUIRE_CLOSE(bricked->eval(vp::Vector(0, -5, 2)), raw->eval(vp::Vector(0, -5, 2)));
+
+    // Tracing
+    vp::SDFNode::TraceOptions opts;
+    REQUIRE_CLOSE_PREC(bricked->trace(vp::Vector(3, 0, 0), vp::Vector(-1, 0, 0), opts), vp::S(2), vp::S(0.02));
+
+    // Meshing
+    vps::DualContouring dc;
+    dc.setLowerBounds(vp::Vector::Constant(-1.4f));
+    dc.setUpperBounds(vp::Vector::Constant(1.4f));
+    dc.setResolution(vp::Vector::Constant(vp::S(0.1)));
+    vps::IndexedSurface s = dc.compute(bricked);
+    REQUIRE(s.faces.cols() > 0);
+    for (int i = 0; i < int(s.vertices.cols()); ++i)
+        REQUIRE_CLOSE_PREC(s.vertices.col(i).norm(), vp::S(1), vp::S(0.03));
+
+    raw.reset();
+    bricked.reset();
+    remove("volplay_test_raw.vol");
+    remove("volplay_test_bricked.vol");
+}
@@ -0,0 +1,76 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2014 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+#include "surface_checks.hpp"
+
+#include <volplay/volplay.h>
+
+namespace vp = volplay;
+namespace vps = volplay::surface;
+
+TEST_CASE("SurfaceNets Sphere")
+{
+    vp::SDFNodePtr scene = vp::make().sphere().radius(1);
+
+    vps::SurfaceNets sn;
+    sn.setLowerBounds(vp::Vector(-2,-2,-2));
+    sn.setUpperBounds(vp::Vector(2,2,2));
+    sn.setResolution(vp::Vector::Constant(vp::S(0.1)));
+    sn.setBlockSize(7);
+    vps::IndexedSurface surface = sn.compute(scene);
+
+    REQUIRE(surface.faces.cols() > 0);
+
+    for (int i = 0; i < int(surface.vertices.cols()); ++i) {
+        REQUIRE_CLOSE_PREC(surface.vertices.col(i).norm(), vp::S(1), vp::S(0.05));
+    }
+
+    // Faces point outwards
+    for (int i = 0; i < int(surface.faces.cols()); ++i) {
+        auto t = surface.faces.col(i);
+        vp::Vector a = surface.vertices.col(t(1)) - surface.vertices.col(t(0));
+        vp::Vector b = surface.vertices.col(t(2)) - surface.vertices.col(t(0));
+        vp::Vector c = (surface.vertices.col(t(0)) + surface.vertices.col(t(1)) + surface.vertices.col(t(2))) / vp::S(3);
+        
+        const bool outwards = a.cross(b).dot(c) >= 0; // Degenerate where crossings coincide with corners
+        REQUIRE(outwards);
+    }
+
+    // Quads connect vertices of neighboring blocks.
+    REQUIRE(isClosedAndConsistent(surface));
+
+    sn.setBlockSize(64);
+    vps::IndexedSurface single = sn.compute(scene);
+    REQUIRE(single.vertices.cols() == surface.vertices.cols());
+    REQUIRE(single.faces.cols() == surface.faces.cols());
+
+    sn.setSkipEmptyBlocks(false);
+    vps::IndexedSurface full = sn.compute(scene);
+    REQUIRE(full.vertices.cols() == surface.vertices.cols());
+    REQUIRE(full.faces.cols() == surface.faces.cols());
+}
+
+TEST_CASE("SurfaceNets Iso Level")
+{
+    vp::SDFNodePtr scene = vp::make().sphere().radius(1);
+
+    vps::SurfaceNets sn;
+    sn.setLowerBounds(vp::Vector(-2,-2,-2));
+    sn.setUpperBounds(vp::Vector(2,2,2));
+    sn.setResolution(vp::Vector::Constant(vp::S(0.1)));
+    sn.setIsoLevel(vp::S(0.5));
+    vps::IndexedSurface surface = sn.compute(scene);
+
+    REQUIRE(surface.vertices.cols() > 0);
+    for (int i = 0; i < int(surface.vertices.cols()); ++i) {
+        REQUIRE_CLOSE_PREC(surface.vertices.col(i).norm(), vp::S(1.5), vp::S(0.05));
+    }
+}
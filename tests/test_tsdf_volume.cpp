@@ -0,0 +1,105 @@
+// This file is part of volplay, a library for interacting with
+// volumetric data.
+//
+// Copyright (C) 2015 Christoph Heindl <christoph.heindl@gmail.com>
+//
+// This Source Code Form is subject to the terms of the BSD 3 license.
+// If a copy of the BSD was not distributed with this file, You can obtain
+// one at http://opensource.org/licenses/BSD-3-Clause.
+
+#include "catch.hpp"
+#include "float_comparison.hpp"
+
+#include <volplay/volplay.h>
+
+namespace vp = volplay;
+namespace vpr = volplay::rendering;
+namespace vps = volplay::surface;
+
+/** Render depth image of scene. */
+static vpr::ScalarImagePtr renderDepth(const vp::SDFNodePtr &scene, const vpr::CameraPtr &cam, int rows, int cols)
+{
+    vpr::DepthImageGeneratorPtr dig = std::make_shared<vpr::DepthImageGenerator>();
+
+    vp::SDFNode::TraceOptions opts;
+    opts.maxT = 5;
+
+    vpr::Renderer r;
+    r.setScene(scene);
+    r.setCamera(cam);
+    r.setImageResolution(rows, cols);
+    r.setPrimaryTraceOptions(opts);
+    r.addImageGenerator(dig);
+    r.render();
+
+    return dig->image();
+}
+
+TEST_CASE("TSDFVolume")
+{
+    vp::SDFNodePtr sphere = vp::make().sphere().radius(vp::S(0.5));
+    vp::TSDFVolumePtr tsdf = std::make_shared<vp::TSDFVolume>(vp::S(0.02), vp::S(0.06));
+
+    const int rows = 48;
+    const int cols = 64;
+    const vp::Vector eyes[] = {
+        vp::Vector(2, 0, 0), vp::Vector(-2, 0, 0), vp::Vector(0, 2, 0.1f),
+        vp::Vector(0, -2, 0.1f), vp::Vector(0, 0.1f, 2), vp::Vector(0, 0.1f, -2)
+    };
+
+    std::vector<vpr::CameraPtr> cams;
+    for (int i = 0; i < 6; ++i) {
+        vpr::CameraPtr cam = std::make_shared<vpr::Camera>();
+        cam->setCameraToImage(rows, cols, vp::S(0.7));
+        cam->setCameraToWorldAsLookAt(eyes[i], vp::Vector::Zero(), vp::Vector::UnitY());
+        cams.push_back(cam);
+
+        tsdf->integrate(*renderDepth(sphere, cam, rows, cols), *cam);
+    }
+
+    REQUIRE(tsdf->blockCount() > 0);
+
+    vp::Vector lower, upper;
+    REQUIRE(tsdf->bounds(lower, upper));
+    REQUIRE((lower.array() < vp::S(-0.5)).all());
+    REQUIRE((upper.array() > vp::S(0.5)).all());
+
+    // Distances near the surface, truncation far away.
+    REQUIRE_CLOSE_PREC(tsdf->eval(vp::Vector(0.5f, 0, 0)), 0, vp::S(0.02));
+    REQUIRE_CLOSE_PREC(tsdf->eval(vp::Vector(0, 0.53f, 0)), vp::S(0.03), vp::S(0.02));
+    REQUIRE_CLOSE_PREC(tsdf->eval(vp::Vector(0, 0, -0.48f)), vp::S(-0.02), vp::S(0.02));
+    REQUIRE_CLOSE(tsdf->eval(vp::Vector(1.5f, 1.5f, 0)), vp::S(0.06));
+
+    // Raycasting through the renderer reproduces depth.
+    vpr::ScalarImagePtr expected = renderDepth(sphere, cams[0], rows, cols);
+    vpr::ScalarImagePtr raycast = renderDepth(tsdf, cams[0], rows, cols);
+    int hits = 0;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (expected->row(r)[c] == 0)
+                continue;
+            ++hits;
+            REQUIRE_CLOSE_PREC(raycast->row(r)[c], expected->row(r)[c], vp::S(0.03));
+        }
+    }
+    REQUIRE(hits > 0);
+
+    // Meshing
+    vps::DualContouring dc;
+    dc.setLowerBounds(lower);
+    dc.setUpperBounds(upper);
+    dc.setResolution(vp::Vector::Constant(vp::S(0.04)));
+    vps::IndexedSurface s = dc.compute(tsdf, vps::DualContouring::COMPUTE_MIDPOINT);
+    REQUIRE(s.faces.cols() > 0);
+
+    // Vertices are placed at cell midpoints, and voxels deep behind the surface remain
+    // unobserved which adds an inner shell. Nothing is generated outside the sphere.
+    int nearSurface = 0;
+    for (int i = 0; i < int(s.vertices.cols()); ++i) {
+        const vp::Scalar n = s.vertices.col(i).norm();
+        REQUIRE(n < vp::S(0.55));
+        if (std::abs(n - vp::S(0.5)) < vp::S(0.03))
+            ++nearSurface;
+    }
+    REQUIRE(nearSurface > 2000);
+}
@@ -199,4 +199,39 @@ TEST_CASE("VoxelGrid-VoxelQuery-Edge")
     REQUIRE(v[2] == vg::Voxel(0,-1,0));
     REQUIRE(v[1] == vg::Voxel(0,-1,-1));
     REQUIRE(v[0] == vg::Voxel(0,0,-1));
-}
\ No newline at end of file
+}
+TEST_CASE("VoxelGrid-PackedKeys")
+{
+    const vg::Voxel voxels[] = {
+        vg::Voxel(0, 0, 0), vg::Voxel(-1, 2, -3), vg::Voxel(524287, -524288, 17), vg::Voxel(-524288, 524287, -1)
+    };
+
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(vg::unpackVoxel(vg::packVoxel(voxels[i])) == voxels[i]);
+        for (int j = 0; j < i; ++j)
+            REQUIRE(vg::packVoxel(voxels[i]) != vg::packVoxel(voxels[j]));
+    }
+
+    REQUIRE(vg::isPackable(voxels[2]));
+    REQUIRE(!vg::isPackable(vg::Voxel(524288, 0, 0)));
+    REQUIRE(!vg::isPackable(vg::Voxel(0, -524289, 0)));
+
+    vg::VoxelEdge edges[12];
+    vg::edges(vg::Voxel(-3, 4, -5), edges);
+    for (int i = 0; i < 12; ++i) {
+        const vg::VoxelEdge f = vg::flipEdge(edges[i]);
+        REQUIRE(vg::unpackEdge(vg::packEdge(edges[i])) == edges[i]);
+        REQUIRE(vg::unpackEdge(vg::packEdge(f)) == f);
+        REQUIRE(vg::packEdge(f) != vg::packEdge(edges[i]));
+        for (int j = 0; j < i; ++j)
+            REQUIRE(vg::packEdge(edges[i]) != vg::packEdge(edges[j]));
+    }
+
+    vg::SparseVoxelEdgeProperty<int> prop(-1);
+    prop[edges[3]] = 3;
+    REQUIRE(prop.find(edges[3]) != 0);
+    REQUIRE(*prop.find(edges[3]) == 3);
+    REQUIRE(prop.find(edges[4]) == 0);
+    REQUIRE(prop.begin().key() == vg::packEdge(edges[3]));
+    REQUIRE(prop.begin()->first == edges[3]);
+}